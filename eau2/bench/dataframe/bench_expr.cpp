@@ -0,0 +1,107 @@
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../../include/eau2/dataframe/columns/bool_column.h"
+#include "../../include/eau2/dataframe/columns/double_column.h"
+#include "../../include/eau2/dataframe/columns/int_column.h"
+#include "../../include/eau2/dataframe/dataframe.h"
+
+/**
+ * Measures a computed column, price * qty, and a filter, price * qty > 100 &&
+ * flag, over a DataFrame of a double price, an int qty and a bool flag, as
+ * Rowers called for every row against expressions evaluated in batches.
+ * Usage: bench_expr [number of rows in millions]
+ */
+
+double elapsed_s(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void report(const char* name, size_t numRows, double seconds) {
+    printf("[bench_expr.cpp] %s: %zu rows in %.3f s, %.1f M rows/s\n", name,
+           numRows, seconds, numRows / seconds / 1E6);
+}
+
+// appends price * qty of every row to a column
+class TotalRower : public Rower {
+   public:
+    DoubleColumn *totals = new DoubleColumn();
+
+    TotalRower() : Rower(0) {}
+
+    bool accept(Row &r) {
+        double price = r.columnArray->get(0)->as_double()->get_double(
+            r.rowIndex);
+        int qty = r.columnArray->get(1)->as_int()->get_int(r.rowIndex);
+        this->totals->push_back(price * qty);
+        return false;
+    }
+};
+
+// keeps the rows of price * qty > 100 and flag
+class FilterRower : public Rower {
+   public:
+    FilterRower() : Rower(0) {}
+
+    bool accept(Row &r) {
+        return r.get_double(0) * r.get_int(1) > 100 && r.get_bool(2);
+    }
+};
+
+int main(int argc, char** argv) {
+    size_t millions = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10;
+    size_t numRows = millions * 1000000;
+    ColumnArray* columns = new ColumnArray();
+    DoubleColumn* prices = new DoubleColumn();
+    IntColumn* qtys = new IntColumn();
+    BoolColumn* flags = new BoolColumn();
+    unsigned int seed = 42;
+    for (size_t row = 0; row < numRows; row++) {
+        prices->push_back(rand_r(&seed) % 10000 / 100.0);
+        qtys->push_back(rand_r(&seed) % 10);
+        flags->push_back(rand_r(&seed) % 2 == 0);
+    }
+    columns->append(prices);
+    columns->append(qtys);
+    columns->append(flags);
+    DataFrame* df = DataFrame::fromColumns(columns);
+    delete columns;
+
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    TotalRower totalRower;
+    df->map(totalRower);
+    report("price * qty, Rower", numRows, elapsed_s(start));
+    delete totalRower.totals;
+
+    Expr* total = Expr::binary(ExprOp::MULTIPLY, Expr::col(0), Expr::col(1));
+    start = std::chrono::steady_clock::now();
+    df->add_computed(total);
+    report("price * qty, Expr", numRows, elapsed_s(start));
+
+    start = std::chrono::steady_clock::now();
+    FilterRower filterRower;
+    DataFrame* byRower = df->filter(filterRower);
+    report("filter, Rower", numRows, elapsed_s(start));
+
+    Expr* predicate = Expr::binary(
+        ExprOp::AND,
+        Expr::binary(ExprOp::GREATER, dynamic_cast<Expr*>(total->clone()),
+                     Expr::literal(100)),
+        Expr::col(2));
+    start = std::chrono::steady_clock::now();
+    DataFrame* byExpr = df->filter(predicate);
+    report("filter, Expr", numRows, elapsed_s(start));
+    assert(byExpr->nrows() == byRower->nrows());
+
+    delete byExpr;
+    delete byRower;
+    delete predicate;
+    delete total;
+    delete df;
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../../include/eau2/dataframe/columns/double_column.h"
+#include "../../include/eau2/dataframe/columns/int_column.h"
+#include "../../include/eau2/dataframe/dataframe.h"
+
+/**
+ * Measures GroupBy::agg() of the sum, mean, min and max of a double column
+ * grouped by an int column, for key columns of a few to a million distinct
+ * values, with one thread and with one thread per core.
+ * Usage: bench_group_by [number of rows in millions]
+ */
+
+double elapsed_s(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+int main(int argc, char** argv) {
+    size_t millions = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10;
+    size_t numRows = millions * 1000000;
+    size_t cardinalities[] = {16, 10000, 1000000};
+    for (size_t cardinality : cardinalities) {
+        ColumnArray* columns = new ColumnArray();
+        IntColumn* keys = new IntColumn();
+        DoubleColumn* values = new DoubleColumn();
+        unsigned int seed = 42;
+        for (size_t row = 0; row < numRows; row++) {
+            keys->push_back(static_cast<int>(rand_r(&seed) % cardinality));
+            values->push_back(rand_r(&seed) % 10000 / 100.0);
+        }
+        columns->append(keys);
+        columns->append(values);
+        DataFrame* df = DataFrame::fromColumns(columns);
+        delete columns;
+
+        size_t keyCols[] = {0};
+        AggOp ops[] = {AggOp::SUM, AggOp::MEAN, AggOp::MIN, AggOp::MAX};
+        size_t cols[] = {1, 1, 1, 1};
+        GroupBy* groupBy = df->group_by(keyCols, 1);
+        size_t threads[] = {1, groupBy->numThreads};
+        for (size_t numThreads : threads) {
+            groupBy->numThreads = numThreads;
+            std::chrono::steady_clock::time_point start =
+                std::chrono::steady_clock::now();
+            DataFrame* result = groupBy->agg(ops, cols, 4);
+            double seconds = elapsed_s(start);
+            printf("[bench_group_by.cpp] %zu keys, %zu threads: %zu groups "
+                   "of %zu rows in %.3f s, %.1f M rows/s\n",
+                   cardinality, numThreads, result->nrows(), numRows,
+                   seconds, numRows / seconds / 1E6);
+            delete result;
+        }
+        delete groupBy;
+        delete df;
+    }
+    return 0;
+}
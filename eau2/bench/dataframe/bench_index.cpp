@@ -0,0 +1,86 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../../include/eau2/dataframe/columns/double_column.h"
+#include "../../include/eau2/dataframe/columns/int_column.h"
+#include "../../include/eau2/dataframe/dataframe.h"
+
+/**
+ * Measures point lookups of a random user id and a range of a random value
+ * by DataFrame::filter() scanning the columns, against the same filters found
+ * by a hash index and a sorted index (see ColumnIndex), and reports the time
+ * to build the indexes and their memory.
+ * Usage: bench_index [number of rows in millions] [number of lookups]
+ */
+
+double elapsed_s(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void report(const char* name, size_t numLookups, double seconds,
+            size_t kept) {
+    printf("[bench_index.cpp] %s: %zu lookups in %.3f s, %.1f us per lookup, "
+           "%zu rows kept\n",
+           name, numLookups, seconds, seconds / numLookups * 1E6, kept);
+}
+
+// filters the given data frame by as many user ids and ranges of values
+size_t lookups(DataFrame* df, size_t numLookups, int numUsers) {
+    unsigned int seed = 7;
+    size_t kept = 0;
+    for (size_t i = 0; i < numLookups; i++) {
+        int user = rand_r(&seed) % numUsers;
+        DataFrame* rows =
+            df->filter(new Condition(0, CompareOp::EQUAL, user));
+        kept += rows->nrows();
+        delete rows;
+        double low = rand_r(&seed) / static_cast<double>(RAND_MAX);
+        rows = df->filter(new Condition(1, CompareOp::LESS, low - 0.9999));
+        kept += rows->nrows();
+        delete rows;
+    }
+    return kept;
+}
+
+int main(int argc, char** argv) {
+    size_t millions = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10;
+    size_t numLookups = argc > 2 ? strtoull(argv[2], nullptr, 10) : 20;
+    size_t numRows = millions * 1000000;
+    int numUsers = static_cast<int>(numRows / 10);
+    ColumnArray* columns = new ColumnArray();
+    IntColumn* users = new IntColumn();
+    DoubleColumn* values = new DoubleColumn();
+    unsigned int seed = 42;
+    for (size_t row = 0; row < numRows; row++) {
+        users->push_back(rand_r(&seed) % numUsers);
+        values->push_back(rand_r(&seed) / static_cast<double>(RAND_MAX));
+    }
+    columns->append(users);
+    columns->append(values);
+    DataFrame* df = DataFrame::fromColumns(columns);
+    delete columns;
+
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    size_t kept = lookups(df, numLookups, numUsers);
+    report("scan", numLookups * 2, elapsed_s(start), kept);
+
+    start = std::chrono::steady_clock::now();
+    df->create_index(0, IndexType::HASH);
+    printf("[bench_index.cpp] hash index: built in %.3f s\n",
+           elapsed_s(start));
+    start = std::chrono::steady_clock::now();
+    df->create_index(1, IndexType::SORTED);
+    printf("[bench_index.cpp] sorted index: built in %.3f s, %.1f MB of "
+           "indexes for %zu rows\n",
+           elapsed_s(start), df->index_bytes() / 1E6, numRows);
+
+    start = std::chrono::steady_clock::now();
+    kept = lookups(df, numLookups, numUsers);
+    report("indexed", numLookups * 2, elapsed_s(start), kept);
+    delete df;
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../../include/eau2/dataframe/columns/double_column.h"
+#include "../../include/eau2/dataframe/columns/int_column.h"
+#include "../../include/eau2/dataframe/dataframe.h"
+
+/**
+ * Measures HashJoin::run() of an INNER join of a probed DataFrame of an int
+ * key and a double with a built DataFrame of unique int keys and an int, for
+ * built sides of a thousand to a few million rows, with the whole table and
+ * with a radix partitioned table, each with one thread and with one thread
+ * per core.
+ * Usage: bench_join [number of probed rows in millions]
+ */
+
+double elapsed_s(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// a data frame of the given number of rows of a key below the given one and
+// a value, or of every key below the given one, shuffled, if numRows is 0
+DataFrame* generate(size_t numRows, size_t numKeys, unsigned int* seed) {
+    ColumnArray* columns = new ColumnArray();
+    IntColumn* keys = new IntColumn();
+    if (numRows == 0) {
+        IntColumn* values = new IntColumn();
+        int* shuffled = new int[numKeys];
+        for (size_t key = 0; key < numKeys; key++) {
+            shuffled[key] = static_cast<int>(key);
+        }
+        for (size_t key = numKeys; key > 1; key--) {
+            size_t other = rand_r(seed) % key;
+            int swap = shuffled[key - 1];
+            shuffled[key - 1] = shuffled[other];
+            shuffled[other] = swap;
+        }
+        for (size_t key = 0; key < numKeys; key++) {
+            keys->push_back(shuffled[key]);
+            values->push_back(static_cast<int>(key));
+        }
+        delete[] shuffled;
+        columns->append(keys);
+        columns->append(values);
+    } else {
+        DoubleColumn* values = new DoubleColumn();
+        for (size_t row = 0; row < numRows; row++) {
+            keys->push_back(static_cast<int>(rand_r(seed) % numKeys));
+            values->push_back(rand_r(seed) % 10000 / 100.0);
+        }
+        columns->append(keys);
+        columns->append(values);
+    }
+    DataFrame* df = DataFrame::fromColumns(columns);
+    delete columns;
+    return df;
+}
+
+int main(int argc, char** argv) {
+    size_t millions = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10;
+    size_t numRows = millions * 1000000;
+    size_t buildSizes[] = {1000, 100000, 4000000};
+    unsigned int seed = 42;
+    for (size_t buildSize : buildSizes) {
+        DataFrame* probe = generate(numRows, buildSize, &seed);
+        DataFrame* build = generate(0, buildSize, &seed);
+        size_t keys[] = {0};
+        HashJoin join(probe, build, keys, keys, 1, JoinType::INNER);
+        size_t threads[] = {1, join.numThreads};
+        // the cache of the default partitioning, then one big table
+        size_t cacheBytes[] = {JOIN_CACHE_BYTES, SIZE_MAX};
+        for (size_t bytes : cacheBytes) {
+            for (size_t numThreads : threads) {
+                join.cacheBytes = bytes;
+                join.numThreads = numThreads;
+                std::chrono::steady_clock::time_point start =
+                    std::chrono::steady_clock::now();
+                DataFrame* result = join.run();
+                double seconds = elapsed_s(start);
+                const char* table =
+                    bytes == SIZE_MAX ? "one table" : "cache sized";
+                printf("[bench_join.cpp] %zu built rows, %s, %zu threads: "
+                       "%zu rows in %.3f s, %.1f M probed rows/s\n",
+                       buildSize, table,
+                       numThreads, result->nrows(), seconds,
+                       numRows / seconds / 1E6);
+                delete result;
+            }
+        }
+        delete probe;
+        delete build;
+    }
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../../include/eau2/dataframe/columns/bool_column.h"
+#include "../../include/eau2/dataframe/columns/double_column.h"
+#include "../../include/eau2/dataframe/columns/int_column.h"
+#include "../../include/eau2/dataframe/dataframe.h"
+
+/**
+ * Measures a pipeline of two filters and a grouped sum over a DataFrame of a
+ * key of 100 values, a random int, a random double and a bool, run as a lazy
+ * Query, fused into one pass, against DataFrame::filter() building the
+ * filtered data frame first and GroupBy::agg() aggregating it.
+ * Usage: bench_query [number of rows in millions]
+ */
+
+double elapsed_s(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// keeps the rows of a positive int and a double under 0.5
+class BenchRower : public Rower {
+   public:
+    BenchRower() : Rower(0) {}
+
+    bool accept(Row &r) { return r.get_int(1) > 0 && r.get_double(2) < 0.5; }
+};
+
+int main(int argc, char** argv) {
+    size_t millions = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10;
+    size_t numRows = millions * 1000000;
+    ColumnArray* columns = new ColumnArray();
+    IntColumn* keys = new IntColumn();
+    IntColumn* ints = new IntColumn();
+    DoubleColumn* doubles = new DoubleColumn();
+    BoolColumn* bools = new BoolColumn();
+    unsigned int seed = 42;
+    for (size_t row = 0; row < numRows; row++) {
+        keys->push_back(rand_r(&seed) % 100);
+        ints->push_back(rand_r(&seed) - RAND_MAX / 2);
+        doubles->push_back(rand_r(&seed) / static_cast<double>(RAND_MAX));
+        bools->push_back(rand_r(&seed) % 2 == 0);
+    }
+    columns->append(keys);
+    columns->append(ints);
+    columns->append(doubles);
+    columns->append(bools);
+    DataFrame* df = DataFrame::fromColumns(columns);
+    delete columns;
+
+    size_t key[] = {0};
+    AggOp ops[] = {AggOp::SUM};
+    size_t cols[] = {2};
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    BenchRower rower;
+    DataFrame* filtered = df->filter(rower);
+    GroupBy* groupBy = filtered->group_by(key, 1);
+    DataFrame* materialized = groupBy->agg(ops, cols, 1);
+    double seconds = elapsed_s(start);
+    printf("[bench_query.cpp] filter, then group_by: %zu rows in %.3f s, "
+           "%.1f M rows/s\n",
+           numRows, seconds, numRows / seconds / 1E6);
+
+    start = std::chrono::steady_clock::now();
+    Query* query = df->query();
+    query->filter(new Condition(1, CompareOp::GREATER, 0))
+        ->filter(new Condition(2, CompareOp::LESS, 0.5))
+        ->aggregate(key, 1, ops, cols, 1);
+    DataFrame* fused = query->run();
+    seconds = elapsed_s(start);
+    printf("[bench_query.cpp] fused query: %zu rows in %.3f s, "
+           "%.1f M rows/s\n",
+           numRows, seconds, numRows / seconds / 1E6);
+    assert(fused->nrows() == materialized->nrows());
+
+    delete fused;
+    delete query;
+    delete materialized;
+    delete groupBy;
+    delete filtered;
+    delete df;
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../../include/eau2/dataframe/columns/double_column.h"
+#include "../../include/eau2/dataframe/columns/int_column.h"
+#include "../../include/eau2/dataframe/columns/string_column.h"
+#include "../../include/eau2/dataframe/dataframe.h"
+
+/**
+ * Measures SortBy::run() of a DataFrame of random ints, doubles and short
+ * strings by each of its columns, and by the ints of a few distinct values
+ * then the doubles, with one thread and with one thread per core.
+ * Usage: bench_sort [number of rows in millions]
+ */
+
+double elapsed_s(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+int main(int argc, char** argv) {
+    size_t millions = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10;
+    size_t numRows = millions * 1000000;
+    ColumnArray* columns = new ColumnArray();
+    IntColumn* ints = new IntColumn();
+    IntColumn* fewInts = new IntColumn();
+    DoubleColumn* doubles = new DoubleColumn();
+    StringColumn* strings = new StringColumn();
+    unsigned int seed = 42;
+    char value[16];
+    for (size_t row = 0; row < numRows; row++) {
+        ints->push_back(rand_r(&seed) - RAND_MAX / 2);
+        fewInts->push_back(rand_r(&seed) % 100);
+        doubles->push_back(rand_r(&seed) / 1000.0 - 1000000);
+        snprintf(value, sizeof(value), "s%d", rand_r(&seed) % 1000000);
+        strings->push_back(new String(value));
+    }
+    columns->append(ints);
+    columns->append(fewInts);
+    columns->append(doubles);
+    columns->append(strings);
+    DataFrame* df = DataFrame::fromColumns(columns);
+    delete columns;
+
+    const char* names[] = {"ints", "doubles", "strings",
+                           "ints of 100 values, doubles"};
+    size_t keys[][2] = {{0, 0}, {2, 0}, {3, 0}, {1, 2}};
+    size_t numKeys[] = {1, 1, 1, 2};
+    bool ascending[] = {true, true};
+    for (size_t i = 0; i < 4; i++) {
+        SortBy sort(df, keys[i], ascending, numKeys[i]);
+        size_t threads[] = {1, sort.numThreads};
+        for (size_t numThreads : threads) {
+            sort.numThreads = numThreads;
+            std::chrono::steady_clock::time_point start =
+                std::chrono::steady_clock::now();
+            DataFrame* sorted = sort.run();
+            double seconds = elapsed_s(start);
+            printf("[bench_sort.cpp] by %s, %zu threads: %zu rows in %.3f s, "
+                   "%.1f M rows/s\n",
+                   names[i], numThreads, sorted->nrows(), seconds,
+                   numRows / seconds / 1E6);
+            delete sorted;
+        }
+    }
+    delete df;
+    return 0;
+}
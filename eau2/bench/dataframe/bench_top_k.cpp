@@ -0,0 +1,74 @@
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../../include/eau2/dataframe/columns/double_column.h"
+#include "../../include/eau2/dataframe/columns/int_column.h"
+#include "../../include/eau2/dataframe/dataframe.h"
+
+/**
+ * Measures DataFrame::top_k() and DataFrame::quantile_sketch() of a column of
+ * random doubles against sorting the data frame by it, and reports the error
+ * of the rank of the p50 and p99 of the sketch.
+ * Usage: bench_top_k [number of rows in millions] [k of top_k]
+ */
+
+double elapsed_s(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void report(const char* name, size_t numRows, double seconds) {
+    printf("[bench_top_k.cpp] %s: %zu rows in %.3f s, %.1f M rows/s\n", name,
+           numRows, seconds, numRows / seconds / 1E6);
+}
+
+int main(int argc, char** argv) {
+    size_t millions = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10;
+    size_t k = argc > 2 ? strtoull(argv[2], nullptr, 10) : 100;
+    size_t numRows = millions * 1000000;
+    ColumnArray* columns = new ColumnArray();
+    DoubleColumn* values = new DoubleColumn();
+    IntColumn* ids = new IntColumn();
+    unsigned int seed = 42;
+    for (size_t row = 0; row < numRows; row++) {
+        values->push_back(rand_r(&seed) / static_cast<double>(RAND_MAX));
+        ids->push_back(static_cast<int>(row));
+    }
+    columns->append(values);
+    columns->append(ids);
+    DataFrame* df = DataFrame::fromColumns(columns);
+    delete columns;
+
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    DataFrame* top = df->top_k(0, k);
+    report("top_k", numRows, elapsed_s(start));
+
+    start = std::chrono::steady_clock::now();
+    QuantileSketch* sketch = df->quantile_sketch(0);
+    report("quantile_sketch", numRows, elapsed_s(start));
+
+    size_t col = 0;
+    bool ascending[] = {true};
+    start = std::chrono::steady_clock::now();
+    DataFrame* sorted = df->sort_by(&col, ascending, 1);
+    report("sort_by", numRows, elapsed_s(start));
+
+    // the values are uniform in [0, 1], so a value is about its rank
+    assert(top->get_double(0, 0) == sorted->get_double(0, numRows - 1));
+    double qs[] = {0.5, 0.99};
+    for (double q : qs) {
+        double value = sketch->quantile(q);
+        double exact = sorted->get_double(0, static_cast<size_t>(q * numRows));
+        printf("[bench_top_k.cpp] p%g: %.5f, exact %.5f, %zu values kept\n",
+               q * 100, value, exact, sketch->retained);
+    }
+    delete sketch;
+    delete sorted;
+    delete top;
+    delete df;
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include "../../include/eau2/dataframe/columns/double_column.h"
+#include "../../include/eau2/dataframe/columns/int_column.h"
+#include "../../include/eau2/dataframe/dataframe.h"
+
+/**
+ * Measures the sum of price * qty over a data frame read with
+ * DataFrame::get_double() and DataFrame::get_int() per row, against the same
+ * loop over TypedColumnViews by DataFrame::map_rows() and by
+ * DataFrame::pmap_ranges().
+ * Usage: bench_typed_view [number of rows in millions]
+ */
+
+double elapsed_s(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void report(const char* name, size_t numRows, double seconds, double sum) {
+    printf("[bench_typed_view.cpp] %s: %zu rows in %.3f s, %.1f M rows/s, "
+           "sum %.6g\n",
+           name, numRows, seconds, numRows / seconds / 1E6, sum);
+}
+
+int main(int argc, char** argv) {
+    size_t millions = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10;
+    size_t numRows = millions * 1000000;
+    ColumnArray* columns = new ColumnArray();
+    DoubleColumn* prices = new DoubleColumn();
+    IntColumn* quantities = new IntColumn();
+    unsigned int seed = 42;
+    for (size_t row = 0; row < numRows; row++) {
+        prices->push_back(rand_r(&seed) / static_cast<double>(RAND_MAX));
+        quantities->push_back(rand_r(&seed) % 100);
+    }
+    columns->append(prices);
+    columns->append(quantities);
+    DataFrame* df = DataFrame::fromColumns(columns);
+    delete columns;
+
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    double sum = 0;
+    for (size_t row = 0; row < numRows; row++) {
+        sum += df->get_double(0, row) * df->get_int(1, row);
+    }
+    report("get_double * get_int", numRows, elapsed_s(start), sum);
+
+    start = std::chrono::steady_clock::now();
+    TypedColumnView<double> price = df->view<double>(0);
+    TypedColumnView<int> qty = df->view<int>(1);
+    sum = 0;
+    df->map_rows([&sum, price, qty](size_t row) {
+        sum += price[row] * qty[row];
+    });
+    report("map_rows", numRows, elapsed_s(start), sum);
+
+    start = std::chrono::steady_clock::now();
+    size_t numThreads = std::thread::hardware_concurrency();
+    numThreads = numThreads == 0 ? 1 : numThreads;
+    double* sums = new double[numThreads];
+    df->pmap_ranges(numThreads, [sums, price, qty](size_t thread,
+                                                   size_t begin, size_t end) {
+        double total = 0;
+        for (size_t row = begin; row < end; row++) {
+            total += price[row] * qty[row];
+        }
+        sums[thread] = total;
+    });
+    sum = 0;
+    for (size_t i = 0; i < numThreads; i++) {
+        sum += sums[i];
+    }
+    report("pmap_ranges", numRows, elapsed_s(start), sum);
+    delete[] sums;
+    delete df;
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../../include/eau2/dataframe/columns/double_column.h"
+#include "../../include/eau2/dataframe/columns/int_column.h"
+#include "../../include/eau2/dataframe/dataframe.h"
+
+/**
+ * Measures a filter of the last 0.1% of a sorted timestamp column by an
+ * expression, which reads every row, against DataFrame::filter() of a
+ * Condition, which skips the zones of rows outside the range: first building
+ * the zone map, then reusing it.
+ * Usage: bench_zone_map [number of rows in millions]
+ */
+
+double elapsed_s(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void report(const char* name, size_t numRows, double seconds, size_t kept) {
+    printf("[bench_zone_map.cpp] %s: %zu rows in %.3f s, %.1f M rows/s, "
+           "%zu kept\n",
+           name, numRows, seconds, numRows / seconds / 1E6, kept);
+}
+
+int main(int argc, char** argv) {
+    size_t millions = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10;
+    size_t numRows = millions * 1000000;
+    ColumnArray* columns = new ColumnArray();
+    IntColumn* timestamps = new IntColumn();
+    DoubleColumn* values = new DoubleColumn();
+    unsigned int seed = 42;
+    for (size_t row = 0; row < numRows; row++) {
+        timestamps->push_back(static_cast<int>(row));
+        values->push_back(rand_r(&seed) / static_cast<double>(RAND_MAX));
+    }
+    columns->append(timestamps);
+    columns->append(values);
+    DataFrame* df = DataFrame::fromColumns(columns);
+    delete columns;
+    int bound = static_cast<int>(numRows - numRows / 1000);
+
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    Expr* expr = Expr::binary(ExprOp::GREATER_EQUAL, Expr::col(0),
+                              Expr::literal(bound));
+    DataFrame* kept = df->filter(expr);
+    report("filter(Expr)", numRows, elapsed_s(start), kept->nrows());
+    delete kept;
+    delete expr;
+
+    const char* names[] = {"filter(Condition), building the zone map",
+                           "filter(Condition)"};
+    for (const char* name : names) {
+        start = std::chrono::steady_clock::now();
+        kept = df->filter(new Condition(0, CompareOp::GREATER_EQUAL, bound));
+        report(name, numRows, elapsed_s(start), kept->nrows());
+        delete kept;
+    }
+    delete df;
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "../../include/eau2/kvstore/kvstore.h"
+#include "../../include/eau2/serialization/deserializer.h"
+#include "../../include/eau2/serialization/serializer.h"
+
+/**
+ * Measures the write throughput of a KVStore with the write-ahead log enabled
+ * and the time needed to recover it from a snapshot and a log tail.
+ * Usage: bench_wal [number of keys] [ints per value] [group commit bytes]
+ */
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// puts a value for every key and returns the number of bytes put
+size_t put_all(KVStore* kv, Key** keys, size_t numKeys, int* vals,
+               size_t numVals) {
+    size_t numBytes = 0;
+    for (size_t i = 0; i < numKeys; i++) {
+        vals[0] = static_cast<int>(i);
+        byte* value = Serializer::serialize_int_array(vals, numVals);
+        numBytes += Deserializer::num_bytes(value);
+        kv->put(keys[i], value);
+    }
+    return numBytes;
+}
+
+int main(int argc, char** argv) {
+    size_t numKeys = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t numVals = argc > 2 ? strtoull(argv[2], nullptr, 10) : 16;
+    size_t groupBytes =
+        argc > 3 ? strtoull(argv[3], nullptr, 10) : DEFAULT_GROUP_COMMIT_BYTES;
+    char path[] = "/tmp/eau2_bench_walXXXXXX";
+    int fd = mkstemp(path);
+    close(fd);
+    unlink(path);
+
+    Key** keys = new Key*[numKeys];
+    for (size_t i = 0; i < numKeys; i++) {
+        char* name = new char[24];
+        sprintf(name, "key%zu", i);
+        keys[i] = new Key(true, name, 0);
+    }
+    int* vals = new int[numVals];
+    for (size_t i = 0; i < numVals; i++) {
+        vals[i] = static_cast<int>(i);
+    }
+
+    KVStore* kv = new KVStore();
+    kv->enable_durability(path, 0, groupBytes);
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    size_t numBytes = put_all(kv, keys, numKeys, vals, numVals);
+    kv->sync();
+    double ms = elapsed_ms(start);
+    printf("[bench_wal.cpp] logged puts: %zu in %.1f ms, %.0f puts/s, %.1f "
+           "MB/s\n",
+           numKeys, ms, numKeys / (ms / 1E3), numBytes / (ms * 1E3));
+
+    start = std::chrono::steady_clock::now();
+    kv->snapshot();
+    printf("[bench_wal.cpp] snapshot: %.1f ms\n", elapsed_ms(start));
+
+    // leave a log tail of a tenth of the keys on top of the snapshot
+    put_all(kv, keys, numKeys / 10, vals, numVals);
+    delete kv;
+
+    start = std::chrono::steady_clock::now();
+    KVStore* recovered = new KVStore();
+    size_t numRecords = recovered->enable_durability(path, 0, groupBytes);
+    ms = elapsed_ms(start);
+    printf("[bench_wal.cpp] recovery: %zu records in %.1f ms, %.0f "
+           "records/s\n",
+           numRecords, ms, numRecords / (ms / 1E3));
+    delete recovered;
+
+    char file[64];
+    sprintf(file, "%s.wal", path);
+    unlink(file);
+    sprintf(file, "%s.snap", path);
+    unlink(file);
+    for (size_t i = 0; i < numKeys; i++) {
+        delete keys[i];
+    }
+    delete[] keys;
+    delete[] vals;
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "../../include/eau2/serialization/deserializer.h"
+#include "../../include/eau2/serialization/serializer.h"
+
+/**
+ * Compares decoding a serialized array of short Strings into String objects
+ * against decoding it into a PackedStringArray.
+ * Usage: bench_string_array [number of strings] (10 million by default)
+ */
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void report(const char* name, double ms, size_t count, size_t num_bytes) {
+    printf("[bench_string_array.cpp] %s: %.1f ms, %.1f ns/string, %.1f MB/s\n",
+           name, ms, ms * 1E6 / count, num_bytes / (ms * 1E3));
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    String** strings = new String*[count];
+    char buff[32];
+    for (size_t i = 0; i < count; i++) {
+        sprintf(buff, "s%zu", i % 1000000);
+        strings[i] = new String(buff);
+    }
+    byte* serialized = Serializer::serialize_string_array(strings, count);
+    size_t num_bytes = Deserializer::num_bytes(serialized);
+    for (size_t i = 0; i < count; i++) {
+        delete strings[i];
+    }
+    delete[] strings;
+
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    String** decoded = Deserializer::deserialize_string_array(serialized);
+    report("deserialize_string_array", elapsed_ms(start), count, num_bytes);
+    for (size_t i = 0; i < count; i++) {
+        delete decoded[i];
+    }
+    delete[] decoded;
+
+    start = std::chrono::steady_clock::now();
+    PackedStringArray* packed =
+        Deserializer::deserialize_packed_string_array(serialized);
+    report("deserialize_packed_string_array", elapsed_ms(start), count,
+           num_bytes);
+    delete packed;
+
+    delete[] serialized;
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../../include/eau2/sorer/sorer.h"
+
+/**
+ * Measures SOR::read_mapped of a generated sorer file of the given size with
+ * 200 columns of ints, doubles and bools, reading every column, only 3 of
+ * them (see SOR::select_columns()) and only the tenth of the rows passing a
+ * predicate (see SOR::select_rows()).
+ * Usage: bench_sor_project [file size in MB]
+ */
+
+double elapsed_s(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// writes rows of 200 fields to the given file until it holds at least the
+// given bytes
+void generate(const char* path, size_t numBytes) {
+    FILE* file = fopen(path, "w");
+    size_t written = 0;
+    unsigned int seed = 42;
+    bool first = true;
+    while (written < numBytes) {
+        for (int col = 0; col < 200; col++) {
+            int value = rand_r(&seed);
+            switch (col % 3) {
+                case 0:
+                    written += fprintf(file, "<%d>", value % 100000 + 2);
+                    break;
+                case 1:
+                    // the first row keeps every column type unambiguous
+                    written += fprintf(file, "<%d.%d>", value % 1000,
+                                       first ? 5 : value % 10);
+                    break;
+                default:
+                    written += fprintf(file, "<%d>", value % 2);
+                    break;
+            }
+        }
+        written += fprintf(file, "\n");
+        first = false;
+    }
+    fclose(file);
+}
+
+void report(const char* name, SOR* sor, size_t numBytes, double seconds) {
+    size_t rows = sor->columnArray->get(0)->size();
+    printf("[bench_sor_project.cpp] %s: %d columns, %zu rows in %.2f s, "
+           "%.3f GB/s\n",
+           name, sor->columnArray->size(), rows, seconds,
+           numBytes / seconds / 1E9);
+}
+
+int main(int argc, char** argv) {
+    size_t megabytes = argc > 1 ? strtoull(argv[1], nullptr, 10) : 512;
+    size_t numBytes = megabytes << 20;
+    char path[] = "/tmp/eau2_bench_sorXXXXXX";
+    int fd = mkstemp(path);
+    close(fd);
+    generate(path, numBytes);
+
+    SOR* sor = new SOR();
+    std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    sor->read_mapped(path, 0, numBytes * 2);
+    report("all columns", sor, numBytes, elapsed_s(start));
+    delete sor;
+
+    size_t columns[] = {0, 100, 199};
+    sor = new SOR();
+    sor->select_columns(columns, 3);
+    start = std::chrono::steady_clock::now();
+    sor->read_mapped(path, 0, numBytes * 2);
+    report("3 columns", sor, numBytes, elapsed_s(start));
+    delete sor;
+
+    Predicate* predicate = new Predicate();
+    predicate->add(new Condition(0, CompareOp::LESS, 10002));
+    sor = new SOR();
+    sor->select_rows(predicate);
+    start = std::chrono::steady_clock::now();
+    sor->read_mapped(path, 0, numBytes * 2);
+    report("10% of the rows", sor, numBytes, elapsed_s(start));
+    delete sor;
+    delete predicate;
+    unlink(path);
+    return 0;
+}
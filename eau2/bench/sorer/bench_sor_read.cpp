@@ -0,0 +1,131 @@
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../../include/eau2/sorer/chunk_stream.h"
+#include "../../include/eau2/sorer/column_cache.h"
+#include "../../include/eau2/sorer/sorer.h"
+
+/**
+ * Measures the throughput of reading a generated sorer file of the given size
+ * with the stdio based SOR::read, the memory mapped SOR::read_mapped, with and
+ * without the load statistics of SOR::enable_stats(), the
+ * parallel SOR::read_parallel, SOR::stream_mapped into a KVStore capped to
+ * 64 MB of values and SOR::read_cached without and with a column cache. The
+ * rows hold an int, a double, a bool and an int.
+ * Usage: bench_sor_read [file size in MB] [1 to also run SOR::read]
+ *        [threads of read_parallel; 0 for one per core]
+ */
+
+double elapsed_s(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// writes rows to the given file until it holds at least the given bytes
+size_t generate(const char* path, size_t numBytes) {
+    FILE* file = fopen(path, "w");
+    size_t written = 0;
+    size_t rows = 0;
+    // the first row keeps every column type unambiguous
+    written += fprintf(file, "<12> <0.5> <1> <-7>\n");
+    rows++;
+    unsigned int seed = 42;
+    while (written < numBytes) {
+        written += fprintf(file, "<%d> <%d.%02d> <%d> <%d>\n",
+                           rand_r(&seed) % 1000000, rand_r(&seed) % 1000,
+                           rand_r(&seed) % 100, rand_r(&seed) % 2,
+                           rand_r(&seed) % 20000 - 10000);
+        rows++;
+    }
+    fclose(file);
+    return rows;
+}
+
+void report(const char* name, size_t numBytes, size_t rows, double seconds) {
+    printf("[bench_sor_read.cpp] %s: %zu rows in %.2f s, %.3f GB/s\n", name,
+           rows, seconds, numBytes / seconds / 1E9);
+}
+
+int main(int argc, char** argv) {
+    size_t megabytes = argc > 1 ? strtoull(argv[1], nullptr, 10) : 2048;
+    bool runRead = argc > 2 ? atoi(argv[2]) != 0 : true;
+    size_t numThreads = argc > 3 ? strtoull(argv[3], nullptr, 10) : 0;
+    size_t numBytes = megabytes << 20;
+    char path[] = "/tmp/eau2_bench_sorXXXXXX";
+    int fd = mkstemp(path);
+    close(fd);
+    size_t rows = generate(path, numBytes);
+    printf("[bench_sor_read.cpp] generated %zu MB, %zu rows\n", megabytes,
+           rows);
+
+    std::chrono::steady_clock::time_point start;
+    if (runRead) {
+        SOR* sor = new SOR();
+        FILE* file = fopen(path, "r");
+        start = std::chrono::steady_clock::now();
+        sor->read(file, 0, numBytes);
+        report("SOR::read", numBytes, sor->columnArray->get(0)->size(),
+               elapsed_s(start));
+        fclose(file);
+        delete sor;
+    }
+
+    SOR* sor = new SOR();
+    start = std::chrono::steady_clock::now();
+    sor->read_mapped(path, 0, numBytes * 2);
+    report("SOR::read_mapped", numBytes, sor->columnArray->get(0)->size(),
+           elapsed_s(start));
+    delete sor;
+
+    // the same read with the counters and timers, reported as it ends
+    sor = new SOR();
+    sor->enable_stats(stdout);
+    start = std::chrono::steady_clock::now();
+    sor->read_mapped(path, 0, numBytes * 2);
+    report("SOR::read_mapped with stats", numBytes,
+           sor->columnArray->get(0)->size(), elapsed_s(start));
+    delete sor;
+
+    sor = new SOR();
+    start = std::chrono::steady_clock::now();
+    sor->read_parallel(path, 0, numBytes * 2, numThreads);
+    report("SOR::read_parallel", numBytes, sor->columnArray->get(0)->size(),
+           elapsed_s(start));
+    delete sor;
+
+    KVStore* kv = new KVStore();
+    kv->set_memory_budget(64 << 20, "/tmp");
+    sor = new SOR();
+    start = std::chrono::steady_clock::now();
+    sor->stream_mapped(path, kv, "bench", DEFAULT_CHUNK_ROWS,
+                       DEFAULT_MAX_PENDING);
+    double seconds = elapsed_s(start);
+    DataFrame* metadata = kv->get(Key("bench", 0));
+    report("SOR::stream_mapped", numBytes, metadata->get_int(0, 0), seconds);
+    printf("[bench_sor_read.cpp] KVStore: %zu MB on the heap, %zu MB mapped\n",
+           kv->resident_bytes() >> 20,
+           kv->segments == nullptr ? 0 : kv->segments->mapped_bytes() >> 20);
+    delete metadata;
+    delete sor;
+    delete kv;
+
+    char* cachePath = ColumnCache::cache_path(path);
+    unlink(cachePath);
+    const char* names[] = {"SOR::read_cached cold", "SOR::read_cached warm"};
+    for (int i = 0; i < 2; i++) {
+        sor = new SOR();
+        start = std::chrono::steady_clock::now();
+        sor->read_cached(path);
+        report(names[i], numBytes, sor->columnArray->get(0)->size(),
+               elapsed_s(start));
+        delete sor;
+    }
+    unlink(cachePath);
+    delete[] cachePath;
+    unlink(path);
+    return 0;
+}
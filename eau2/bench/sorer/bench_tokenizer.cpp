@@ -0,0 +1,73 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "../../include/eau2/sorer/sorer.h"
+
+/**
+ * Measures the throughput of the block scan for structural characters and of
+ * splitting generated sorer lines into fields with every block scan supported
+ * by the CPU.
+ * Usage: bench_tokenizer [data size in MB]
+ */
+
+double elapsed_s(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+int main(int argc, char** argv) {
+    size_t megabytes = argc > 1 ? strtoull(argv[1], nullptr, 10) : 512;
+    size_t capacity = (megabytes << 20) + 256;
+    char* data = new char[capacity];
+    size_t size = 0;
+    unsigned int seed = 42;
+    while (size + 256 < capacity) {
+        size += sprintf(data + size,
+                        "<%d> <%d.%02d> <%d> <\"user %d\"> <> <%d>\n",
+                        rand_r(&seed) % 1000000, rand_r(&seed) % 1000,
+                        rand_r(&seed) % 100, rand_r(&seed) % 2,
+                        rand_r(&seed) % 100000, rand_r(&seed) % 20000);
+    }
+    const char* names[] = {"scalar", "sse2", "avx2"};
+    for (int level = 0; level <= static_cast<int>(Tokenizer::best_level());
+         level++) {
+        // the block scan alone, without walking the structural characters
+        Tokenizer* tokenizer = new Tokenizer(static_cast<ScanLevel>(level));
+        tokenizer->reset(data, data + size);
+        std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+        size_t structural = 0;
+        for (size_t i = 0; i + TOKENIZER_BLOCK <= size; i += TOKENIZER_BLOCK) {
+            structural += __builtin_popcountll(tokenizer->scan(data + i));
+        }
+        double seconds = elapsed_s(start);
+        printf("[bench_tokenizer.cpp] %s scan: %zu structural characters in "
+               "%.2f s, %.3f GB/s\n",
+               names[level], structural, seconds, size / seconds / 1E9);
+        delete tokenizer;
+
+        SOR* sor = new SOR();
+        delete sor->tokenizer;
+        sor->tokenizer = new Tokenizer(static_cast<ScanLevel>(level));
+        start = std::chrono::steady_clock::now();
+        size_t lines = 0;
+        size_t fields = 0;
+        const char* line = data;
+        while (line < data + size) {
+            size_t numFields;
+            line = sor->tokenize_line_(line, data + size, &numFields);
+            fields += numFields;
+            lines++;
+        }
+        seconds = elapsed_s(start);
+        printf("[bench_tokenizer.cpp] %s fields: %zu lines, %zu fields in "
+               "%.2f s, %.3f GB/s\n",
+               names[level], lines, fields, seconds, size / seconds / 1E9);
+        delete sor;
+    }
+    delete[] data;
+    return 0;
+}
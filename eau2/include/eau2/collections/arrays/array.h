@@ -45,6 +45,14 @@ class Array : public Object {
      */
     void append(Object* input);
 
+    /**
+     * Appends the given elements to the end of this array at once.
+     *
+     * @param inputs the elements being appended to the end of this Array.
+     * @param count the number of the given elements
+     */
+    void append_all(Object** inputs, int count);
+
     /**
      * Returns the element at the given index.
      *
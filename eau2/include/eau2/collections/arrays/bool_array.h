@@ -30,6 +30,14 @@ class BoolArray : public Object {
      */
     void append(bool input);
 
+    /**
+     * Appends the given elements to the end of this array at once.
+     *
+     * @param inputs the elements being appended to the end of this BoolArray.
+     * @param count the number of the given elements
+     */
+    void append_all(bool* inputs, int count);
+
     /**
      * Returns the element at the given index.
      *
@@ -30,6 +30,14 @@ class DoubleArray : public Object {
      */
     void append(double input);
 
+    /**
+     * Appends the given elements to the end of this array at once.
+     *
+     * @param inputs the elements being appended to the end of this DoubleArray.
+     * @param count the number of the given elements
+     */
+    void append_all(double* inputs, int count);
+
     /**
      * Returns the element at the given index.
      *
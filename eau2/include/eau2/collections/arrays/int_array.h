@@ -30,6 +30,14 @@ class IntArray : public Object {
      */
     void append(int& input);
 
+    /**
+     * Appends the given elements to the end of this array at once.
+     *
+     * @param inputs the elements being appended to the end of this IntArray.
+     * @param count the number of the given elements
+     */
+    void append_all(int* inputs, int count);
+
     /**
      * Returns the element at the given index.
      *
@@ -0,0 +1,70 @@
+#pragma once
+#include "array.h"
+
+/**
+ * @brief Represents an immutable array of strings stored as one contiguous
+ * block of characters and an array of offsets into that block. Every string
+ * in the block is zero terminated, so the c-string of the element at index i
+ * starts at bytes + offsets[i]. The array is produced in one pass by
+ * Deserializer::deserialize_packed_string_array and requires only two
+ * allocations regardless of the number of elements.
+ * @file packed_string_array.h
+ * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
+ * @author Megha Rao <rao.m@husky.neu.edu>
+ * @date April 6, 2020
+ */
+class PackedStringArray : public Object {
+   public:
+    char* bytes;        // owned; zero terminated strings placed back to back
+    size_t* offsets;    // owned; numElements + 1 entries, last one is the end
+    size_t numElements;
+
+    /**
+     * Constructor of this PackedStringArray. Steals the given block of
+     * characters and the given offsets.
+     *
+     * @param bytes the block of zero terminated strings
+     * @param offsets the starting offset of each string plus the end offset
+     * @param numElements the number of strings in the block
+     */
+    PackedStringArray(char* bytes, size_t* offsets, size_t numElements);
+
+    /**
+     * Returns the number of strings in this array.
+     *
+     * @return the number of strings in this array
+     */
+    size_t size();
+
+    /**
+     * Returns the zero terminated string at the given index. The returned
+     * pointer is owned by this array and should not be modified or freed.
+     *
+     * @param index the index of the requested string
+     * @return the c-string at the given index
+     */
+    const char* get_cstr(size_t index);
+
+    /**
+     * Returns the length of the string at the given index, not counting the
+     * terminator.
+     *
+     * @param index the index of the string
+     * @return the length of the string at the given index
+     */
+    size_t length(size_t index);
+
+    /**
+     * Returns a copy of the string at the given index as a String. The
+     * returned String is owned by the caller.
+     *
+     * @param index the index of the requested string
+     * @return a copy of the string at the given index
+     */
+    String* get(size_t index);
+
+    /**
+     * Destructor of this PackedStringArray.
+     */
+    ~PackedStringArray();
+};
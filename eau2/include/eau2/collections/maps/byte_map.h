@@ -8,7 +8,14 @@
 /**
  * @brief Represents a map that uses Key class as its keys and byte as values.
  * This map is to be used by KV-store with serialized objects to be stored as
- * values. Note: the destructor of this map does not delete stored elements.
+ * values. Every key keeps a history of versions: setting a value publishes a
+ * new version and keeps the older ones readable until they are pruned.
+ * Collisions are resolved by linear probing. Note: the destructor of this map
+ * does not delete the latest values; superseded values are owned by the map,
+ * except for values stored in a SegmentStore, which are never deleted. The map
+ * keeps count of the bytes of the values on the heap and stamps every pair
+ * with the tick of its last access, so callers can bound the memory used by
+ * the map by moving the coldest values into segments (see relocate()).
  * @file map.h
  * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
  * @author Megha Rao <rao.m@husky.neu.edu>
@@ -20,6 +27,8 @@ class ByteMap : public Object {
 
     size_t tableSize;
     size_t elementsInserted;
+    size_t heapBytes;  // bytes of all the versions of values on the heap
+    size_t clock;      // ticks on every access to a value
 
     /**
      * Default constructor.
@@ -52,18 +61,114 @@ class ByteMap : public Object {
      */
     byte* get(Key* key);
 
+    /**
+     * Returns the given version of the value stored at the given key. If the
+     * key or the version is not found (or has been pruned), returns nullptr.
+     *
+     * @param key the key used for searching the value
+     * @param version the version of the value
+     * @return the value (serialized object) of the given version
+     */
+    byte* get_version(Key* key, size_t version);
+
+    /**
+     * Returns the latest version of the value stored at the given key, or 0
+     * if the key is not present in this map.
+     *
+     * @param key the key used for searching the value
+     * @return the latest version of the value at the given key
+     */
+    size_t version(Key* key);
+
+    /**
+     * Returns the pair holding the latest version of the value at the given
+     * key, or nullptr if the key is not present in this map.
+     *
+     * @param key the key used for searching the value
+     * @return the pair holding the latest version of the value
+     */
+    KeyValueBytes* entry(Key* key);
+
+    /**
+     * Replaces the heap value of the given pair with its copy stored in a
+     * segment. The heap value is not deleted.
+     *
+     * @param kv the pair of this map whose value is being moved
+     * @param view the copy of the value inside the segment
+     * @param segment the index of the segment holding the copy
+     * @param offset the offset of the copy within the segment
+     */
+    void relocate(KeyValueBytes* kv, byte* view, size_t segment,
+                  size_t offset);
+
+    /**
+     * Returns the number of bytes of all the versions of values of this map
+     * stored on the heap.
+     *
+     * @return the number of bytes of values on the heap
+     */
+    size_t heap_bytes();
+
+    /**
+     * Returns all the pairs of this map whose values are on the heap,
+     * including the pairs holding older versions.
+     *
+     * @param count set to the number of pairs returned
+     * @return an array of pairs with values on the heap
+     */
+    KeyValueBytes** getHeapItems(size_t* count);
+
     /**
      * Sets the value at the given key. If value is not present,
-     * adds the new value to the map.
+     * adds the new value to the map. Otherwise the value becomes the next
+     * version of the key and the previous value remains readable through
+     * get_version() until it is pruned.
      *
      * @param key the key used for searching the given vaue
      * @param value the value (serialized object) being inserted into this map
+     * @return the version assigned to the given value
+     */
+    size_t set(Key* key, byte* value);
+
+    /**
+     * Sets the value at the given key with the given version, used when
+     * restoring the map from durable storage. The value is ignored if the
+     * key is already at the given version or a newer one.
+     *
+     * @param key the key used for searching the given value
+     * @param value the value (serialized object) being inserted into this map
+     * @param version the version of the given value
+     * @return true if the value was stored and false if it was ignored
+     */
+    bool restore(Key* key, byte* value, size_t version);
+
+    /**
+     * Sets the value at the given key only if the latest version of the key
+     * is the expected one (compare-and-set). An expected version of 0 means
+     * that the key must not be present yet.
+     *
+     * @param key the key used for searching the given value
+     * @param value the value (serialized object) being inserted into this map
+     * @param expected the version the key is expected to be at
+     * @return true if the value was set and false otherwise
+     */
+    bool set_if_version(Key* key, byte* value, size_t expected);
+
+    /**
+     * Deletes all versions of the value at the given key older than the
+     * given version.
+     *
+     * @param key the key whose history is being pruned
+     * @param version the oldest version to be kept
+     * @return the number of versions deleted
      */
-    void set(Key* key, byte* value);
+    size_t prune(Key* key, size_t version);
 
     /**
      * Removes the value from this map given the key associated
-     * with the value. If the key is not found, returns null.
+     * with the value. If the key is not found, returns null. Older versions
+     * of the value are deleted. A value stored in a segment is a view into the
+     * segment and must not be deleted by the caller.
      *
      * @param key the key being used for searching
      * @return the value (serialized object) removed from this map
@@ -104,7 +209,8 @@ class ByteMap : public Object {
     size_t hash();
 
     /**
-     * Returns a position of the given key in this map.
+     * Returns a position of the given key in this map: the slot holding the
+     * key, or the empty slot where the key would be inserted.
      *
      * @param the key being used for calculating the position in this map
      * @return the position in this map
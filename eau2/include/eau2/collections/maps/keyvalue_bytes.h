@@ -1,11 +1,15 @@
 #pragma once
 #include "../../utils/object.h"
 #include "../../kvstore/key.h"
+#include "../../kvstore/segment_store.h"
 
 /**
  * @brief Represents a key-value pair for a ByteMap. The key should be of Key
  * class whereas value is represented as a serialized object of byte (unsigned
- * char) type.
+ * char) type. Every pair carries the version of its value; the pairs holding
+ * older versions of the same key are chained through previous, newest first.
+ * A value is either a heap array or a view into a segment of a SegmentStore,
+ * in which case the pair records the location of the value.
  * @file keyvalue.h
  * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
  * @author Megha Rao <rao.m@husky.neu.edu>
@@ -15,6 +19,12 @@ class KeyValueBytes : public Object {
    public:
     Key *key;
     byte *value;
+    size_t version;           // starts at 1 for the first value of a key
+    KeyValueBytes *previous;  // owned; the pair with the preceding version
+    size_t segment;  // segment holding the value or NO_SEGMENT if on the heap
+    size_t offset;   // offset of the value within its segment
+    size_t length;   // number of bytes of the value
+    size_t lastAccess;  // tick of the map clock when last set or read
 
     /**
      * Constructor for KeyValueBytes pair.
@@ -25,10 +35,47 @@ class KeyValueBytes : public Object {
     KeyValueBytes(Key *key, byte *value);
 
     /**
-     * Destructor of this KeyValueBytes pair.
+     * Constructor for KeyValueBytes pair that supersedes the given pair.
+     *
+     * @param key the key component for this KeyValue pair
+     * @param value the value component for this KeyValue pair
+     * @param version the version of the given value
+     * @param previous the pair holding the preceding version or nullptr
+     */
+    KeyValueBytes(Key *key, byte *value, size_t version,
+                  KeyValueBytes *previous);
+
+    /**
+     * Destructor of this KeyValueBytes pair. Deletes the chain of pairs
+     * holding older versions, but not the values.
      */
     ~KeyValueBytes();
 
+    /**
+     * Returns the pair holding the given version of the value, searching this
+     * pair and the older ones. Returns nullptr if the version is not present.
+     *
+     * @param version the requested version
+     * @return the pair holding the requested version or nullptr
+     */
+    KeyValueBytes *find_version(size_t version);
+
+    /**
+     * Records that the value of this pair is a view into the given segment.
+     *
+     * @param segment the index of the segment holding the value
+     * @param offset the offset of the value within the segment
+     */
+    void set_location(size_t segment, size_t offset);
+
+    /**
+     * Returns true if the value of this pair is stored in a segment and
+     * must not be deleted, and false if it is a heap array.
+     *
+     * @return true if the value is stored in a segment and false otherwise
+     */
+    bool in_segment();
+
     /**
      * Returns the key component of this KeyValueBytes pair.
      *
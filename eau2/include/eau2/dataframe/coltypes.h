@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 
 /**
  * @brief This file represent implementation of ColType enumerator
@@ -28,3 +29,35 @@ enum class ColType {
  * @return the type of the column as ColType
  */
 ColType infer_type(char* c);
+
+/**
+ * Returns the column type of the given sequence of characters that does not
+ * need to be null terminated. A nullptr value is missing and has the
+ * ColType::UNKNOWN type, since it fits a column of any type.
+ *
+ * @param c the first character of the sorer-type value or nullptr
+ * @param len the number of characters of the value
+ * @return the type of the column as ColType
+ */
+ColType infer_type(const char* c, size_t len);
+
+/**
+ * Returns the position of the given type in the SoR type hierarchy
+ * BOOL < INT < FLOAT < STRING: a column can hold values of the types at or
+ * below its own position. The type of missing values, ColType::UNKNOWN, is
+ * below all of them.
+ *
+ * @param type the type of a column
+ * @return the position of the type in the hierarchy
+ */
+int type_order(ColType type);
+
+/**
+ * Returns the lowest type of the SoR type hierarchy that can hold values of
+ * both given types. Used to infer the type of a column from many values.
+ *
+ * @param type the type of a column
+ * @param other the type of another value of the column
+ * @return the type of the column holding both values
+ */
+ColType widen_type(ColType type, ColType other);
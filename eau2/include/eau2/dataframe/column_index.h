@@ -0,0 +1,129 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "../sorer/predicate.h"
+#include "../utils/object.h"
+
+class DataFrame;
+
+/**
+ * Enumerator that represents the kinds of index of a column: a hash index of
+ * the rows of every value, for equality, and an index of the rows sorted by
+ * their values, for equality and ranges.
+ */
+enum class IndexType { HASH, SORTED };
+
+/**
+ * @brief Represents a secondary index of a column of a DataFrame, created by
+ * DataFrame::create_index(), that finds the rows passing a check of the
+ * column (see Condition) without scanning it. A hash index chains the rows
+ * of every bucket of a hash table of the values, the last row first; it is
+ * built by one thread per core, every thread hashing a range of rows, the
+ * rows then being partitioned by the share of the buckets of every thread,
+ * which links the rows of its share. A sorted index keeps the rows ordered
+ * by their values, sorted by SortBy, and finds the rows of a range with two
+ * binary searches; added rows are set aside and merged into the sorted ones
+ * by the next lookup. Either index checks the rows it finds
+ * with Condition::select(), so it keeps exactly the rows a scan keeps; NaNs
+ * and missing strings, which pass no comparison, are left out of a sorted
+ * index. Rows added by DataFrame::add_row() are added to the index; any other
+ * change of the column makes the index stale, and it is rebuilt when used.
+ * @file column_index.h
+ * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
+ * @author Megha Rao <rao.m@husky.neu.edu>
+ * @date April 12, 2020
+ */
+class ColumnIndex : public Object {
+   public:
+    DataFrame* df;      // external
+    size_t col;         // the index of the column
+    IndexType type;
+    size_t numRows;     // the rows of df indexed
+    bool stale;         // true once a value indexed may have changed
+    size_t capacity;    // the rows next or rows has room for
+    size_t* heads;      // owned; the last row of every bucket, or SIZE_MAX
+    size_t numBuckets;  // a power of 2
+    size_t* next;       // owned; the row before every row of its bucket
+    size_t* rows;       // owned; the rows of a sorted index, by value
+    size_t numSorted;   // the rows of rows
+    size_t* added;      // owned; the rows added since the last lookup
+    size_t numAdded;
+    size_t addedCapacity;
+    size_t numThreads;
+
+    /**
+     * Constructor that builds the index of the given type of the given
+     * column of the given DataFrame, by one thread per core.
+     *
+     * @param df the data frame
+     * @param col the index of the column
+     * @param type the kind of index
+     */
+    ColumnIndex(DataFrame* df, size_t col, IndexType type);
+
+    /**
+     * Destructor of this ColumnIndex.
+     */
+    ~ColumnIndex();
+
+    /**
+     * Adds the rows of the data frame past the ones indexed, or rebuilds the
+     * index if it is stale.
+     */
+    void extend();
+
+    /**
+     * Marks this index as stale, to be rebuilt before it is used again.
+     */
+    void invalidate();
+
+    /**
+     * Returns true if this index finds the rows passing the given check:
+     * equality for a hash index, equality and ranges for a sorted one.
+     *
+     * @param condition the check of the column of this index
+     * @return true if lookup() takes the check and false otherwise
+     */
+    bool supports(Condition* condition);
+
+    /**
+     * Returns the rows passing the given check, supported by this index.
+     * The index must be up to date (see extend()).
+     *
+     * @param condition the check of the column of this index
+     * @param numRows set to the number of rows passing the check
+     * @return a new array of the rows passing the check, in ascending order
+     */
+    size_t* lookup(Condition* condition, size_t* numRows);
+
+    /**
+     * Returns the number of bytes of memory taken by this index.
+     *
+     * @return the memory footprint of this index
+     */
+    size_t memory_bytes();
+
+   private:
+    // builds the index of every row of the data frame
+    void build_();
+
+    // adds the given row, the one after the last one indexed
+    void add_(size_t row);
+
+    // sorts the rows added to a sorted index and merges them into rows
+    void merge_();
+
+    // returns the hash of the value of the given row
+    uint64_t hash_(size_t row);
+
+    // returns true if the value of the given row can be sorted and compared
+    bool comparable_(size_t row);
+
+    // returns the order of the values of the given rows
+    int compare_(size_t row, size_t other);
+
+    // returns the first position of rows whose row passes the check with
+    // the given operator as given, the positions before it failing it
+    size_t partition_(Condition* condition, CompareOp op, bool passes);
+};
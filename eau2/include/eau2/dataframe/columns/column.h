@@ -13,6 +13,7 @@ class IntColumn;
 class DoubleColumn;
 class BoolColumn;
 class StringColumn;
+class ZoneMap;
 
 /**
  * @brief This file represent implementation of Column class and its
@@ -33,6 +34,7 @@ class Column : public Object {
    public:
     size_t numElements;
     ColType colType;
+    ZoneMap* zones;  // owned; nullptr until zone_map() is called
 
     /**
      * Default constructor of the column.
@@ -76,12 +78,54 @@ class Column : public Object {
      */
     virtual void push_back(char* val);
 
+    /**
+     * Pushes a value represented by the given sequence of characters, which
+     * does not need to be null terminated, to the bottom of this column if
+     * the value can be added to this column (see can_add). Used by the SOR
+     * reader to push fields straight from the mapped file: the typed columns
+     * validate and convert the value in a single pass. A nullptr value pushes
+     * a missing value.
+     *
+     * @param val the first character of the value or nullptr
+     * @param len the number of characters of the value
+     * @return true if the value was pushed and false if it does not fit the
+     * type of this column, in which case this column is unchanged
+     */
+    virtual bool push_back(const char* val, size_t len);
+
+    /**
+     * Removes the value at the bottom of this column. Used by the SOR reader
+     * to take back the fields of a row that does not fit the schema.
+     */
+    virtual void pop_back();
+
     /**
      * Pushes the null character to the bottom of this column. The null value
      * depends on the type of column.
      */
     virtual void push_nullptr();
 
+    /**
+     * Moves all the values of the given column of the same type to the
+     * bottom of this column, leaving the given column empty. Used to
+     * concatenate the chunks of a column built by separate threads.
+     *
+     * @param other the column whose values are being moved
+     */
+    virtual void extend(Column* other);
+
+    /**
+     * Returns a new column of the values of this column at the given
+     * indices, in the given order; an index of SIZE_MAX gathers a missing
+     * value. Used to apply a permutation or the pairs of rows of a join to a
+     * whole column at once.
+     *
+     * @param indices the indices of the gathered values
+     * @param size the number of indices
+     * @return the new column of the gathered values
+     */
+    virtual Column* gather(const size_t* indices, size_t size);
+
     /** Returns the number of elements in the column.
      * @return the number of elements in this column
      */
@@ -160,6 +204,19 @@ class Column : public Object {
      */
     virtual bool can_add(char* c);
 
+    /**
+     * Returns true if the given sequence of characters, which does not need
+     * to be null terminated, can be added to this column following the SoR
+     * type hierarchy BOOL < INT < FLOAT < STRING. Missing values can be added
+     * to any column.
+     *
+     * @param c the first character of the value or nullptr
+     * @param len the number of characters of the value
+     * @return true of the given value can be added to this column and false
+     * otherwise
+     */
+    virtual bool can_add(const char* c, size_t len);
+
     /**
      * Return the type of this column as a char: 'S', 'B', 'I' and 'F'.
      *
@@ -208,6 +265,16 @@ class Column : public Object {
      */
     virtual char* get_char(size_t i);
 
+    /**
+     * Returns the statistics of the zones of this column (see ZoneMap),
+     * built on the first call. Later calls add the rows pushed since the
+     * last one; the values set in between have already widened their zones.
+     * Not safe to call while other threads read the column.
+     *
+     * @return the zone map of this column, owned by the column
+     */
+    ZoneMap* zone_map();
+
     /**
      * clone method
      */
@@ -217,4 +284,8 @@ class Column : public Object {
      * Destructor of this column.
      */
     virtual ~Column();
+
+   protected:
+    // drops the zones of the rows past the last one, popped or moved away
+    void trim_zones_();
 };
@@ -40,8 +40,16 @@ class StringColumn : public Column {
 
     void push_nullptr();
 
+    void extend(Column* other);
+
+    Column* gather(const size_t* indices, size_t size);
+
     void push_back(char* c);
 
+    bool push_back(const char* c, size_t len);
+
+    void pop_back();
+
     char* get_char(size_t index);
 
     void acceptVisitor(IVisitor* visitor);
@@ -1,14 +1,23 @@
 #pragma once
+#include <cassert>
 
 #include "../collections/arrays/column_array.h"
+#include "column_index.h"
 #include "columns/column.h"
+#include "expr.h"
+#include "group_by.h"
+#include "hash_join.h"
 #include "../kvstore/key.h"
 #include "../kvstore/kvstore.h"
 #include "../utils/object.h"
 #include "../utils/string.h"
+#include "quantile_sketch.h"
+#include "query.h"
 #include "row.h"
 #include "rowers/rower.h"
 #include "schema.h"
+#include "sort_by.h"
+#include "typed_column_view.h"
 
 class KVStore;
 
@@ -23,6 +32,8 @@ class DataFrame : public Object {
    public:
     Schema* schema;        // owned
     ColumnArray* columns;  // owned
+    ColumnIndex** indexes;  // owned; the index of every column, or nullptr
+    size_t numIndexes;      // the length of indexes
 
     /** Create a data frame with the same columns as the give df but no rows.
      *
@@ -245,6 +256,11 @@ class DataFrame : public Object {
      * name is optional and external. A nullptr column is undefined. */
     void add_column(Column* col);
 
+    /** Adds a column of the value of the given expression for every row of
+     * this data frame, evaluated in batches (see Expr), as the last column.
+     * The expression is external. */
+    void add_computed(Expr* expr);
+
     /** Return the value at the given column and row. Accessing rows or
      *  columns out of bounds, or request the wrong type is undefined.*/
     /**
@@ -384,8 +400,212 @@ class DataFrame : public Object {
      */
     DataFrame* filter(Rower& r);
 
+    /**
+     * Creates a new DataFrame of the rows for which the given bool
+     * expression is true, evaluated in batches rather than a row at a time.
+     *
+     * @param predicate the expression, external
+     * @return the new data frame of the rows kept
+     */
+    DataFrame* filter(Expr* predicate);
+
+    /**
+     * Creates a new DataFrame of the rows passing the given check. The rows
+     * are found by the index of the column if it takes the check (see
+     * ColumnIndex); otherwise the zones of rows whose statistics fail it
+     * (see ZoneMap) are skipped without reading them: on a sorted column,
+     * only the zones of the range kept are read.
+     *
+     * @param condition the check, owned by this call and deleted by it
+     * @return the new data frame of the rows kept
+     */
+    DataFrame* filter(Condition* condition);
+
+    /**
+     * Builds an index of the given type of the given column, replacing its
+     * index if it has one, by one thread per core. The index is kept up to
+     * date by add_row() and rebuilt after set() when used again.
+     *
+     * @param col the index of the column
+     * @param type the kind of index
+     */
+    void create_index(size_t col, IndexType type);
+
+    /**
+     * Deletes the index of the given column, if it has one.
+     *
+     * @param col the index of the column
+     */
+    void drop_index(size_t col);
+
+    /**
+     * Returns the index of the given column.
+     *
+     * @param col the index of the column
+     * @return the index of the column, or nullptr if it has none
+     */
+    ColumnIndex* get_index(size_t col);
+
+    /**
+     * Returns the number of bytes of memory taken by the indexes of the
+     * columns of this DataFrame.
+     *
+     * @return the memory footprint of the indexes
+     */
+    size_t index_bytes();
+
+    /**
+     * Returns a view of the values of the given column of ints, doubles or
+     * bools as an array of T (see TypedColumnView).
+     *
+     * @param col the index of the column, of values of type T
+     * @return the view of the column
+     */
+    template <typename T>
+    TypedColumnView<T> view(size_t col);
+
+    /**
+     * Calls the given lambda with the index of every row, in order. The
+     * lambda is inlined into the loop; with the views of the columns it
+     * reads, captured by value, the loop reads the arrays directly.
+     *
+     * @param f the lambda, called as f(row)
+     */
+    template <typename F>
+    void map_rows(F f);
+
+    /**
+     * Splits the rows between the given number of threads and calls the
+     * given lambda once per thread with the index of the thread and its
+     * range of rows, the first thread by the calling one. The lambda loops
+     * over the range itself, so it can keep its results in locals and store
+     * them once, per thread, where they are merged after this returns.
+     *
+     * @param numThreads the number of threads, at least 1
+     * @param f the lambda, called as f(thread, begin, end)
+     */
+    template <typename F>
+    void pmap_ranges(size_t numThreads, F f);
+
+    /**
+     * Groups the rows of this DataFrame by the values of the given columns,
+     * to be aggregated with GroupBy::agg(). The GroupBy is owned by the
+     * caller and reads this DataFrame, which must outlive it.
+     *
+     * @param keys the indices of the key columns
+     * @param numKeys the number of key columns
+     * @return the rows of this DataFrame grouped by the key columns
+     */
+    GroupBy* group_by(const size_t* keys, size_t numKeys);
+
+    /**
+     * Joins this DataFrame, on the left, with the given one on the rows whose
+     * given columns are equal (see HashJoin).
+     *
+     * @param other the right data frame
+     * @param keys the indices of the key columns of this data frame
+     * @param otherKeys the indices of the key columns of other, of the same
+     * types
+     * @param numKeys the number of key columns
+     * @param type the type of the join
+     * @return a new data frame of the columns of both data frames, with a
+     * row per pair of joined rows
+     */
+    DataFrame* join(DataFrame* other, const size_t* keys,
+                    const size_t* otherKeys, size_t numKeys, JoinType type);
+
+    /**
+     * Sorts the rows of this DataFrame by the values of the given columns
+     * (see SortBy).
+     *
+     * @param cols the indices of the columns, the most significant first
+     * @param ascending true for every column sorted in ascending order
+     * @param numCols the number of columns
+     * @return a new data frame of the rows in sorted order
+     */
+    DataFrame* sort_by(const size_t* cols, const bool* ascending,
+                       size_t numCols);
+
+    /**
+     * Returns the given rows of this DataFrame, in the given order, gathered
+     * from every column at once (see Column::gather()).
+     *
+     * @param rows the indices of the rows
+     * @param numRows the number of rows
+     * @return a new data frame of the given rows
+     */
+    DataFrame* gather(const size_t* rows, size_t numRows);
+
+    /**
+     * Returns the k rows with the greatest values of the given column of
+     * ints, doubles or bools, without sorting the data frame: every thread of
+     * pmap keeps a heap of its k best rows (see TopKRower). Of rows with equal
+     * values the first ones are kept; rows of NaN values are not.
+     *
+     * @param col the index of the column
+     * @param k the greatest number of rows returned
+     * @return a new data frame of up to k rows, the greatest value first
+     */
+    DataFrame* top_k(size_t col, size_t k);
+
+    /**
+     * Summarizes the values of the given column of ints, doubles or bools in
+     * a QuantileSketch, built by the threads of pmap and merged (see
+     * QuantileRower). The sketches of several data frames, such as the
+     * chunks of a distributed one, merge into the sketch of all their rows.
+     *
+     * @param col the index of the column
+     * @param k the capacity of the top level of the sketch
+     * @return a new sketch of the values of the column
+     */
+    QuantileSketch* quantile_sketch(size_t col, size_t k = DEFAULT_SKETCH_K);
+
+    /**
+     * Returns a lazy query of this DataFrame, its operators added in order
+     * and run by Query::run(). The Query is owned by the caller.
+     *
+     * @return a new query of every row and column of this data frame
+     */
+    Query* query();
+
     /**
      * Destructor of this DataFrame.
      */
     ~DataFrame();
 };
+
+template <typename T>
+TypedColumnView<T> DataFrame::view(size_t col) {
+    assert(col < this->ncols());
+    return TypedColumnView<T>(this->columns->get(col));
+}
+
+template <typename F>
+void DataFrame::map_rows(F f) {
+    size_t numRows = this->nrows();
+    for (size_t row = 0; row < numRows; row++) {
+        f(row);
+    }
+}
+
+template <typename F>
+void DataFrame::pmap_ranges(size_t numThreads, F f) {
+    assert(numThreads > 0);
+    size_t numRows = this->nrows();
+    RangeThread<F>** threads = new RangeThread<F>*[numThreads];
+    for (size_t i = 0; i < numThreads; i++) {
+        threads[i] = new RangeThread<F>(&f, i, i * numRows / numThreads,
+                                        (i + 1) * numRows / numThreads);
+    }
+    for (size_t i = 1; i < numThreads; i++) {
+        threads[i]->start();
+    }
+    threads[0]->run();
+    for (size_t i = 1; i < numThreads; i++) {
+        threads[i]->join();
+    }
+    for (size_t i = 0; i < numThreads; i++) {
+        delete threads[i];
+    }
+    delete[] threads;
+}
@@ -0,0 +1,183 @@
+#pragma once
+#include <cstddef>
+
+#include "../utils/object.h"
+#include "coltypes.h"
+
+class Column;
+class DataFrame;
+
+// the rows every node of an Expr evaluates at once
+#define EXPR_BATCH 1024
+
+/**
+ * Enumerator that represents the nodes of an expression: a column, a literal,
+ * the arithmetic, comparisons and boolean operations of two operands, the
+ * negation of one and the cast of one to another type.
+ */
+enum class ExprOp {
+    COLUMN,
+    LITERAL,
+    ADD,
+    SUBTRACT,
+    MULTIPLY,
+    DIVIDE,
+    EQUAL,
+    NOT_EQUAL,
+    LESS,
+    LESS_EQUAL,
+    GREATER,
+    GREATER_EQUAL,
+    AND,
+    OR,
+    NOT,
+    CAST
+};
+
+/**
+ * @brief Represents an expression over the int, double and bool columns of a
+ * DataFrame, such as price * qty or a > 5 && b, evaluated for every row
+ * without a Rower: a batch of EXPR_BATCH rows at a time, every node computing
+ * the batch into an array of its own with a loop specialized for its type
+ * and operation, from the arrays of its operands. Columns are read in place.
+ * bind() types the nodes for a data frame: arithmetic of ints and bools is of
+ * ints, and of doubles if either operand is a double; comparisons and boolean
+ * operations are of bools. The operands are cast to the type of their
+ * operation by cast nodes added by bind(): a bool is 1 or 0 and any non zero
+ * number is true; a double cast to an int is clamped to the range of an int,
+ * and a NaN is 0. Int arithmetic wraps around on overflow, and an int division
+ * by zero is 0, the value of a missing int.
+ * @file expr.h
+ * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
+ * @author Megha Rao <rao.m@husky.neu.edu>
+ * @date April 12, 2020
+ */
+class Expr : public Object {
+   public:
+    ExprOp op;
+    ColType type;        // the type of the values, set by bind()
+    Expr* left;          // owned; the first operand, or nullptr
+    Expr* right;         // owned; the second operand, or nullptr
+    size_t column;       // the index of the column of a COLUMN
+    int intValue;        // the value of a LITERAL, by its type
+    double doubleValue;
+    bool boolValue;
+    Column* source;      // external; the column of a COLUMN, set by bind()
+    void* buffer;        // owned; the values of a batch, set by bind()
+    const void* values;  // the values of the last batch evaluated
+
+    /**
+     * Returns a node of the values of the given column.
+     *
+     * @param column the index of the column
+     * @return a new expression
+     */
+    static Expr* col(size_t column);
+
+    /**
+     * Returns a node of the given value for every row.
+     *
+     * @param value the value
+     * @return a new expression
+     */
+    static Expr* literal(int value);
+    static Expr* literal(double value);
+    static Expr* literal(bool value);
+
+    /**
+     * Returns a node of the given arithmetic, comparison or boolean
+     * operation of the given operands.
+     *
+     * @param op the operation, from ADD to OR
+     * @param left the first operand, owned by the node from now on
+     * @param right the second operand, owned by the node from now on
+     * @return a new expression
+     */
+    static Expr* binary(ExprOp op, Expr* left, Expr* right);
+
+    /**
+     * Returns a node of the negation of the given operand.
+     *
+     * @param operand the operand, owned by the node from now on
+     * @return a new expression
+     */
+    static Expr* negate(Expr* operand);
+
+    /**
+     * Returns a node of the given operand cast to the given type.
+     *
+     * @param operand the operand, owned by the node from now on
+     * @param type ColType::INTEGER, ColType::DOUBLE or ColType::BOOLEAN
+     * @return a new expression
+     */
+    static Expr* cast(Expr* operand, ColType type);
+
+    /**
+     * Destructor of this Expr and its operands.
+     */
+    ~Expr();
+
+    /**
+     * Returns a copy of this expression and its operands, unbound.
+     *
+     * @return a new expression
+     */
+    Object* clone();
+
+    /**
+     * Types this expression and its operands for the given DataFrame, adding
+     * the casts of the operands, and allocates the arrays of a batch.
+     *
+     * @param df the data frame the expression is evaluated for
+     * @return the type of the values of this expression
+     */
+    ColType bind(DataFrame* df);
+
+    /**
+     * Replaces the index of every column by the given index of it, as the
+     * columns of a projection are replaced by the columns projected.
+     *
+     * @param cols the new index of every column
+     */
+    void remap(const size_t* cols);
+
+    /**
+     * Evaluates the rows of the given range, at most EXPR_BATCH of them, into
+     * the values of this node. The expression must be bound.
+     *
+     * @param begin the first row of the range
+     * @param end the row after the last one of the range
+     */
+    void evaluate_batch(size_t begin, size_t end);
+
+    /**
+     * Evaluates this expression for every row of the given DataFrame.
+     *
+     * @param df the data frame
+     * @return a new column of the value of every row
+     */
+    Column* evaluate(DataFrame* df);
+
+    /**
+     * Keeps the given rows of a range for which this bound bool expression
+     * is true.
+     *
+     * @param begin the first row of the range
+     * @param end the row after the last one of the range
+     * @param rows the rows being checked, in order and in the range,
+     * overwritten by the rows kept
+     * @param numRows the number of rows being checked
+     * @return the number of rows kept
+     */
+    size_t select(size_t begin, size_t end, size_t* rows, size_t numRows);
+
+   private:
+    // a node of the given operation, of no operand nor value
+    Expr(ExprOp op);
+
+    // allocates the array of a batch of this typed node, filled if a literal
+    void allocate_();
+
+    // casts the given bound operand to the given type, if of another one
+    static void cast_operand_(Expr** operand, ColType type);
+};
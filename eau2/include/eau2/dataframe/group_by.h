@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+
+#include "../utils/object.h"
+
+class DataFrame;
+class GroupTable;
+
+/**
+ * Enumerator that represents the aggregations of the values of a column over
+ * the rows of a group.
+ */
+enum class AggOp { COUNT, SUM, MIN, MAX, MEAN };
+
+/**
+ * @brief Represents the rows of a DataFrame grouped by the values of some of
+ * its columns, the keys, created by DataFrame::group_by(). The groups are
+ * aggregated into a new DataFrame by agg(): the rows are split between the
+ * threads, every thread aggregates its rows into a hash table of its own (see
+ * GroupTable) and the tables are merged in order. The resulting DataFrame
+ * holds the keys, then one column per aggregation, with one row per group in
+ * the order the groups first appear. A COUNT is an int column; a SUM is a
+ * double column, so the sum of a group of ints may pass the range of an int;
+ * MIN and MAX keep the type of the column; a MEAN is a double column. Only
+ * the rows of a string column can be counted. Missing ints, doubles and bools
+ * are 0 and false, as stored by their columns; missing strings are a key of
+ * their own.
+ * @file group_by.h
+ * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
+ * @author Megha Rao <rao.m@husky.neu.edu>
+ * @date April 12, 2020
+ */
+class GroupBy : public Object {
+   public:
+    DataFrame* df;  // external
+    size_t* keys;   // owned; indices of the key columns
+    size_t numKeys;
+    size_t numThreads;
+
+    /**
+     * Constructor of the rows of the given DataFrame grouped by the given
+     * columns, aggregated by one thread per core.
+     *
+     * @param df the data frame being grouped
+     * @param keys the indices of the key columns
+     * @param numKeys the number of key columns
+     */
+    GroupBy(DataFrame* df, const size_t* keys, size_t numKeys);
+
+    /**
+     * Destructor of this GroupBy.
+     */
+    ~GroupBy();
+
+    /**
+     * Aggregates the values of the given columns over every group.
+     *
+     * @param ops the aggregation of every column
+     * @param cols the index of every aggregated column
+     * @param numAggs the number of aggregations
+     * @return a new data frame of the keys and aggregations of every group
+     */
+    DataFrame* agg(const AggOp* ops, const size_t* cols, size_t numAggs);
+
+    /**
+     * Returns the groups of the given table, with every row aggregated, as
+     * the result of agg(): the keys, then one column per aggregation, with
+     * one row per group in the order of the table.
+     *
+     * @param table the table of the groups
+     * @return a new data frame of the keys and aggregations of every group
+     */
+    static DataFrame* to_frame(GroupTable* table);
+};
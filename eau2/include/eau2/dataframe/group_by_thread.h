@@ -0,0 +1,32 @@
+#pragma once
+#include "../utils/thread.h"
+#include "group_table.h"
+
+/**
+ * A thread that aggregates a range of rows of a data frame into a GroupTable
+ * of its own, used by GroupBy::agg().
+ */
+class GroupByThread : public Thread {
+   public:
+    GroupTable *table;  // owned
+    size_t beginRowIndex;
+    size_t endRowIndex;
+
+    /**
+     * Constructor that accepts the table the rows are aggregated into and the
+     * range of rows.
+     *
+     * @param table the table of the groups of the rows
+     * @param beginRowIndex the first row being aggregated
+     * @param endRowIndex the row after the last one being aggregated
+     */
+    GroupByThread(GroupTable *table, size_t beginRowIndex, size_t endRowIndex);
+
+    /**
+     * Destructor of this GroupByThread.
+     */
+    ~GroupByThread();
+
+    // adds every row of the range to the table
+    void run();
+};
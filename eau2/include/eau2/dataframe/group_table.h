@@ -0,0 +1,104 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "../utils/object.h"
+#include "coltypes.h"
+#include "group_by.h"
+
+class Column;
+
+// marks an empty slot of a GroupTable
+#define EMPTY_SLOT UINT64_MAX
+
+/**
+ * @brief Represents a hash table of the groups of the rows of a data frame
+ * and the partial aggregations of every group, used by GroupBy::agg(). The
+ * table is open addressed with linear probing: a slot holds the hash of the
+ * keys of its group next to the index of the group, so probing reads a
+ * single cache line of a single array and the keys are only compared (see
+ * RowKeys) when the hashes match. A group
+ * is identified by its first row, the keys being read from the key columns.
+ * Without key columns every row is of a single group.
+ * The aggregations of the groups are stored in a flat array, group after
+ * group, as doubles, which hold every int exactly.
+ * @file group_table.h
+ * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
+ * @author Megha Rao <rao.m@husky.neu.edu>
+ * @date April 12, 2020
+ */
+class GroupTable : public Object {
+   public:
+    Column** keys;  // external; the key columns
+    size_t numKeys;
+    Column** values;  // external; the column of every aggregation
+    const AggOp* ops;  // external; the aggregation of every column
+    size_t numAggs;
+    uint64_t* slots;  // owned; hash of the keys and group, or EMPTY_SLOT,
+                      // of every slot
+    size_t numSlots;  // a power of two
+    uint64_t* groupHashes;  // owned; hash of the keys of every group
+    size_t* firstRows;      // owned; first row of every group
+    size_t* counts;         // owned; number of rows of every group
+    double* aggregates;     // owned; numAggs aggregations per group
+    size_t numGroups;
+    size_t groupCapacity;
+
+    /**
+     * Constructor of an empty GroupTable.
+     *
+     * @param keys the key columns
+     * @param numKeys the number of key columns
+     * @param values the column of every aggregation
+     * @param ops the aggregation of every column
+     * @param numAggs the number of aggregations
+     */
+    GroupTable(Column** keys, size_t numKeys, Column** values,
+               const AggOp* ops, size_t numAggs);
+
+    /**
+     * Destructor of this GroupTable.
+     */
+    ~GroupTable();
+
+    /**
+     * Adds the given row to its group, creating the group if needed.
+     *
+     * @param row the index of the row
+     */
+    void add_row(size_t row);
+
+    /**
+     * Merges the groups of the given table, built from other rows of the
+     * same columns, into this table. The groups new to this table are added
+     * in the order of the other table.
+     *
+     * @param other the table being merged
+     */
+    void merge(GroupTable* other);
+
+    /**
+     * Returns the group of the keys of the given row, adding an empty group
+     * if there is none.
+     *
+     * @param row the index of the row
+     * @param hash the hash of the keys of the row
+     * @return the index of the group
+     */
+    size_t find_or_add(size_t row, uint64_t hash);
+
+    /**
+     * Returns the value of the given int, double or bool column at the given
+     * row as a double.
+     *
+     * @param column the column
+     * @param row the index of the row
+     * @return the value as a double
+     */
+    static double value(Column* column, size_t row);
+
+    /**
+     * Doubles the number of slots, placing every group again.
+     */
+    void grow_slots_();
+};
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+
+#include "../utils/object.h"
+
+class DataFrame;
+
+// the cache the partitions of a radix partitioned join are sized for
+#define JOIN_CACHE_BYTES (256 << 10)
+
+/**
+ * Enumerator that represents the rows kept by a join: the pairs of rows with
+ * equal keys, and for a LEFT join also the rows of the left DataFrame that
+ * have no match.
+ */
+enum class JoinType { INNER, LEFT };
+
+/**
+ * @brief Represents an equi-join of two DataFrames on the values of some of
+ * their columns, the keys, created by DataFrame::join(). A hash table (see
+ * JoinTable) is built on the rows of one side, the smaller one for an INNER
+ * join and the right one for a LEFT join, and the rows of the other side
+ * probe the table in parallel, every thread probing a range of rows (see
+ * JoinThread). When the table does not fit in cacheBytes, both sides are
+ * radix partitioned by the high bits of the hashes of their keys, so that the
+ * table of every partition fits in the cache, and the threads probe ranges of
+ * partitions. The result is gathered column by column into a new DataFrame
+ * holding every column of the left DataFrame, then every column of the right
+ * one. The rows are in the order of the probed side, and in the order of the
+ * built side for the rows with the same keys; a radix partitioned join
+ * groups the rows by partition first. The unmatched rows of a LEFT join hold
+ * missing values in the columns of the right DataFrame: 0, false and nullptr.
+ * Missing ints, doubles and bools are 0 and false, as stored by their
+ * columns, and join as such; missing strings join with missing strings.
+ * @file hash_join.h
+ * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
+ * @author Megha Rao <rao.m@husky.neu.edu>
+ * @date April 12, 2020
+ */
+class HashJoin : public Object {
+   public:
+    DataFrame* left;    // external
+    DataFrame* right;   // external
+    size_t* leftKeys;   // owned; indices of the key columns of left
+    size_t* rightKeys;  // owned; indices of the key columns of right
+    size_t numKeys;
+    JoinType type;
+    size_t numThreads;
+    size_t cacheBytes;  // the size the table of a partition is capped to
+
+    /**
+     * Constructor of a join of the given DataFrames on the given columns, of
+     * the same types, probed by one thread per core.
+     *
+     * @param left the left data frame
+     * @param right the right data frame
+     * @param leftKeys the indices of the key columns of left
+     * @param rightKeys the indices of the key columns of right
+     * @param numKeys the number of key columns
+     * @param type the type of the join
+     */
+    HashJoin(DataFrame* left, DataFrame* right, const size_t* leftKeys,
+             const size_t* rightKeys, size_t numKeys, JoinType type);
+
+    /**
+     * Destructor of this HashJoin.
+     */
+    ~HashJoin();
+
+    /**
+     * Joins the DataFrames.
+     *
+     * @return a new data frame of the columns of both data frames, with a
+     * row per pair of joined rows
+     */
+    DataFrame* run();
+};
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "../utils/object.h"
+
+class Column;
+
+// marks the end of a chain of a JoinTable, and a row without a match
+#define NO_ROW SIZE_MAX
+
+/**
+ * @brief Represents the rows of a side of a HashJoin, partitioned by the high
+ * bits of the hashes of their keys (see RowKeys) and, for the built side,
+ * chained into the buckets of a hash table per partition. The entries of a
+ * partition are contiguous and in the order of the rows; a bucket is the
+ * head of a chain of the entries whose hashes share their low bits, and the
+ * chains are in the order of the rows too. Without radix bits there is a
+ * single partition holding every row.
+ * @file join_table.h
+ * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
+ * @author Megha Rao <rao.m@husky.neu.edu>
+ * @date April 12, 2020
+ */
+class JoinTable : public Object {
+   public:
+    Column** keys;  // external; the key columns
+    size_t numKeys;
+    size_t radixBits;
+    size_t numPartitions;     // 2 to the power of radixBits
+    size_t* partitionStarts;  // owned; first entry of every partition, and
+                              // the number of entries
+    uint64_t* hashes;         // owned; hash of the keys of every entry
+    size_t* rows;             // owned; row of every entry
+    size_t* bucketStarts;     // owned; first bucket of every partition, or
+                              // nullptr if the rows are not chained
+    size_t* buckets;          // owned; first entry of every bucket, or NO_ROW
+    size_t* next;             // owned; next entry of the chain of every
+                              // entry, or NO_ROW
+
+    /**
+     * Constructor that partitions the rows of the given key columns.
+     *
+     * @param keys the key columns
+     * @param numKeys the number of key columns
+     * @param numRows the number of rows
+     * @param radixBits the number of bits of the hashes partitioning the rows
+     * @param chained true if the entries of every partition are chained
+     * into a hash table, false if they are only partitioned
+     */
+    JoinTable(Column** keys, size_t numKeys, size_t numRows, size_t radixBits,
+              bool chained);
+
+    /**
+     * Destructor of this JoinTable.
+     */
+    ~JoinTable();
+
+    /**
+     * Returns the partition of the given hash.
+     *
+     * @param hash the hash of the keys of a row
+     * @return the index of the partition
+     */
+    size_t partition(uint64_t hash);
+
+    /**
+     * Returns the first entry of the chain of the given hash in the given
+     * partition, following next; the entries of the chain may have other
+     * hashes.
+     *
+     * @param partition the partition of the hash
+     * @param hash the hash of the keys of a row
+     * @return the index of the first entry, or NO_ROW
+     */
+    size_t first(size_t partition, uint64_t hash);
+};
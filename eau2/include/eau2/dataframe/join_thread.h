@@ -0,0 +1,62 @@
+#pragma once
+#include "../utils/thread.h"
+#include "join_table.h"
+
+/**
+ * A thread that probes a JoinTable with a range of the rows of the other
+ * side of a HashJoin, or with a range of its partitions, collecting the pairs
+ * of rows with equal keys.
+ */
+class JoinThread : public Thread {
+   public:
+    JoinTable *table;    // external; the built side
+    Column **probeKeys;  // external; the key columns of the probed side
+    JoinTable *probed;   // external; the partitioned probed side, or nullptr
+                         // to probe a range of rows
+    size_t begin;        // the first row, or partition, being probed
+    size_t end;          // the row, or partition, after the last one
+    bool keepUnmatched;  // true to pair the unmatched rows with NO_ROW
+    size_t *probeRows;   // owned; the probed row of every pair
+    size_t *buildRows;   // owned; the built row of every pair, or NO_ROW
+    size_t numPairs;
+    size_t capacity;
+
+    /**
+     * Constructor that accepts the tables and the range being probed.
+     *
+     * @param table the table of the built side
+     * @param probeKeys the key columns of the probed side
+     * @param probed the partitioned probed side, or nullptr
+     * @param begin the first row, or partition if probed is given
+     * @param end the row, or partition, after the last one
+     * @param keepUnmatched true to keep the rows without a match
+     */
+    JoinThread(JoinTable *table, Column **probeKeys, JoinTable *probed,
+               size_t begin, size_t end, bool keepUnmatched);
+
+    /**
+     * Destructor of this JoinThread.
+     */
+    ~JoinThread();
+
+    // probes the table with every row of the range
+    void run();
+
+    /**
+     * Adds the pairs of the given probed row, whose keys have the given hash,
+     * and of the rows of the given partition of the table with equal keys.
+     *
+     * @param probeRow the probed row
+     * @param partition the partition of the hash
+     * @param hash the hash of the keys of the probed row
+     */
+    void probe_(size_t probeRow, size_t partition, uint64_t hash);
+
+    /**
+     * Adds a pair of rows, growing the arrays if needed.
+     *
+     * @param probeRow the probed row
+     * @param buildRow the built row, or NO_ROW
+     */
+    void add_pair_(size_t probeRow, size_t buildRow);
+};
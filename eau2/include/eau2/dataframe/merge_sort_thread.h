@@ -0,0 +1,64 @@
+#pragma once
+#include "../utils/object.h"
+#include "../utils/thread.h"
+
+// the length of the runs sorted by insertion before they are merged
+#define INSERTION_RUN 16
+
+/**
+ * A thread of the merge sort of SortBy over a range of rows, sorted by the
+ * values of a string column: either it sorts the range, or it merges its two
+ * sorted halves. The rows are sorted in place, with a buffer of the same
+ * size, and the rows with equal values keep their order.
+ */
+class MergeSortThread : public Thread {
+   public:
+    Object **strings;  // external; the value of every row
+    bool ascending;
+    size_t *rows;      // external; the rows being sorted
+    size_t *buffer;    // external; as many rows
+    size_t begin;
+    size_t middle;     // the first row of the second half, or end to sort
+    size_t end;
+
+    /**
+     * Constructor that accepts the values, the rows and the range of rows of
+     * this thread.
+     *
+     * @param strings the value of every row
+     * @param ascending true to sort in ascending order
+     * @param rows the rows being sorted
+     * @param buffer an array of as many rows
+     * @param begin the first row of the range
+     * @param middle the first row of the second sorted half, or end to sort
+     * the range
+     * @param end the row after the last one of the range
+     */
+    MergeSortThread(Object **strings, bool ascending, size_t *rows,
+                    size_t *buffer, size_t begin, size_t middle, size_t end);
+
+    // sorts the range or merges its halves
+    void run();
+
+    /**
+     * Returns true if the given row sorts strictly before the other one.
+     *
+     * @param row a row
+     * @param other the other row
+     * @return true if the value of row sorts before the value of other
+     */
+    bool before_(size_t row, size_t other);
+
+    /**
+     * Merges the sorted ranges [begin, middle) and [middle, end) of from into
+     * the same range of to.
+     *
+     * @param from the rows of the sorted ranges
+     * @param to the rows being merged into
+     * @param begin the first row of the first range
+     * @param middle the first row of the second range
+     * @param end the row after the last one of the second range
+     */
+    void merge_(const size_t *from, size_t *to, size_t begin, size_t middle,
+                size_t end);
+};
@@ -0,0 +1,115 @@
+#pragma once
+#include <cstddef>
+
+#include "../serialization/headers.h"
+#include "../utils/object.h"
+
+// the default capacity of the top level of a QuantileSketch
+#define DEFAULT_SKETCH_K 200
+
+/**
+ * @brief Represents an approximate summary of the distribution of a stream of
+ * doubles, answering quantile queries in memory that grows only with the
+ * logarithm of the length of the stream (a KLL sketch). Values are kept in
+ * levels of compactors: a value of level h stands for 2^h values of the
+ * stream. A full level is sorted and every other value of it, starting at a
+ * random one of the first two, is promoted to the level above, so the rank of
+ * every value is off by at most about 1.7 / k of the number of values added,
+ * with high probability. The top level holds up to k values and every level
+ * below it 2/3 of the one above, down to 8. Sketches of parts of a stream
+ * merge into the sketch of the whole, with the same error, so they can be
+ * built by several threads or nodes and merged, the latter after a trip
+ * through serialize() and deserialize().
+ * @file quantile_sketch.h
+ * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
+ * @author Megha Rao <rao.m@husky.neu.edu>
+ * @date April 12, 2020
+ */
+class QuantileSketch : public Object {
+   public:
+    size_t k;            // the capacity of the top level
+    size_t numLevels;    // levels in use, at least 1
+    double** levels;     // owned; the values of every level
+    size_t* sizes;       // owned; the number of values of every level
+    size_t* allocated;   // owned; the length of the array of every level
+    size_t* capacities;  // owned; the capacity of every level
+    size_t retained;     // the number of values of all levels
+    size_t capacity;     // the sum of the capacities
+    size_t count;        // the number of values added
+    double minimum;      // the least value added
+    double maximum;      // the greatest value added
+    unsigned int seed;   // picks the values promoted by a compaction
+
+    /**
+     * Constructor of an empty QuantileSketch whose top level holds up to the
+     * given number of values.
+     *
+     * @param k the capacity of the top level, at least 2; greater is more
+     * accurate and larger
+     */
+    QuantileSketch(size_t k = DEFAULT_SKETCH_K);
+
+    /**
+     * Destructor of this QuantileSketch.
+     */
+    ~QuantileSketch();
+
+    /**
+     * Adds the given value to the summarized stream.
+     *
+     * @param value the value being added
+     */
+    void add(double value);
+
+    /**
+     * Adds the values summarized by the given sketch to this one. The sketches
+     * should have the same k; the error is the one of the greater k otherwise.
+     *
+     * @param other the sketch being merged, left unchanged
+     */
+    void merge(QuantileSketch* other);
+
+    /**
+     * Returns a value whose rank among the added values is about the given
+     * fraction of their number: the least value for 0, the greatest for 1.
+     *
+     * @param q the fraction, between 0 and 1
+     * @return the approximate quantile, 0 if nothing was added
+     */
+    double quantile(double q);
+
+    /**
+     * Returns the number of values added to this sketch, merged included.
+     *
+     * @return the number of values summarized
+     */
+    size_t size();
+
+    /**
+     * Serializes this sketch as an array of doubles (see
+     * Serializer::serialize_double_array): k, the number of levels, count,
+     * minimum, maximum and seed, the size of every level and the values of
+     * every level.
+     *
+     * @return a new array of the bytes of this sketch
+     */
+    byte* serialize();
+
+    /**
+     * Deserializes a sketch serialized by serialize().
+     *
+     * @param bytes the bytes of the sketch
+     * @return a new sketch equal to the serialized one
+     */
+    static QuantileSketch* deserialize(byte* bytes);
+
+   private:
+    // sets the capacity of every level, for the current number of levels
+    void set_capacities_();
+
+    // appends the given value to the given level, adding levels up to it
+    void append_(size_t level, double value);
+
+    // compacts the lowest full level until the values fit the capacities
+    void compress_();
+};
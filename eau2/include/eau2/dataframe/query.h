@@ -0,0 +1,126 @@
+#pragma once
+#include <cstddef>
+
+#include "../sorer/predicate.h"
+#include "../utils/object.h"
+#include "expr.h"
+#include "group_by.h"
+#include "zone_map.h"
+
+class DataFrame;
+
+// the rows a thread takes through every operator of a Query at once
+#define MORSEL_ROWS (1 << 12)
+
+/**
+ * @brief Represents a lazy query of a DataFrame, created by
+ * DataFrame::query(): a scan of its rows, filtered, projected and optionally
+ * aggregated by the operators added in order, run only by run(). The
+ * operators are fused rather than run one after the other: the rows are
+ * split between the threads and every thread takes its rows a morsel of
+ * MORSEL_ROWS at a time through the checks of the filters, column after
+ * column, then through the expression filters (see Expr), and then adds the
+ * rows kept to its group table (see GroupTable) or to the rows of the
+ * result. No intermediate data frame is built, and every column is read
+ * once. A morsel whose zones (see ZoneMap) fail a check is skipped without
+ * reading any of its rows. The columns of an operator are those of the
+ * result of the operators before it; a projection reorders the columns, and
+ * an aggregation ends the query.
+ * @file query.h
+ * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
+ * @author Megha Rao <rao.m@husky.neu.edu>
+ * @date April 12, 2020
+ */
+class Query : public Object {
+   public:
+    DataFrame* df;         // external
+    Predicate* predicate;  // owned; the filters, of the columns of df
+    ZoneMap** zones;       // owned; the zone map of every check, by run()
+    Expr* expr;            // owned; the expression filters and-ed, or nullptr
+    size_t* cols;          // owned; the column of df of every result column
+    size_t numCols;
+    size_t* keys;          // owned; the key columns of df, if aggregated
+    size_t numKeys;
+    AggOp* ops;            // owned; every aggregation, if aggregated
+    size_t* aggCols;       // owned; the column of df of every aggregation
+    size_t numAggs;
+    bool aggregated;
+    size_t numThreads;
+
+    /**
+     * Constructor of a query of every row and column of the given DataFrame,
+     * run by one thread per core.
+     *
+     * @param df the data frame being queried
+     */
+    Query(DataFrame* df);
+
+    /**
+     * Destructor of this Query.
+     */
+    ~Query();
+
+    /**
+     * Keeps the rows passing the given check (see Condition::select()).
+     *
+     * @param condition the check of a column of the rows so far, owned by the
+     * query from now on
+     * @return this Query, to chain the operators
+     */
+    Query* filter(Condition* condition);
+
+    /**
+     * Keeps the rows for which the given bool expression is true, evaluated
+     * in batches by every thread on a copy of its own (see Expr).
+     *
+     * @param predicate the expression of the columns so far, owned by the
+     * query from now on
+     * @return this Query, to chain the operators
+     */
+    Query* filter(Expr* predicate);
+
+    /**
+     * Keeps the given columns, in the given order.
+     *
+     * @param cols the indices of the columns so far being kept
+     * @param numCols the number of columns kept
+     * @return this Query, to chain the operators
+     */
+    Query* project(const size_t* cols, size_t numCols);
+
+    /**
+     * Aggregates the rows so far grouped by the given columns, as
+     * GroupBy::agg() does; without keys, every row is of one group, and there
+     * is no group if no row is kept.
+     *
+     * @param keys the indices of the key columns so far
+     * @param numKeys the number of key columns, maybe 0
+     * @param ops the aggregation of every column
+     * @param cols the index of every aggregated column so far
+     * @param numAggs the number of aggregations
+     * @return this Query, to chain the operators
+     */
+    Query* aggregate(const size_t* keys, size_t numKeys, const AggOp* ops,
+                     const size_t* cols, size_t numAggs);
+
+    /**
+     * Keeps the rows of the given range passing every filter, the checks
+     * first. None is kept if the zones of the range fail a check.
+     *
+     * @param begin the first row of the range
+     * @param end the row after the last one of the range
+     * @param rows the array the rows kept are written to, in order, of at
+     * least end - begin rows
+     * @param expr the bound copy of expr of the thread, or nullptr
+     * @return the number of rows kept
+     */
+    size_t select(size_t begin, size_t end, size_t* rows, Expr* expr);
+
+    /**
+     * Runs this query.
+     *
+     * @return a new data frame of the rows and columns kept, or of the
+     * groups and aggregations if aggregated
+     */
+    DataFrame* run();
+};
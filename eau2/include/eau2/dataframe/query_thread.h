@@ -0,0 +1,40 @@
+#pragma once
+#include "../utils/thread.h"
+#include "group_table.h"
+#include "query.h"
+
+/**
+ * A thread that takes a range of rows of a data frame through the operators
+ * of a Query a morsel at a time, adding the rows kept to a GroupTable of its
+ * own if the query is aggregated and to its rows otherwise.
+ */
+class QueryThread : public Thread {
+   public:
+    Query *query;       // external
+    GroupTable *table;  // owned; nullptr unless aggregated
+    Expr *expr;         // owned; a bound copy of the expression filters
+    size_t *rows;       // owned; the rows kept, or of the last morsel
+    size_t numRows;     // the number of rows kept, unless aggregated
+    size_t beginRowIndex;
+    size_t endRowIndex;
+
+    /**
+     * Constructor that accepts the query, the table the rows are aggregated
+     * into and the range of rows.
+     *
+     * @param query the query being run
+     * @param table the table of the groups of the rows, or nullptr
+     * @param beginRowIndex the first row of the range
+     * @param endRowIndex the row after the last one of the range
+     */
+    QueryThread(Query *query, GroupTable *table, size_t beginRowIndex,
+                size_t endRowIndex);
+
+    /**
+     * Destructor of this QueryThread.
+     */
+    ~QueryThread();
+
+    // takes every morsel of the range through the query
+    void run();
+};
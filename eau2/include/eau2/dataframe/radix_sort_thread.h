@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+
+#include "../utils/thread.h"
+
+// the number of values of a digit of a radix sort
+#define RADIX_BUCKETS 256
+
+/**
+ * A thread of a pass of the LSD radix sort of SortBy over a range of the
+ * keys: the first step counts the keys of every value of the digit, the
+ * second one moves the keys and their rows to the offsets computed from the
+ * counts of every thread, in order, so the pass is stable.
+ */
+class RadixSortThread : public Thread {
+   public:
+    const uint64_t *keys;  // external; the keys in the current order
+    const size_t *rows;    // external; the row of every key
+    uint64_t *outKeys;     // external; the keys in the order of the pass
+    size_t *outRows;       // external; the row of every moved key
+    size_t begin;
+    size_t end;
+    size_t shift;     // the position of the digit in the keys
+    size_t *counts;   // owned; count, then offset, of every digit value
+    bool scatter;     // true to move the keys, false to count them
+
+    /**
+     * Constructor that accepts the range of keys of this thread.
+     *
+     * @param begin the first key of the range
+     * @param end the key after the last one of the range
+     */
+    RadixSortThread(size_t begin, size_t end);
+
+    /**
+     * Destructor of this RadixSortThread.
+     */
+    ~RadixSortThread();
+
+    // counts or moves the keys of the range
+    void run();
+};
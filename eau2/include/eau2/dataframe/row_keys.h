@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+class Column;
+
+/**
+ * @brief Hashes and compares the values of the key columns of the rows of
+ * data frames, shared by the hash tables of GroupTable and JoinTable. Ints,
+ * bools and the bits of doubles are mixed by the finalizer of splitmix64 and
+ * strings are hashed by FNV-1a; -0.0 equals 0.0 and a missing string is only
+ * equal to another missing string.
+ * @file row_keys.h
+ * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
+ * @author Megha Rao <rao.m@husky.neu.edu>
+ * @date April 12, 2020
+ */
+class RowKeys {
+   public:
+    /**
+     * Returns the hash of the keys of the given row.
+     *
+     * @param keys the key columns
+     * @param numKeys the number of key columns
+     * @param row the index of the row
+     * @return the hash of the keys
+     */
+    static uint64_t hash(Column** keys, size_t numKeys, size_t row);
+
+    /**
+     * Returns true if the given rows of the given key columns have the same
+     * keys. The key columns may belong to different data frames, but must
+     * have the same types.
+     *
+     * @param keys the key columns of the row
+     * @param row the index of the row
+     * @param otherKeys the key columns of the other row
+     * @param otherRow the index of the other row
+     * @param numKeys the number of key columns
+     * @return true if the keys of the rows are equal and false otherwise
+     */
+    static bool equal(Column** keys, size_t row, Column** otherKeys,
+                      size_t otherRow, size_t numKeys);
+};
@@ -0,0 +1,35 @@
+#pragma once
+#include "../quantile_sketch.h"
+#include "rower.h"
+
+/**
+ * Represents a rower that summarizes the values of the given column of ints,
+ * doubles or bools in a QuantileSketch. Clones summarize their part of the
+ * data frame and join by merging their sketches.
+ */
+class QuantileRower : public Rower {
+   public:
+    QuantileSketch *sketch;  // owned
+
+    /**
+     * A constructor that summarizes the values of the given column
+     *
+     * @param colIndex the column index this Rower will be iterating through
+     * @param k the capacity of the top level of the sketch
+     */
+    QuantileRower(size_t colIndex, size_t k = DEFAULT_SKETCH_K);
+
+    // accept method
+    virtual bool accept(Row &r);
+
+    // clone method, whose sketch promotes other values
+    Object *clone();
+
+    // join and then delete
+    virtual void join_delete(Rower *other);
+
+    /**
+     * Destructor of this QuantileRower.
+     */
+    virtual ~QuantileRower();
+};
@@ -40,4 +40,13 @@ class Rower : public Object {
      * @param rower the other Rower from the other thread
      */
     virtual void join_delete(Rower *other);
+
+    /**
+     * Returns the value of the column of this Rower, of ints, doubles or
+     * bools, in the given row as a double; true is 1.
+     *
+     * @param r the row the value is read from
+     * @return the value as a double
+     */
+    double get_number(Row &r);
 };
@@ -0,0 +1,55 @@
+#pragma once
+#include "rower.h"
+
+/**
+ * Represents a rower that keeps the rows with the k greatest values of the
+ * given column of ints, doubles or bools, in a heap of the k best rows seen
+ * so far whose root is the worst of them. Of rows with equal values the
+ * first one is better; NaNs are left out. Clones keep the best rows of their part of the data
+ * frame and join by offering theirs to the other heap.
+ */
+class TopKRower : public Rower {
+   public:
+    size_t k;
+    size_t size = 0;  // the number of rows kept
+    double *values;   // owned; the value of every kept row, as a heap
+    size_t *rows;     // owned; the index of every kept row, as a heap
+
+    /**
+     * A constructor that keeps the rows with the k greatest values of the
+     * given column
+     *
+     * @param colIndex the column index this Rower will be iterating through
+     * @param k the greatest number of rows kept
+     */
+    TopKRower(size_t colIndex, size_t k);
+
+    // accept method
+    virtual bool accept(Row &r);
+
+    // clone method
+    Object *clone();
+
+    // join and then delete
+    virtual void join_delete(Rower *other);
+
+    /**
+     * Offers the given row to this rower, kept if among the k best so far.
+     *
+     * @param value the value of the row
+     * @param row the index of the row
+     */
+    void offer(double value, size_t row);
+
+    /**
+     * Returns the kept rows, the best first, leaving the rower unchanged.
+     *
+     * @return a new array of the size indices of the kept rows
+     */
+    size_t *sorted_rows();
+
+    /**
+     * Destructor of this TopKRower.
+     */
+    virtual ~TopKRower();
+};
@@ -0,0 +1,103 @@
+#pragma once
+#include <cstddef>
+
+#include "../utils/object.h"
+
+class Column;
+class DataFrame;
+class Thread;
+
+// the fewest rows sorted by more than one thread
+#define PARALLEL_SORT_ROWS (1 << 14)
+
+/**
+ * @brief Represents the rows of a DataFrame sorted by the values of some of
+ * its columns, created by DataFrame::sort_by(). The sort computes a
+ * permutation of the rows with a stable sort per column, from the last
+ * column to the first, so the rows with equal values of a column stay sorted
+ * by the columns after it. Ints, doubles and bools are sorted by a parallel
+ * LSD radix sort of an unsigned key per row that orders like the values (see
+ * RadixSortThread), skipping the digits every key shares; strings are sorted
+ * by a parallel merge sort (see MergeSortThread). The permutation is then
+ * applied to every column at once by Column::gather(). Rows with equal values
+ * of every column keep their order. Missing ints, doubles and bools sort as
+ * 0 and false, as stored by their columns; missing strings sort before every
+ * string. -0.0 sorts as 0.0.
+ * @file sort_by.h
+ * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
+ * @author Megha Rao <rao.m@husky.neu.edu>
+ * @date April 12, 2020
+ */
+class SortBy : public Object {
+   public:
+    DataFrame* df;    // external
+    size_t* cols;     // owned; indices of the columns sorted by
+    bool* ascending;  // owned; the direction of every column
+    size_t numCols;
+    size_t numThreads;
+
+    /**
+     * Constructor of the rows of the given DataFrame sorted by the given
+     * columns, sorted by one thread per core.
+     *
+     * @param df the data frame being sorted
+     * @param cols the indices of the columns, the most significant first
+     * @param ascending true for every column sorted in ascending order
+     * @param numCols the number of columns
+     */
+    SortBy(DataFrame* df, const size_t* cols, const bool* ascending,
+           size_t numCols);
+
+    /**
+     * Destructor of this SortBy.
+     */
+    ~SortBy();
+
+    /**
+     * Returns the rows of the data frame in sorted order.
+     *
+     * @return a new array of the index of the row at every position
+     */
+    size_t* permutation();
+
+    /**
+     * Sorts the data frame.
+     *
+     * @return a new data frame of the rows in sorted order
+     */
+    DataFrame* run();
+
+    /**
+     * Sorts the given rows by the values of the given int, double or bool
+     * column, keeping the order of the rows with equal values.
+     *
+     * @param column the column sorted by
+     * @param ascending true to sort in ascending order
+     * @param rows the rows being sorted, sorted in place
+     * @param buffer an array of as many rows
+     * @param numRows the number of rows
+     */
+    void radix_sort_(Column* column, bool ascending, size_t* rows,
+                     size_t* buffer, size_t numRows);
+
+    /**
+     * Sorts the given rows by the values of the given string column, keeping
+     * the order of the rows with equal values.
+     *
+     * @param column the column sorted by
+     * @param ascending true to sort in ascending order
+     * @param rows the rows being sorted, sorted in place
+     * @param buffer an array of as many rows
+     * @param numRows the number of rows
+     */
+    void merge_sort_(Column* column, bool ascending, size_t* rows,
+                     size_t* buffer, size_t numRows);
+
+    /**
+     * Runs the given threads to completion, in this thread if there is one.
+     *
+     * @param threads the threads
+     * @param numThreads the number of threads
+     */
+    static void run_threads_(Thread** threads, size_t numThreads);
+};
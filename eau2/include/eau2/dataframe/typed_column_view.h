@@ -0,0 +1,114 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+
+#include "../utils/thread.h"
+#include "coltypes.h"
+#include "columns/bool_column.h"
+#include "columns/double_column.h"
+#include "columns/int_column.h"
+
+/**
+ * The column type and the array of the values of a column of ints, doubles or
+ * bools, by the type of its values.
+ */
+template <typename T>
+struct ColumnTraits;
+
+template <>
+struct ColumnTraits<int> {
+    static ColType type() { return ColType::INTEGER; }
+    static const int* values(Column* column) {
+        return column->as_int()->array->array;
+    }
+};
+
+template <>
+struct ColumnTraits<double> {
+    static ColType type() { return ColType::DOUBLE; }
+    static const double* values(Column* column) {
+        return column->as_double()->array->array;
+    }
+};
+
+template <>
+struct ColumnTraits<bool> {
+    static ColType type() { return ColType::BOOLEAN; }
+    static const bool* values(Column* column) {
+        return column->as_bool()->array->array;
+    }
+};
+
+/**
+ * @brief Represents the values of a column of ints, doubles or bools read as
+ * a plain array of the given type, created by DataFrame::view(). The type of
+ * the column is checked once, when the view is created, so reading a value is
+ * a single array access the compiler can inline and vectorize, rather than
+ * the type check and the two virtual calls of DataFrame::get_int() and the
+ * like. A view is a value, copied into the lambdas of DataFrame::map_rows()
+ * and DataFrame::pmap_ranges(); it is valid until the column changes.
+ * @file typed_column_view.h
+ * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
+ * @author Megha Rao <rao.m@husky.neu.edu>
+ * @date April 12, 2020
+ */
+template <typename T>
+class TypedColumnView {
+   public:
+    const T* values;  // external; the values of the column
+    size_t numRows;
+
+    /**
+     * Constructor of a view of the given column, of values of type T.
+     *
+     * @param column the column
+     */
+    TypedColumnView(Column* column) {
+        assert(column != nullptr);
+        assert(column->get_type() == ColumnTraits<T>::type());
+        this->numRows = column->size();
+        this->values =
+            this->numRows == 0 ? nullptr : ColumnTraits<T>::values(column);
+    }
+
+    /**
+     * Returns the value of the given row.
+     *
+     * @param row the index of the row
+     * @return the value
+     */
+    T operator[](size_t row) const { return this->values[row]; }
+
+    // the number of values
+    size_t size() const { return this->numRows; }
+
+    // the first and the past the last values, to iterate over them
+    const T* begin() const { return this->values; }
+    const T* end() const { return this->values + this->numRows; }
+};
+
+/**
+ * A thread that calls a lambda with its index and its range of rows, used by
+ * DataFrame::pmap_ranges().
+ */
+template <typename F>
+class RangeThread : public Thread {
+   public:
+    F* f;  // external
+    size_t index;
+    size_t beginRowIndex;
+    size_t endRowIndex;
+
+    RangeThread(F* f, size_t index, size_t beginRowIndex, size_t endRowIndex)
+        : Thread() {
+        this->f = f;
+        this->index = index;
+        this->beginRowIndex = beginRowIndex;
+        this->endRowIndex = endRowIndex;
+    }
+
+    // calls the lambda with the range
+    void run() {
+        (*this->f)(this->index, this->beginRowIndex, this->endRowIndex);
+    }
+};
@@ -0,0 +1,154 @@
+#pragma once
+#include <cstddef>
+
+#include "../serialization/headers.h"
+#include "../utils/object.h"
+#include "coltypes.h"
+
+class Column;
+class Condition;
+
+// the default number of rows of a zone of a ZoneMap
+#define ZONE_ROWS (1 << 12)
+
+/**
+ * @brief Represents the statistics of the zones of a column, consecutive
+ * ranges of its rows: the least and the greatest value of every zone of ints,
+ * doubles or bools (as 0 and 1), the number of missing values of every zone
+ * of strings and the number of rows of every zone. A filter skips the zones
+ * whose statistics show that none of their rows can pass its check (see
+ * may_match()), without reading them. A zone of a column held in memory has
+ * zoneRows rows, the last one up to them; every chunk of a data frame
+ * streamed into a KVStore is a zone of its own (see add_zone()). The bounds
+ * only ever widen when a value is set, so they may be looser than the values
+ * of the zone but never tighter. NaNs are left out of the bounds, as they
+ * fail every comparison but !=, which never skips a zone.
+ * @file zone_map.h
+ * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
+ * @author Megha Rao <rao.m@husky.neu.edu>
+ * @date April 12, 2020
+ */
+class ZoneMap : public Object {
+   public:
+    ColType type;        // the type of the column
+    size_t zoneRows;     // the rows of a full zone
+    size_t numZones;
+    size_t capacity;     // the length of the arrays of the zones
+    double* minimums;    // owned; the least value of every zone
+    double* maximums;    // owned; the greatest value of every zone
+    size_t* missing;     // owned; the missing strings of every zone
+    size_t* counts;      // owned; the number of rows of every zone
+    size_t numRows;      // the rows of all zones
+
+    /**
+     * Constructor of the empty ZoneMap of a column of the given type.
+     *
+     * @param type the type of the column
+     * @param zoneRows the rows of a full zone, at least 1
+     */
+    ZoneMap(ColType type, size_t zoneRows = ZONE_ROWS);
+
+    /**
+     * Destructor of this ZoneMap.
+     */
+    ~ZoneMap();
+
+    /**
+     * Adds the given rows of the given column to the last zone, starting a
+     * new one whenever it is full.
+     *
+     * @param column the column, of the type of this map
+     * @param begin the first row added
+     * @param end the row after the last one added
+     */
+    void append(Column* column, size_t begin, size_t end);
+
+    /**
+     * Adds the rows the given column has past the ones of this map, the
+     * rows pushed since it was last brought up to date.
+     *
+     * @param column the column of this map
+     */
+    void extend(Column* column);
+
+    /**
+     * Adds every row of the given column as a zone of its own, whatever the
+     * number of rows. The zones of such a map are looked up by index only.
+     *
+     * @param column the column, of the type of this map
+     */
+    void add_zone(Column* column);
+
+    /**
+     * Widens the bounds of the zone of the given row to hold the given
+     * value, set in the row. Rows past the ones of this map are ignored.
+     *
+     * @param row the index of the row
+     * @param value the value set, as a double
+     */
+    void widen(size_t row, double value);
+
+    /**
+     * Counts the given string row being set from missing or present to
+     * missing or present. Rows past the ones of this map are ignored.
+     *
+     * @param row the index of the row
+     * @param before true if the row was missing
+     * @param after true if the row is missing
+     */
+    void set_missing(size_t row, bool before, bool after);
+
+    /**
+     * Drops the zones of the rows from the given one on, and the zone of
+     * that row, to be added again by extend() with the current values.
+     *
+     * @param numRows the number of rows left in the column
+     */
+    void truncate(size_t numRows);
+
+    /**
+     * Returns false if no row of the given zone can pass the given check of
+     * the column of this map (see Condition::select()).
+     *
+     * @param condition the check
+     * @param zone the index of the zone
+     * @return false if the zone can be skipped and true otherwise
+     */
+    bool may_match(Condition* condition, size_t zone);
+
+    /**
+     * Returns false if no row of the given range can pass the given check,
+     * as no row of the zones of the range can.
+     *
+     * @param condition the check
+     * @param begin the first row of the range
+     * @param end the row after the last one of the range
+     * @return false if the range can be skipped and true otherwise
+     */
+    bool may_match(Condition* condition, size_t begin, size_t end);
+
+    /**
+     * Serializes this map as an array of doubles (see
+     * Serializer::serialize_double_array): the type, zoneRows and the number
+     * of zones, then the minimum, maximum, missing values and number of rows
+     * of every zone.
+     *
+     * @return a new array of the bytes of this map
+     */
+    byte* serialize();
+
+    /**
+     * Deserializes a map serialized by serialize().
+     *
+     * @param bytes the bytes of the map
+     * @return a new map equal to the serialized one
+     */
+    static ZoneMap* deserialize(byte* bytes);
+
+   private:
+    // starts an empty zone after the last one
+    void add_zone_();
+
+    // adds the given value, not a NaN, to the bounds of the given zone
+    void bound_(size_t zone, double value);
+};
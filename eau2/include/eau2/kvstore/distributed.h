@@ -0,0 +1,144 @@
+#pragma once
+#include <cstddef>
+
+#include "../dataframe/coltypes.h"
+#include "../dataframe/group_by.h"
+#include "../dataframe/hash_join.h"
+#include "../utils/object.h"
+#include "shuffle.h"
+
+class DataFrame;
+class KVStore;
+
+/**
+ * @brief Represents a group-by or a join of data frames spread over the
+ * nodes of a KVStore by a ChunkStream, run where the data is: the data frames
+ * are shuffled by their keys (see Shuffle) and every node runs the local
+ * GroupBy::agg() or HashJoin::run() on every partition it owns, one at a time
+ * (see ReduceThread). The result of a partition is put on its node as the
+ * chunk of the same index of the resulting data frame, which is read like any
+ * streamed data frame (see ChunkStream::load()), its rows grouped by
+ * partition. The number of partitions is a multiple of the number of nodes,
+ * large enough for a partition to fit in the given memory budget of a node,
+ * so a node only holds a partition at a time; the pieces of the other
+ * partitions wait in the KVStore, which spills them into segment files once
+ * its own memory budget is exceeded (see KVStore::set_memory_budget()).
+ * @file distributed.h
+ * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
+ * @author Megha Rao <rao.m@husky.neu.edu>
+ * @date April 12, 2020
+ */
+class Distributed : public Object {
+   public:
+    KVStore* kv;           // external
+    char* result;          // owned; name of the resulting data frame
+    Shuffle* left;         // owned; the shuffled (left) data frame
+    Shuffle* right;        // owned; the shuffled right data frame of a join,
+                           // or nullptr for a group-by
+    const AggOp* ops;      // external; the aggregations of a group-by
+    const size_t* cols;    // external; the aggregated columns of a group-by
+    size_t numAggs;
+    JoinType type;
+    size_t threadsPerNode;   // threads of a local group-by or join
+    size_t* partitionRows;   // owned; number of result rows per partition
+    ColType* resultTypes;    // owned; type of every result column
+    size_t numResultCols;
+
+    /**
+     * Constructor of a distributed operation of the given shuffles.
+     *
+     * @param kv the KVStore holding the data frames
+     * @param result the name of the resulting data frame
+     * @param left the shuffle of the (left) data frame
+     * @param right the shuffle of the right data frame, or nullptr
+     */
+    Distributed(KVStore* kv, const char* result, Shuffle* left,
+                Shuffle* right);
+
+    /**
+     * Destructor of this Distributed, and of its shuffles.
+     */
+    ~Distributed();
+
+    /**
+     * Groups the rows of the data frame of the given name, streamed into the
+     * given KVStore, by the given columns and stores the aggregations of the
+     * given columns of every group as a data frame of the given name (see
+     * GroupBy::agg()).
+     *
+     * @param kv the KVStore holding the data frame
+     * @param name the name of the data frame
+     * @param keys the indices of the key columns
+     * @param numKeys the number of key columns
+     * @param ops the aggregation of every column
+     * @param cols the index of every aggregated column
+     * @param numAggs the number of aggregations
+     * @param result the name of the resulting data frame
+     * @param nodeBudget the max bytes of a partition of a node; 0 for one
+     * partition per node
+     * @return true if the data frame was grouped and false if it is not there
+     */
+    static bool group_by(KVStore* kv, const char* name, const size_t* keys,
+                         size_t numKeys, const AggOp* ops, const size_t* cols,
+                         size_t numAggs, const char* result,
+                         size_t nodeBudget);
+
+    /**
+     * Joins the data frames of the given names, streamed into the given
+     * KVStore, on the given columns and stores the joined rows as a data
+     * frame of the given name (see HashJoin).
+     *
+     * @param kv the KVStore holding the data frames
+     * @param left the name of the left data frame
+     * @param right the name of the right data frame
+     * @param leftKeys the indices of the key columns of left
+     * @param rightKeys the indices of the key columns of right
+     * @param numKeys the number of key columns
+     * @param type the type of the join
+     * @param result the name of the resulting data frame
+     * @param nodeBudget the max bytes of a partition of both data frames on
+     * a node; 0 for one partition per node
+     * @return true if the data frames were joined and false if one of them
+     * is not there
+     */
+    static bool join(KVStore* kv, const char* left, const char* right,
+                     const size_t* leftKeys, const size_t* rightKeys,
+                     size_t numKeys, JoinType type, const char* result,
+                     size_t nodeBudget);
+
+    /**
+     * Returns the number of partitions of data frames of the given number of
+     * bytes over the given number of nodes: the smallest power of two of
+     * partitions per node small enough for the given budget of a node.
+     *
+     * @param bytes the number of bytes of the data frames
+     * @param numNodes the number of nodes
+     * @param nodeBudget the max bytes of a partition; 0 for no cap
+     * @return the number of partitions
+     */
+    static size_t num_partitions(size_t bytes, size_t numNodes,
+                                 size_t nodeBudget);
+
+    /**
+     * Shuffles the data frames, reduces every partition on its node and puts
+     * the metadata of the resulting data frame.
+     */
+    void run();
+
+    /**
+     * Runs the local group-by or join of the given partition.
+     *
+     * @param partition the index of the partition
+     * @return a new data frame of the result of the partition
+     */
+    DataFrame* reduce(size_t partition);
+
+    /**
+     * Puts the columns of the result of the given partition as the chunk of
+     * the same index of the resulting data frame.
+     *
+     * @param partition the index of the partition
+     * @param df the result of the partition
+     */
+    void store(size_t partition, DataFrame* df);
+};
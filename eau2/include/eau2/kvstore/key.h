@@ -11,6 +11,7 @@ class Key : public Object {
    public:
     const char *key;
     size_t nodeId;
+    bool owned;  // true if key was stolen and is deleted with this Key
 
     /**
      * Constructor of this Key object.
@@ -20,6 +21,33 @@ class Key : public Object {
      */
     Key(const char *key, size_t nodeId);
 
+    /**
+     * Constructor of this Key object that takes over the given cstring;
+     * steal must be true, the cstring is not copied and is deleted together
+     * with this Key.
+     *
+     * @param steal must be true
+     * @param key the key represented as cstring allocated with new[]
+     * @param nodeId the id of the node this key is associated with
+     */
+    Key(bool steal, char *key, size_t nodeId);
+
+    /**
+     * Returns true if the given object is a Key with the same name and node
+     * id as this Key.
+     *
+     * @param o the object being compared with this Key
+     * @return true if both keys are equal and false otherwise
+     */
+    bool equals(Object *o);
+
+    /**
+     * Computes the hash of this Key from its name and node id.
+     *
+     * @return the hash value of this Key
+     */
+    size_t hash_me();
+
     /**
      * Desturctor of this Key object.
      */
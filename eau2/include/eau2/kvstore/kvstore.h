@@ -3,6 +3,11 @@
 #include "../dataframe/dataframe.h"
 #include "../utils/lock.h"
 #include "../utils/thread.h"
+#include "segment_store.h"
+#include "wal.h"
+
+// fraction of the memory budget the values are evicted down to
+#define EVICTION_WATERMARK 0.9
 
 class DataFrame;
 
@@ -23,7 +28,20 @@ class FakeNode : public Thread {
 /**
  * @brief Represens a KV-store class that stores keys as a pair of cstring
  * (const char) and a node id associated with the value represented by
- * byte (unsigned char) type of serialized object.
+ * byte (unsigned char) type of serialized object. Every put publishes a new
+ * version of the value at the key. Published values are immutable, so readers
+ * holding an older version are never affected by a writer publishing a newer
+ * one; the map itself is only locked for the duration of a lookup or an
+ * insertion of a pointer, never while values are being serialized or read,
+ * nor while the log, the snapshots or the spilled values are written to disk.
+ * Optionally, puts are recorded in a write-ahead log and the contents of the
+ * map are periodically compacted into a snapshot, so the store can be
+ * recovered after a restart (see enable_durability()). Values can also be
+ * kept in memory mapped segment files instead of the heap (see
+ * enable_segments()), letting a node hold more data than fits in its RAM.
+ * Alternatively, the bytes of values kept on the heap can be capped (see
+ * set_memory_budget()): once a put goes over the budget, the least recently
+ * used values are spilled into segment files and read back from there.
  * @file kvstore.h
  * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
  * @author Megha Rao <rao.m@husky.neu.edu>
@@ -36,6 +54,21 @@ class KVStore : public Object {
     FakeNode** fake_nodes;
     // Array* network_nodes;
     Lock** locks;  // for simulating network behavior
+    Lock mapLock;  // guards the structure of the map, not the values
+    WriteAheadLog* wal;    // owned; nullptr unless durability is enabled
+    char* snapshotPath;    // owned; nullptr unless durability is enabled
+    size_t snapshotEvery;  // logged puts between snapshots; 0 for never
+    Array* ownedKeys;      // owned; keys created by this store
+    SegmentStore* segments;  // owned; nullptr until values are spilled
+    bool putToSegments;      // true if puts store values in segments
+    size_t memoryBudget;     // max bytes of values on the heap; 0 for no cap
+    size_t activeReaders;    // gets decoding a value outside of mapLock
+    byte** retired;          // owned; spilled values freed once unread
+    size_t numRetired;
+    size_t retiredCapacity;
+    size_t activeCopies;     // snapshots and evictions copying values
+    bool evicting;           // true while values are being spilled
+    bool snapshotting;       // true while a snapshot is being written
 
     /**
      * Constructor of this KVStore.
@@ -43,12 +76,58 @@ class KVStore : public Object {
     KVStore();
 
     /**
-     * Puts a new serialized object into this KVStore.
+     * Puts a new serialized object into this KVStore. If the key is already
+     * present, the object becomes the next version of the key.
+     *
+     * @param key the given Key associated with given serialized object
+     * @param value the given serialized object to be stored in this KVStore
+     * @return the version assigned to the given serialized object
+     */
+    size_t put(Key* key, byte* value);
+
+    /**
+     * Puts a new serialized object into this KVStore only if the latest
+     * version of the key is the expected one. An expected version of 0 means
+     * that the key must not be present yet.
+     *
+     * @param key the given Key associated with given serialized object
+     * @param value the given serialized object to be stored in this KVStore
+     * @param expected the version the key is expected to be at
+     * @return true if the object was stored and false otherwise
+     */
+    bool put_if_version(Key* key, byte* value, size_t expected);
+
+    /**
+     * Puts a new serialized object into this KVStore like put(), taking the
+     * given key over: it is deleted with this KVStore, or right away if the
+     * key was already present. Used by producers that create a key per value,
+     * such as the streaming ingestion of a SOR file.
      *
      * @param key the given Key associated with given serialized object
      * @param value the given serialized object to be stored in this KVStore
+     * @return the version assigned to the given serialized object
+     */
+    size_t put_owned(Key* key, byte* value);
+
+    /**
+     * Returns the latest version of the value at the given key, or 0 if the
+     * key is not present in this KVStore.
+     *
+     * @param key the key associated with serialized object
+     * @return the latest version of the value at the given key
      */
-    void put(Key* key, byte* value);
+    size_t version(Key key);
+
+    /**
+     * Deletes the versions of the value at the given key older than the given
+     * version. Readers must not be holding any of the deleted versions.
+     * Waits for the snapshots and evictions copying values to finish.
+     *
+     * @param key the key associated with serialized object
+     * @param version the oldest version to be kept
+     * @return the number of versions deleted
+     */
+    size_t prune(Key key, size_t version);
 
     /**
      * Returns a serialized object wrapped in the DataFrame. If key is not
@@ -59,6 +138,74 @@ class KVStore : public Object {
      */
     DataFrame* get(Key key);
 
+    /**
+     * Returns the given version of a serialized object wrapped in the
+     * DataFrame. If the key or the version is not found, returns nullptr.
+     * Checks local storage only.
+     *
+     * @param key the key associated with serialized object
+     * @param version the version of the serialized object
+     * @return deserialized object represented as DataFrame
+     */
+    DataFrame* get(Key key, size_t version);
+
+    /**
+     * Returns the latest version of a serialized column, decoded into a new
+     * column like get() decodes a data frame. If the key is not found,
+     * returns nullptr. Safe while other threads put values over the memory
+     * budget, unlike decoding the bytes of get_bytes().
+     *
+     * @param key the key associated with the serialized column
+     * @return the deserialized column; owned by the caller
+     */
+    Column* get_column(Key key);
+
+    /**
+     * Returns the latest version of a serialized object decoded by the given
+     * function, like get_column() decodes a column: the value is not spilled
+     * and freed by a put over the memory budget while it is being decoded.
+     * If the key is not found, returns nullptr without calling the function.
+     *
+     * @param key the key associated with serialized object
+     * @param decode the function, called as decode(bytes), returning a
+     * pointer to the decoded object
+     * @return the decoded object, as returned by the function
+     */
+    template <typename F>
+    auto get_decoded(Key key, F decode) -> decltype(decode(nullptr));
+
+    /**
+     * Returns the latest version of a serialized object without decoding or
+     * copying it: a view into the mapped segment when segments are enabled.
+     * If the key is not found, returns nullptr. The view stays valid until
+     * the version is pruned. With a memory budget, a value on the heap may be
+     * spilled and freed by a later put, so it has to be decoded first.
+     *
+     * @param key the key associated with serialized object
+     * @return the serialized object stored at the given key
+     */
+    byte* get_bytes(Key key);
+
+    /**
+     * Returns the given version of a serialized object without decoding or
+     * copying it. If the key or the version is not found, returns nullptr.
+     *
+     * @param key the key associated with serialized object
+     * @param version the version of the serialized object
+     * @return the serialized object of the given version
+     */
+    byte* get_bytes(Key key, size_t version);
+
+    /**
+     * Returns the number of bytes of the latest version of a serialized
+     * object, read under mapLock, so the value is not spilled and freed
+     * meanwhile. If the key is not found, returns 0.
+     *
+     * @param key the key associated with serialized object
+     * @return the number of serialized bytes of the value
+     */
+    size_t value_bytes(Key key);
+
     /**
      * Returns a serialized object wrapped in the DataFrame. If the key is not
      * found, returns nullptr. Checks neighboring network nodes for chunks of
@@ -68,6 +215,129 @@ class KVStore : public Object {
      */
     DataFrame* wait_and_get(Key key);
 
+    /**
+     * Makes the puts into this KVStore durable. First recovers the contents
+     * stored at the given path: the snapshot (path.snap) is mapped into memory
+     * and loaded, then the tail of the write-ahead log (path.wal) is replayed
+     * on top of it, after the log set aside by a snapshot that did not
+     * complete (path.wal.old), which is then compacted into a new snapshot.
+     * From then on every put is appended to the log, and the map is
+     * compacted into a new snapshot after every snapshotEvery logged puts.
+     *
+     * @param path the path prefix of the snapshot and log files
+     * @param snapshotEvery the number of logged puts between snapshots; 0
+     * disables periodic snapshots
+     * @param groupBytes the size of a group of log records committed at once
+     * @return the number of records recovered from the snapshot and the log
+     */
+    size_t enable_durability(const char* path, size_t snapshotEvery,
+                             size_t groupBytes);
+
+    /**
+     * Stores the values put from now on in memory mapped segment files
+     * created in the given directory instead of on the heap. A put copies the
+     * value to the end of the current segment and deletes the given array;
+     * the map keeps the location of the value and get_bytes() returns a view
+     * into the segment. Pages of cold values are written back by the OS and
+     * read again when the values are requested.
+     *
+     * @param directory the directory the segment files are created in
+     * @param segmentSize the size of a segment in bytes
+     */
+    void enable_segments(const char* directory, size_t segmentSize);
+
+    /**
+     * Caps the number of bytes of values kept on the heap of this node. When
+     * a put goes over the cap, the least recently used values (including
+     * older versions) are copied into memory mapped segment files until the
+     * values on the heap take up no more than EVICTION_WATERMARK of the cap,
+     * and their heap arrays are freed. Spilled values stay readable: gets read
+     * them from the mapped segments, which the OS pages in on demand.
+     *
+     * @param maxBytes the max number of bytes of values on the heap
+     * @param spillDirectory the directory of the segment files, used unless
+     * segments are already enabled
+     */
+    void set_memory_budget(size_t maxBytes, const char* spillDirectory);
+
+    /**
+     * Returns the number of bytes of values stored on the heap of this node.
+     *
+     * @return the number of bytes of values on the heap
+     */
+    size_t resident_bytes();
+
+    /**
+     * Spills the least recently used values if the values on the heap go
+     * over the memory budget. The caller must not hold mapLock.
+     */
+    void enforce_budget();
+
+    /**
+     * Spills the least recently used values into segments until the values
+     * on the heap take up at most the given number of bytes. The values are
+     * picked under mapLock, but sorted and copied into the segments without
+     * it, so gets are not held up; prune() waits for the copies. Does nothing
+     * while another eviction is running. The caller must not hold mapLock.
+     *
+     * @param targetBytes the max number of bytes of values left on the heap
+     * @return the number of values spilled
+     */
+    size_t evict(size_t targetBytes);
+
+    /**
+     * Frees the given spilled heap value, or defers it until no get is
+     * decoding a value. The caller must hold mapLock.
+     *
+     * @param value the heap value being freed
+     */
+    void retire(byte* value);
+
+    /**
+     * Marks the end of a read of a value outside of mapLock and frees the
+     * deferred values once no reads are left.
+     */
+    void release();
+
+    /**
+     * Commits the pending group of log records to disk. Does nothing if
+     * durability is not enabled.
+     *
+     * @return false if the log could not be written and true otherwise
+     */
+    bool sync();
+
+    /**
+     * Writes the latest version of every key into a new snapshot and drops
+     * the log records it covers. The log is set aside first (see
+     * WriteAheadLog::rotate()) and the snapshot is written without mapLock,
+     * so puts and gets go on meanwhile. Does nothing if durability is not
+     * enabled or another snapshot is being written.
+     *
+     * @return true if a snapshot was written and false otherwise
+     */
+    bool snapshot();
+
     // destructor
     ~KVStore();
+
+   private:
+    // commits the log, spills values and writes a snapshot as found due by a
+    // put, once mapLock is released
+    void finish_put_(bool commitDue, bool overBudget, bool snapshotDue);
 };
+
+template <typename F>
+auto KVStore::get_decoded(Key key, F decode) -> decltype(decode(nullptr)) {
+    this->mapLock.lock();
+    byte* bytes = this->map->get(&key);
+    this->activeReaders++;
+    this->mapLock.unlock();
+    // the value is kept on the heap until released, so it is decoded unlocked
+    decltype(decode(nullptr)) value = nullptr;
+    if (bytes != nullptr) {
+        value = decode(bytes);
+    }
+    this->release();
+    return value;
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include "../utils/thread.h"
+#include "distributed.h"
+
+/**
+ * A thread that reduces the partitions owned by a node of a KVStore,
+ * partition % KVStore::num_nodes, for a Distributed group-by or join.
+ */
+class ReduceThread : public Thread {
+   public:
+    Distributed *job;  // external
+    size_t node;
+
+    /**
+     * Constructor that accepts the operation and the node whose partitions
+     * are reduced.
+     *
+     * @param job the distributed group-by or join
+     * @param node the index of the node
+     */
+    ReduceThread(Distributed *job, size_t node);
+
+    // reduces and stores every partition of the node, one at a time
+    void run();
+};
@@ -0,0 +1,83 @@
+#pragma once
+#include "../utils/lock.h"
+#include "../utils/object.h"
+
+#define DEFAULT_SEGMENT_SIZE (64 << 20)
+
+// segment of values that are not stored in a SegmentStore
+#define NO_SEGMENT static_cast<size_t>(-1)
+
+/**
+ * @brief Represents an append-only store of serialized values kept in large
+ * memory mapped segment files instead of the heap. Values are copied to the
+ * end of the current segment; a new segment is created once it is full. The
+ * pages of the segments are managed by the OS page cache, so a node can hold
+ * more values than fit in its RAM, with hot values staying in memory. The
+ * segment files are unlinked right after they are mapped: they live as long
+ * as this store and never outlive the process.
+ * @file segment_store.h
+ * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
+ * @author Megha Rao <rao.m@husky.neu.edu>
+ * @date April 7, 2020
+ */
+class SegmentStore : public Object {
+   public:
+    char* directory;     // owned; directory the segment files are created in
+    size_t segmentSize;  // size of a regular segment in bytes
+    byte** segments;     // owned; base address of every mapped segment
+    size_t* sizes;       // owned; mapped size of every segment
+    size_t numSegments;
+    size_t capacity;     // capacity of segments and sizes
+    size_t current;      // index of the segment being filled
+    size_t used;         // bytes used in the current segment
+    Lock lock;
+
+    /**
+     * Constructor of this SegmentStore.
+     *
+     * @param directory the directory the segment files are created in
+     * @param segmentSize the size of a segment in bytes
+     */
+    SegmentStore(const char* directory, size_t segmentSize);
+
+    /**
+     * Unmaps all the segments of this store.
+     */
+    ~SegmentStore();
+
+    /**
+     * Copies the given serialized value to the end of the current segment and
+     * returns its location. Values larger than a segment get a segment of
+     * their own.
+     *
+     * @param value the serialized value being appended
+     * @param segment set to the index of the segment holding the value
+     * @param offset set to the offset of the value within the segment
+     * @return the value inside the mapped segment
+     */
+    byte* append(byte* value, size_t* segment, size_t* offset);
+
+    /**
+     * Returns the value at the given location. The value stays valid as long
+     * as this store exists.
+     *
+     * @param segment the index of the segment holding the value
+     * @param offset the offset of the value within the segment
+     * @return the value inside the mapped segment
+     */
+    byte* view(size_t segment, size_t offset);
+
+    /**
+     * Returns the number of bytes mapped by all the segments.
+     *
+     * @return the number of bytes mapped by this store
+     */
+    size_t mapped_bytes();
+
+    /**
+     * Creates and maps a new segment file of at least the given size.
+     *
+     * @param size the minimal size of the new segment
+     */
+    void add_segment(size_t size);
+};
@@ -0,0 +1,110 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "../dataframe/coltypes.h"
+#include "../utils/object.h"
+#include "key.h"
+
+class DataFrame;
+class KVStore;
+
+/**
+ * @brief Represents the repartitioning of a data frame spread over the nodes
+ * of a KVStore by a ChunkStream, by the values of some of its columns, the
+ * keys. The rows of every chunk are hash partitioned by their keys (see
+ * RowKeys) and every partition of the chunk, a piece, is put into the
+ * KVStore on the node owning the partition, partition % KVStore::num_nodes,
+ * under the key "<prefix>:<column>:<partition>:<chunk>"; empty pieces are
+ * not put. Every node partitions the chunks it holds (see ShuffleThread), so
+ * the rows only travel to their owner through the puts of the store, and a
+ * node only holds a chunk at a time. A partition, the pieces of every chunk
+ * in order, is then loaded by its owner. A partition holds every row of its
+ * keys, so the rows of two data frames shuffled by equal keys into the same
+ * number of partitions join within their partitions (see Distributed).
+ * @file shuffle.h
+ * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
+ * @author Megha Rao <rao.m@husky.neu.edu>
+ * @date April 12, 2020
+ */
+class Shuffle : public Object {
+   public:
+    KVStore* kv;     // external
+    char* name;      // owned; name of the data frame being shuffled
+    char* prefix;    // owned; prefix of the keys of the pieces
+    size_t* keys;    // owned; indices of the key columns
+    size_t numKeys;
+    size_t numPartitions;
+    size_t numChunks;
+    size_t numCols;
+    ColType* types;  // owned; type of every column
+
+    /**
+     * Constructor of the shuffle of the data frame of the given name,
+     * streamed into the given KVStore, which must hold it.
+     *
+     * @param kv the KVStore holding the data frame and the pieces
+     * @param name the name of the data frame
+     * @param prefix the prefix of the keys of the pieces
+     * @param keys the indices of the key columns
+     * @param numKeys the number of key columns
+     * @param numPartitions the number of partitions
+     */
+    Shuffle(KVStore* kv, const char* name, const char* prefix,
+            const size_t* keys, size_t numKeys, size_t numPartitions);
+
+    /**
+     * Destructor of this Shuffle. The pieces stay in the KVStore.
+     */
+    ~Shuffle();
+
+    /**
+     * Partitions every chunk of the data frame, one thread per node.
+     */
+    void run();
+
+    /**
+     * Partitions the rows of the given chunk and puts the pieces.
+     *
+     * @param chunk the index of the chunk
+     */
+    void partition_chunk(size_t chunk);
+
+    /**
+     * Returns the rows of the given partition, in the order of the chunks.
+     *
+     * @param partition the index of the partition
+     * @return a new data frame of the rows of the partition
+     */
+    DataFrame* load(size_t partition);
+
+    /**
+     * Returns the partition of the keys of the given hash.
+     *
+     * @param hash the hash of the keys of a row
+     * @return the index of the partition
+     */
+    size_t partition(uint64_t hash);
+
+    /**
+     * Returns a new key of the given column of the piece of the given chunk
+     * in the given partition.
+     *
+     * @param column the index of the column
+     * @param partition the index of the partition
+     * @param chunk the index of the chunk
+     * @return the key of the piece; owned by the caller
+     */
+    Key* piece_key(size_t column, size_t partition, size_t chunk);
+
+    /**
+     * Returns the number of serialized bytes of the columns of the data frame
+     * of the given name streamed into the given KVStore, or 0 if it is not
+     * there.
+     *
+     * @param kv the KVStore the data frame was streamed into
+     * @param name the name of the data frame
+     * @return the number of bytes of the chunks of the data frame
+     */
+    static size_t frame_bytes(KVStore* kv, const char* name);
+};
@@ -0,0 +1,25 @@
+#pragma once
+#include "../utils/thread.h"
+#include "shuffle.h"
+
+/**
+ * A thread that partitions the chunks of a data frame held by a node of a
+ * KVStore, chunk % KVStore::num_nodes, for a Shuffle.
+ */
+class ShuffleThread : public Thread {
+   public:
+    Shuffle *shuffle;  // external
+    size_t node;
+
+    /**
+     * Constructor that accepts the shuffle and the node whose chunks are
+     * partitioned.
+     *
+     * @param shuffle the shuffle of the data frame
+     * @param node the index of the node
+     */
+    ShuffleThread(Shuffle *shuffle, size_t node);
+
+    // partitions every chunk of the node
+    void run();
+};
@@ -0,0 +1,46 @@
+#pragma once
+#include "../collections/arrays/array.h"
+#include "../collections/maps/byte_map.h"
+#include "../utils/object.h"
+
+// the first bytes of every snapshot file
+#define SNAPSHOT_MAGIC "EAU2SNAP"
+
+/**
+ * @brief Represents a compacted snapshot of the contents of a ByteMap. Only
+ * the latest version of every key is written, using the record layout of the
+ * write-ahead log (see wal.h), after an 8 byte magic and the number of
+ * records. A snapshot is written to a temporary file and renamed over the
+ * previous one, so a crash never leaves a partially written snapshot behind.
+ * Loading maps the file into memory instead of reading it through a buffer.
+ * @file snapshot.h
+ * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
+ * @author Megha Rao <rao.m@husky.neu.edu>
+ * @date April 6, 2020
+ */
+class Snapshot : public Object {
+   public:
+    /**
+     * Writes the given pairs, the latest version of every key of a map, to a
+     * snapshot at the given path and syncs it to disk. The pairs are only
+     * read, so they may be copies taken from the map under its lock.
+     *
+     * @param path the path of the snapshot file
+     * @param items the pairs being written
+     * @param numRecords the number of pairs
+     * @return true if the snapshot was written and false otherwise
+     */
+    static bool write(const char* path, KeyValueBytes** items,
+                      size_t numRecords);
+
+    /**
+     * Loads the snapshot at the given path into the given map. Keys are
+     * allocated and appended to the given array, which owns them.
+     *
+     * @param path the path of the snapshot file
+     * @param map the map the snapshot is loaded into
+     * @param keys the array owning the keys created for the map
+     * @return the number of records loaded; 0 if there is no valid snapshot
+     */
+    static size_t load(const char* path, ByteMap* map, Array* keys);
+};
@@ -0,0 +1,165 @@
+#pragma once
+#include "../collections/arrays/array.h"
+#include "../collections/maps/byte_map.h"
+#include "../utils/lock.h"
+#include "../utils/object.h"
+
+#define DEFAULT_GROUP_COMMIT_BYTES (1 << 20)
+
+/**
+ * @brief Represents an append-only write-ahead log of the puts performed on a
+ * KVStore. Records are collected in memory and written to the log file
+ * together (group commit): a group is written and synced to disk once it
+ * reaches the configured number of bytes or when commit() is called, so many
+ * puts share the cost of a single fdatasync. Every record has the following
+ * layout:
+ * [record size][checksum][version][node id][key length][key][serialized value]
+ * record size - the number of bytes in the record; includes its own size
+ * checksum - FNV-1a hash of all the bytes following the checksum
+ * version - the version of the value in the KVStore
+ * node id, key length, key - the Key associated with the value
+ * serialized value - the value exactly as stored in the KVStore
+ * The same record layout is used by the snapshot files (see snapshot.h).
+ * Appending only copies the record into memory; the pending group is written
+ * outside of the lock of the buffer, so appends go on while a group is being
+ * written and synced. Before a snapshot, the log is set aside (see rotate())
+ * so the records appended while the snapshot is written start a new log.
+ * @file wal.h
+ * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
+ * @author Megha Rao <rao.m@husky.neu.edu>
+ * @date April 6, 2020
+ */
+class WriteAheadLog : public Object {
+   public:
+    char* path;         // owned; the path of the log
+    char* rotatedPath;  // owned; the path of the log set aside, path.old
+    int fd;             // log file opened for appending
+    byte* buffer;       // owned; records not written to the log yet
+    size_t bufferSize;  // number of bytes in the buffer
+    size_t capacity;    // capacity of the buffer
+    size_t groupBytes;  // a group is committed once it reaches this size
+    size_t numRecords;  // records appended since the log was last reset
+    Lock lock;          // guards the buffer
+    Lock commitLock;    // orders the writes of groups to the file
+
+    /**
+     * Opens the log at the given path for appending, creating it if needed.
+     *
+     * @param path the path of the log file
+     * @param groupBytes the size of a group of records committed at once
+     */
+    WriteAheadLog(const char* path, size_t groupBytes);
+
+    /**
+     * Commits any pending records and closes the log.
+     */
+    ~WriteAheadLog();
+
+    /**
+     * Appends a record of a put to the pending group of the log, in memory.
+     * The record is durable once its group has been committed.
+     *
+     * @param key the key of the put
+     * @param value the serialized value of the put
+     * @param version the version assigned to the value
+     * @return true if the group reached groupBytes and is due to be
+     * committed, and false otherwise
+     */
+    bool append(Key* key, byte* value, size_t version);
+
+    /**
+     * Writes all the pending records to the log file and syncs it to disk.
+     * Interrupted writes are retried; if the log cannot be written the error
+     * is reported on stderr and the pending records are dropped.
+     *
+     * @return true if the records reached the disk and false otherwise
+     */
+    bool commit();
+
+    /**
+     * Commits the pending records and moves the log to rotatedPath, starting
+     * a new empty log at path. Every record set aside was appended before
+     * the call, so a snapshot taken after it covers them all. The error is
+     * reported on stderr if the log cannot be moved.
+     *
+     * @return true if the log was set aside and false otherwise
+     */
+    bool rotate();
+
+    /**
+     * Deletes the log set aside by rotate(), once a snapshot covers it.
+     */
+    void discard_rotated();
+
+    /**
+     * Drops all the records in the log, used once they are covered by a
+     * snapshot. The error is reported on stderr if the log cannot be
+     * truncated.
+     *
+     * @return true if the log was truncated and false otherwise
+     */
+    bool reset();
+
+    /**
+     * Returns the number of records appended since the log was last reset.
+     *
+     * @return the number of records in the log
+     */
+    size_t length();
+
+    /**
+     * Returns the number of bytes in a record of the given key and value.
+     *
+     * @param key the key of the record
+     * @param value the serialized value of the record
+     * @return the size of the record in bytes
+     */
+    static size_t record_size(Key* key, byte* value);
+
+    /**
+     * Writes the record of the given key, value and version to the given
+     * buffer, which must hold at least record_size() bytes.
+     *
+     * @param out the buffer the record is written to
+     * @param key the key of the record
+     * @param value the serialized value of the record
+     * @param version the version of the value
+     * @return the number of bytes written
+     */
+    static size_t write_record(byte* out, Key* key, byte* value,
+                               size_t version);
+
+    /**
+     * Reads the record at the start of the given bytes and restores it into
+     * the given map. Keys not present in the map yet are allocated and
+     * appended to the given array, which owns them. Returns 0 if the bytes
+     * do not hold a complete record with a valid checksum, which is how a
+     * torn write at the end of a log is detected.
+     *
+     * @param in the bytes holding the record
+     * @param available the number of bytes available at in
+     * @param map the map the record is restored into
+     * @param keys the array owning the keys created for the map
+     * @return the number of bytes consumed or 0 if the record is not valid
+     */
+    static size_t read_record(byte* in, size_t available, ByteMap* map,
+                              Array* keys);
+
+    /**
+     * Replays all the valid records of the log at the given path into the
+     * given map. Replay stops at the first torn or corrupted record.
+     *
+     * @param path the path of the log file
+     * @param map the map the records are restored into
+     * @param keys the array owning the keys created for the map
+     * @return the number of records replayed
+     */
+    static size_t replay(const char* path, ByteMap* map, Array* keys);
+
+   private:
+    // takes the pending group out of the buffer, or nullptr if it is empty
+    byte* take_group_(size_t* size);
+
+    // writes the given group taken from the buffer, syncs it and deletes it
+    bool write_group_(byte* group, size_t size);
+};
@@ -1,9 +1,12 @@
 #pragma once
 
+#include "../collections/arrays/packed_string_array.h"
 #include "../utils/object.h"
 #include "../utils/string.h"
 #include "headers.h"
 
+class Column;
+
 /**
  * @brief Represents a class that contains various method for deserializaing
  * various objects, primarily primitives and array of int, double, bool, String
@@ -89,13 +92,35 @@ class Deserializer : public Object {
 
     /**
      * Returns deserialized array of Strings given its serialized
-     * representation.
+     * representation. Missing Strings are nullptr.
      *
      * @param bytes serialized array of Strings
      * @return deserialized array of Strings
      */
     static String** deserialize_string_array(byte* bytes);
 
+    /**
+     * Returns deserialized array of Strings given its serialized
+     * representation as a PackedStringArray. Unlike deserialize_string_array,
+     * all characters are copied in a single pass into one block of memory
+     * instead of allocating a String per element. Missing Strings are
+     * empty.
+     *
+     * @param bytes serialized array of Strings
+     * @return deserialized array of Strings as one block of characters
+     */
+    static PackedStringArray* deserialize_packed_string_array(byte* bytes);
+
+    /**
+     * Returns a new column holding the values of the given serialized array
+     * of ints, doubles, bools or Strings. The values of primitive arrays are
+     * copied straight into the storage of the column.
+     *
+     * @param bytes serialized array
+     * @return the column of the type of the array holding its values
+     */
+    static Column* deserialize_column(byte* bytes);
+
     /**
      * Returns the size of the serialized array. Does not depend on the type
      * of the array.
@@ -1,4 +1,9 @@
 #pragma once
+#include <cstddef>
+
+// length written in place of the characters of a missing String of an array
+#define MISSING_STRING static_cast<size_t>(-1)
+
 /**
  * @brief This file represents various types headers of serialized objects.
  * @file headers.h
@@ -5,6 +5,8 @@
 #include "../utils/string.h"
 #include "headers.h"
 
+class Column;
+
 /**
  * @brief Represents a class that contains various method for serializaing
  * various objects, primarily primitives and array of int, double, bool, String
@@ -84,10 +86,21 @@ class Serializer : public Object {
     static byte* serialize_bool_array(bool* array, size_t size);
 
     /**
-     * Returns serialized array of Strings.
+     * Returns serialized array of Strings. A nullptr element is a missing
+     * String: its length is MISSING_STRING and it has no characters.
      *
      * @param value array of Strings to be serialized
      * @return serialized array of Strings
      */
     static byte* serialize_string_array(String** array, size_t size);
+
+    /**
+     * Returns the values of the given column serialized as an array of its
+     * type. Missing Strings are kept missing; the other missing values are
+     * serialized as the null value of their column.
+     *
+     * @param column the column to be serialized
+     * @return serialized array of the values of the column
+     */
+    static byte* serialize_column(Column* column);
 };
@@ -0,0 +1,174 @@
+#pragma once
+#include "../collections/arrays/coltype_array.h"
+#include "../collections/arrays/column_array.h"
+#include "../dataframe/dataframe.h"
+#include "../dataframe/zone_map.h"
+#include "../kvstore/kvstore.h"
+#include "../utils/lock.h"
+#include "../utils/thread.h"
+#include "predicate.h"
+
+// number of rows of a chunk of columns streamed into a KVStore
+#define DEFAULT_CHUNK_ROWS (1 << 16)
+// number of parsed chunks waiting to be stored before the parser blocks
+#define DEFAULT_MAX_PENDING 4
+// number of ints of the metadata before the types of the columns: three
+// counts of two ints each
+#define CHUNK_METADATA 6
+
+/**
+ * @brief Represents a thread that stores the chunks of columns parsed from a
+ * sorer file into a KVStore while the file is still being parsed. Every
+ * column of a chunk is serialized as an array and put under the key
+ * "<name>:<column>:<chunk>", on node chunk % KVStore::num_nodes. Once the
+ * stream is finished, the metadata of the data frame (see
+ * serialize_metadata()) is put under the key "<name>" on node 0,
+ * after the statistics of every chunk of every column (see ZoneMap), under
+ * the key "<name>:<column>:zones" on node 0.
+ * At most maxPending parsed chunks wait to be stored: the parser blocks in
+ * push() until the store catches up, so the memory used by the ingestion
+ * does not depend on the size of the file.
+ * @file chunk_stream.h
+ * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
+ * @author Megha Rao <rao.m@husky.neu.edu>
+ * @date April 9, 2020
+ */
+class ChunkStream : public Thread {
+   public:
+    KVStore* kv;
+    char* name;              // owned; name of the data frame
+    ColTypeArray* types;     // owned; type of every column of the chunks
+    size_t chunkRows;        // number of rows of a full chunk
+    ColumnArray** pending;   // owned; chunks waiting to be stored, in order
+    size_t maxPending;       // capacity of pending
+    size_t head;             // index of the oldest chunk of pending
+    size_t numPending;
+    bool finished;           // true once the last chunk has been pushed
+    Lock lock;               // guards pending and finished
+    size_t numChunks;        // number of chunks stored so far
+    size_t numRows;          // number of rows stored so far
+    ZoneMap** zones;         // owned; a zone per chunk stored, per column
+
+    /**
+     * Constructor of this ChunkStream.
+     *
+     * @param kv the KVStore the chunks are put into
+     * @param name the name of the data frame
+     * @param types the type of every column of the chunks; copied
+     * @param chunkRows the number of rows of a full chunk
+     * @param maxPending the number of chunks that may wait to be stored
+     */
+    ChunkStream(KVStore* kv, const char* name, ColTypeArray* types,
+                size_t chunkRows, size_t maxPending);
+
+    /**
+     * Destructor of this ChunkStream. Deletes the chunks never stored.
+     */
+    ~ChunkStream();
+
+    /**
+     * Hands a parsed chunk over to be stored, blocking while maxPending
+     * chunks are waiting.
+     *
+     * @param chunk the columns of the chunk; owned by this stream from now on
+     */
+    void push(ColumnArray* chunk);
+
+    /**
+     * Marks the last chunk as pushed and waits until every chunk and the
+     * metadata are stored.
+     */
+    void finish();
+
+    // stores the pushed chunks until the stream is finished
+    void run();
+
+    /**
+     * Serializes and puts every column of the given chunk into the KVStore.
+     *
+     * @param chunk the columns of the chunk
+     * @param index the index of the chunk in the data frame
+     */
+    void store_(ColumnArray* chunk, size_t index);
+
+    /**
+     * Returns a new key of the given column of the given chunk of a data
+     * frame streamed into the given KVStore.
+     *
+     * @param kv the KVStore the chunk is stored in
+     * @param name the name of the data frame
+     * @param column the index of the column
+     * @param chunk the index of the chunk
+     * @return the key of the chunk of the column; owned by the caller
+     */
+    static Key* chunk_key(KVStore* kv, const char* name, size_t column,
+                          size_t chunk);
+
+    /**
+     * Returns a new key of the zone map of the given column of a data frame
+     * streamed into the given KVStore, a zone per chunk.
+     *
+     * @param name the name of the data frame
+     * @param column the index of the column
+     * @return the key of the zone map of the column; owned by the caller
+     */
+    static Key* zones_key(const char* name, size_t column);
+
+    /**
+     * Returns the metadata of a data frame streamed into a KVStore: an int
+     * array of the number of rows, the number of rows of a chunk and the
+     * number of chunks, each as its low and high 32 bits, followed by the
+     * type of every column.
+     *
+     * @param numRows the number of rows of the data frame
+     * @param chunkRows the number of rows of a full chunk, or 0 if the
+     * chunks hold any number of rows
+     * @param numChunks the number of chunks
+     * @param types the type of every column
+     * @param numCols the number of columns
+     * @return the serialized metadata
+     */
+    static byte* serialize_metadata(size_t numRows, size_t chunkRows,
+                                    size_t numChunks, const ColType* types,
+                                    size_t numCols);
+
+    /**
+     * Returns the type of every column of the data frame of the given name
+     * streamed into the given KVStore, or nullptr if it is not there. The
+     * metadata is decoded as a reader of the KVStore (see
+     * KVStore::get_decoded()).
+     *
+     * @param kv the KVStore the data frame was streamed into
+     * @param name the name of the data frame
+     * @param numChunks set to the number of chunks
+     * @param numCols set to the number of columns
+     * @return a new array of the type of every column; owned by the caller
+     */
+    static ColType* read_metadata(KVStore* kv, const char* name,
+                                  size_t* numChunks, size_t* numCols);
+
+    /**
+     * Returns the data frame of the given name streamed into the given
+     * KVStore by a ChunkStream, or nullptr if it is not there.
+     *
+     * @param kv the KVStore the data frame was streamed into
+     * @param name the name of the data frame
+     * @return the data frame made of all the chunks
+     */
+    static DataFrame* load(KVStore* kv, const char* name);
+
+    /**
+     * Returns the rows passing the given check of the data frame of the
+     * given name streamed into the given KVStore, or nullptr if it is not
+     * there. The chunks whose zones fail the check are skipped: none of
+     * their columns is fetched, from this node or another one. Every chunk
+     * is read when the data frame has no zone maps.
+     *
+     * @param kv the KVStore the data frame was streamed into
+     * @param name the name of the data frame
+     * @param condition the check, external, or nullptr to keep every row
+     * @return the data frame made of the rows kept of the chunks
+     */
+    static DataFrame* load(KVStore* kv, const char* name,
+                           Condition* condition);
+};
@@ -0,0 +1,55 @@
+#pragma once
+#include "../collections/arrays/column_array.h"
+#include "../utils/object.h"
+
+// the first bytes of every column cache file
+#define COLUMN_CACHE_MAGIC "EAU2COLS"
+// appended to the path of a sorer file to get the path of its cache
+#define COLUMN_CACHE_SUFFIX ".eau2"
+
+/**
+ * @brief Represents a binary columnar cache of a parsed sorer file, kept next
+ * to the file. The cache holds an 8 byte magic, the size and the modification
+ * time of the sorer file it was built from, the number of columns and every
+ * column serialized as an array (see Serializer::serialize_column()). A cache
+ * is only used while the size and the modification time of the sorer file
+ * match, so an edited file is parsed again. A cache is written to a temporary
+ * file and renamed over the previous one. Loading maps the file into memory
+ * and copies the values of every column in one block instead of parsing the
+ * text again.
+ * @file column_cache.h
+ * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
+ * @author Megha Rao <rao.m@husky.neu.edu>
+ * @date April 10, 2020
+ */
+class ColumnCache : public Object {
+   public:
+    /**
+     * Returns the path of the cache of the sorer file at the given path.
+     *
+     * @param path the path of the sorer file
+     * @return the path of the cache; owned by the caller
+     */
+    static char* cache_path(const char* path);
+
+    /**
+     * Writes the given columns parsed from the sorer file at the given path
+     * to the cache of the file.
+     *
+     * @param path the path of the sorer file
+     * @param columns the columns parsed from the file
+     * @return true if the cache was written and false otherwise
+     */
+    static bool write(const char* path, ColumnArray* columns);
+
+    /**
+     * Loads the columns of the sorer file at the given path from its cache
+     * and appends them to the given array, unless there is no cache or the
+     * cache does not match the file.
+     *
+     * @param path the path of the sorer file
+     * @param columns the array the columns are appended to
+     * @return true if the columns were loaded and false otherwise
+     */
+    static bool load(const char* path, ColumnArray* columns);
+};
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 
 
 /**
@@ -51,3 +52,58 @@ bool is_int(char *c);
  * otherwise
  */
 bool is_float(char *c);
+
+/**
+ * Returns true if the given sequence of characters is a integer type. Unlike
+ * is_int(char*), the sequence does not need to be null terminated.
+ * @param c the first character of the sorer-type value
+ * @param len the number of characters of the value
+ * @return true of the given value is of integer type and false otherwise
+ */
+bool is_int(const char *c, size_t len);
+
+/**
+ * Returns true if the given sequence of characters is a float (double) type.
+ * Unlike is_float(char*), the sequence does not need to be null terminated.
+ * @param c the first character of the sorer-type value
+ * @param len the number of characters of the value
+ * @return true of the given value is of float (double) type and false
+ * otherwise
+ */
+bool is_float(const char *c, size_t len);
+
+/**
+ * Parses the given sequence of characters as a sorer bool value: a single 0
+ * or 1. Validates and converts the value in one pass.
+ * @param c the first character of the sorer-type value
+ * @param len the number of characters of the value
+ * @param value set to the parsed value if the value is a bool
+ * @return true if the given value is of bool type and false otherwise
+ */
+bool parse_bool(const char *c, size_t len, bool *value);
+
+/**
+ * Parses the given sequence of characters as a sorer integer value. Validates
+ * and converts the value in one pass, accepting exactly what
+ * is_int(const char*, size_t) accepts and converting it the way atoi does.
+ * Runs of eight digits are converted at once.
+ * @param c the first character of the sorer-type value
+ * @param len the number of characters of the value
+ * @param value set to the parsed value if the value is an integer
+ * @return true if the given value is of integer type and false otherwise
+ */
+bool parse_int(const char *c, size_t len, int *value);
+
+/**
+ * Parses the given sequence of characters as a sorer float (double) value.
+ * Validates and converts the value in one pass, accepting exactly what
+ * is_float(const char*, size_t) accepts. Values with at most 19 significant
+ * digits and 22 decimals, which are all the common ones, are converted
+ * exactly from their integer mantissa; the others fall back to strtod.
+ * @param c the first character of the sorer-type value
+ * @param len the number of characters of the value
+ * @param value set to the parsed value if the value is a float (double)
+ * @return true if the given value is of float (double) type and false
+ * otherwise
+ */
+bool parse_double(const char *c, size_t len, double *value);
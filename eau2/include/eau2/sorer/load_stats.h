@@ -0,0 +1,98 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include "../dataframe/coltypes.h"
+#include "../utils/object.h"
+
+// one line out of this many has its steps timed
+#define STATS_TIMING_PERIOD 16
+
+/**
+ * @brief Represents the counters and timers of loading sorer data with the SOR
+ * reader (see SOR::enable_stats()): the bytes and lines read, the rows added,
+ * skipped for not matching the schema or rejected by the predicate, the
+ * fields added per type and the time spent inferring the schema, splitting
+ * the lines into fields, evaluating the predicate and converting and
+ * appending the fields to the columns, which happen in a single pass. Reading
+ * the clock costs about as much as splitting a short line, so the steps of
+ * only one line out of STATS_TIMING_PERIOD are timed and the report
+ * extrapolates them to every line. The times of the threads of
+ * SOR::read_parallel() are summed, so they may add up to more than the total
+ * time of the load.
+ * @file load_stats.h
+ * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
+ * @author Megha Rao <rao.m@husky.neu.edu>
+ * @date April 11, 2020
+ */
+class LoadStats : public Object {
+   public:
+    size_t bytes;
+    size_t lines;
+    size_t timedLines;  // lines whose steps are timed
+    size_t rows;          // rows added to the columns
+    size_t skippedRows;   // rows with a field not matching the schema
+    size_t filteredRows;  // rows rejected by the predicate
+    size_t intFields;
+    size_t doubleFields;
+    size_t boolFields;
+    size_t stringFields;
+    size_t missingFields;
+    uint64_t schemaNanos;
+    uint64_t tokenizeNanos;  // of the timed lines, as the next two
+    uint64_t filterNanos;
+    uint64_t convertNanos;   // converting and appending the fields
+    uint64_t totalNanos;
+
+    /**
+     * Constructor of this LoadStats, with every counter and timer at 0.
+     */
+    LoadStats();
+
+    /**
+     * Sets every counter and timer of this LoadStats to 0.
+     */
+    void reset();
+
+    /**
+     * Adds the counters and timers of the given LoadStats to these, except
+     * for the total time.
+     *
+     * @param other the LoadStats being added
+     */
+    void merge(LoadStats* other);
+
+    /**
+     * Counts a line being read, returning the time its steps start if it is
+     * timed.
+     *
+     * @return the current time if the line is timed and 0 otherwise
+     */
+    uint64_t start_line();
+
+    /**
+     * Counts a field added to a column of the given type.
+     *
+     * @param type the type of the column
+     * @param missing true if the field is missing
+     */
+    void add_field(ColType type, bool missing);
+
+    /**
+     * Writes these counters and timers to the given file as a single line
+     * JSON object, with the times in seconds and the throughput in GB/s. The
+     * times of the steps of the lines are extrapolated from the timed lines.
+     *
+     * @param out the file the summary is written to
+     */
+    void report(FILE* out);
+
+    /**
+     * Returns the time of a monotonic clock, used to time the steps of a
+     * load.
+     *
+     * @return the time in nanoseconds
+     */
+    static uint64_t now_ns();
+};
@@ -0,0 +1,34 @@
+#pragma once
+#include "../utils/thread.h"
+
+class SOR;
+
+/**
+ * A thread that reads the lines starting within a byte range of sorer data
+ * into the columns of its own SOR, used to parse the chunks of one file in
+ * parallel.
+ */
+class ParseRangeThread : public Thread {
+   public:
+    SOR *sor;
+    const char *data;
+    size_t size;
+    size_t from;
+    size_t len;
+
+    /**
+     * Constructor that accepts the SOR holding the columns of the chunk and
+     * the byte range of the data being read into them.
+     *
+     * @param sor the SOR the chunk is read into
+     * @param data the sorer data
+     * @param size the number of bytes of the data
+     * @param from the starting position of the range
+     * @param len the length of the range
+     */
+    ParseRangeThread(SOR *sor, const char *data, size_t size, size_t from,
+                     size_t len);
+
+    // reads the lines of the range
+    void run();
+};
@@ -0,0 +1,163 @@
+#pragma once
+#include <cstddef>
+
+#include "../dataframe/coltypes.h"
+#include "../utils/object.h"
+
+class Column;
+
+/**
+ * Enumerator that represents the comparisons of a field with a value, and the
+ * checks of a field being missing or present.
+ */
+enum class CompareOp {
+    EQUAL,
+    NOT_EQUAL,
+    LESS,
+    LESS_EQUAL,
+    GREATER,
+    GREATER_EQUAL,
+    IS_MISSING,
+    IS_PRESENT
+};
+
+/**
+ * @brief Represents a check of one field of a sorer line: a comparison of the
+ * field with a value, or a check of the field being missing or present. The
+ * field is compared as a value of the type of the given value; a field that
+ * is missing or not of that type fails every comparison. The same check runs
+ * on the column of a DataFrame, for Query::filter(): ints and doubles compare
+ * with each other, only strings can be missing and a column of another type
+ * fails every comparison.
+ * @file predicate.h
+ * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
+ * @author Megha Rao <rao.m@husky.neu.edu>
+ * @date April 11, 2020
+ */
+class Condition : public Object {
+   public:
+    size_t column;  // index of the field of the line being checked
+    CompareOp op;
+    ColType type;  // type of the value; UNKNOWN for the missing checks
+    int intValue;
+    double doubleValue;
+    bool boolValue;
+    char* stringValue;  // owned
+    size_t stringLength;
+
+    /**
+     * Constructor of a check of the given field being missing or present.
+     *
+     * @param column the index of the field
+     * @param op CompareOp::IS_MISSING or CompareOp::IS_PRESENT
+     */
+    Condition(size_t column, CompareOp op);
+
+    /**
+     * Constructors of a comparison of the given field with the given value.
+     *
+     * @param column the index of the field
+     * @param op the comparison
+     * @param value the value the field is compared with
+     */
+    Condition(size_t column, CompareOp op, int value);
+    Condition(size_t column, CompareOp op, double value);
+    Condition(size_t column, CompareOp op, bool value);
+    Condition(size_t column, CompareOp op, const char* value);
+
+    /**
+     * Destructor of this Condition.
+     */
+    ~Condition();
+
+    /**
+     * Returns true if the given field passes this check.
+     *
+     * @param field the first character of the field, or nullptr if missing
+     * @param length the number of characters of the field
+     * @return true if the field passes this check and false otherwise
+     */
+    bool accept(const char* field, size_t length);
+
+    /**
+     * Keeps the rows of the given column that pass this check, in order.
+     *
+     * @param column the column of the checked field
+     * @param rows the indices of the rows being checked, overwritten by the
+     * indices of the rows kept
+     * @param numRows the number of rows being checked
+     * @return the number of rows kept
+     */
+    size_t select(Column* column, size_t* rows, size_t numRows);
+
+    /**
+     * Returns false if no row of a range of a column of the given type,
+     * whose statistics are given (see ZoneMap), can pass this check.
+     *
+     * @param type the type of the column
+     * @param minimum the least value of the range, of ints, doubles or bools
+     * @param maximum the greatest value of the range
+     * @param numMissing the number of missing values of the range, of strings
+     * @param numRows the number of rows of the range
+     * @return false if the range can be skipped and true otherwise
+     */
+    bool may_match(ColType type, double minimum, double maximum,
+                   size_t numMissing, size_t numRows);
+};
+
+/**
+ * @brief Represents a conjunction of checks of the fields of a sorer line,
+ * evaluated by the SOR reader right after a line is split into fields, so
+ * that the rows it rejects are never converted nor appended to the columns
+ * (see SOR::select_rows()). The fields are checked in the order the
+ * conditions were added, stopping at the first one failing.
+ * @file predicate.h
+ * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
+ * @author Megha Rao <rao.m@husky.neu.edu>
+ * @date April 11, 2020
+ */
+class Predicate : public Object {
+   public:
+    Condition** conditions;  // owned
+    size_t numConditions;
+    size_t capacity;
+
+    /**
+     * Constructor of a Predicate accepting every line.
+     */
+    Predicate();
+
+    /**
+     * Destructor of this Predicate.
+     */
+    ~Predicate();
+
+    /**
+     * Adds the given check to this Predicate, taking its ownership.
+     *
+     * @param condition the check the lines must pass
+     * @return this Predicate, to chain the checks
+     */
+    Predicate* add(Condition* condition);
+
+    /**
+     * Returns true if the given fields of a line pass every check. A field
+     * past the last one of the line is missing.
+     *
+     * @param fields the start of every field, nullptr for a missing one
+     * @param lengths the length of every field
+     * @param numFields the number of fields of the line
+     * @return true if the line passes every check and false otherwise
+     */
+    bool accept(const char** fields, const size_t* lengths, size_t numFields);
+
+    /**
+     * Returns true if the given null terminated fields of a line pass every
+     * check, as read by the stdio based reader.
+     *
+     * @param fields every field, nullptr for a missing one
+     * @param numFields the number of fields of the line
+     * @return true if the line passes every check and false otherwise
+     */
+    bool accept(char** fields, size_t numFields);
+};
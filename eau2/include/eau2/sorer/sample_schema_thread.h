@@ -0,0 +1,46 @@
+#pragma once
+#include "../collections/arrays/coltype_array.h"
+#include "../utils/thread.h"
+
+class SOR;
+
+/**
+ * A thread that infers the types of the columns of sorer data from blocks of
+ * lines spread across the data, used to sample a large mapped file in
+ * parallel: the pages of the blocks are faulted in concurrently.
+ */
+class SampleSchemaThread : public Thread {
+   public:
+    SOR *sor;             // owned; splits the sampled lines into fields
+    const char *data;
+    size_t size;
+    size_t *starts;       // owned; position of the first line of every block
+    size_t *numLines;     // owned; number of lines sampled from every block
+    size_t numBlocks;
+    size_t capacity;      // capacity of starts and numLines
+    ColTypeArray *types;  // owned; inferred type of every column seen
+
+    /**
+     * Constructor that accepts the sorer data being sampled.
+     *
+     * @param data the sorer data
+     * @param size the number of bytes of the data
+     */
+    SampleSchemaThread(const char *data, size_t size);
+
+    /**
+     * Destructor of this SampleSchemaThread.
+     */
+    ~SampleSchemaThread();
+
+    /**
+     * Adds a block of lines to be sampled by this thread.
+     *
+     * @param start the position of the first line of the block
+     * @param numLines the number of lines of the block
+     */
+    void add_block(size_t start, size_t numLines);
+
+    // samples the lines of every block
+    void run();
+};
@@ -1,12 +1,24 @@
 #pragma once
 #include "../collections/arrays/array.h"
+#include "../collections/arrays/coltype_array.h"
 #include "../dataframe/dataframe.h"
 #include "../utils/object.h"
+#include "../kvstore/kvstore.h"
 #include "helpers.h"
+#include "load_stats.h"
+#include "predicate.h"
+#include "tokenizer.h"
 
 // The maximum length of a line buffer. No lines over 4095 bytes
 static const int buff_len = 4096;
 
+// number of lines at the start of the data the schema is inferred from
+#define SCHEMA_SAMPLE_ROWS 500
+// number of blocks of lines across the data the schema is inferred from
+#define SCHEMA_SAMPLE_BLOCKS 64
+// number of lines of every sampled block
+#define SCHEMA_BLOCK_ROWS 16
+
 /**
  * @brief This file represents the sorer parses that reads the file in sor
  * format and creates a SOR object capable of returning the data in form of
@@ -32,6 +44,17 @@ static const int buff_len = 4096;
 class SOR : public Object {
    public:
     ColumnArray* columnArray;
+    const char** fields;  // owned; start of every field of the current line
+    size_t* lengths;      // owned; length of every field of the current line
+    size_t fieldCapacity;
+    Tokenizer* tokenizer;  // owned; finds the structural characters
+    size_t sampleRows;     // lines at the start sampled for the schema
+    size_t sampleBlocks;   // blocks across the data sampled for the schema
+    size_t* projection;    // owned; field read into every column, or nullptr
+    size_t numProjected;   // number of fields read when projection is set
+    Predicate* predicate;  // external; rows it rejects are skipped, or nullptr
+    LoadStats* stats;      // owned; counters of the last read, or nullptr
+    FILE* statsOut;        // external; the reads are reported to it, or nullptr
 
     /**
      * Constructor of this SOR class.
@@ -81,6 +104,232 @@ class SOR : public Object {
      */
     void read(FILE* f, size_t from, size_t len);
 
+    /**
+     * Reads the given columns of the data from the given file starting from
+     * the specified byte for specified length (see select_columns()).
+     *
+     * @param f the file being read
+     * @param from the starting position of reading the file
+     * @param len the length of the sequence being read from the file
+     * @param columns the indices of the columns of the file being read
+     * @param numColumns the number of columns being read
+     */
+    void read(FILE* f, size_t from, size_t len, const size_t* columns,
+              size_t numColumns);
+
+    /**
+     * Restricts the following reads of this SOR to the given columns of the
+     * file, which become the columns of this SOR in the given order. The
+     * fields of the other columns are still tokenized, since their
+     * boundaries are needed to find the next field, but are neither
+     * converted nor stored, so the time and memory of a read shrink with the
+     * columns left out. Only the read columns are checked against the
+     * schema: a row is skipped if one of them does not match it. A column
+     * past the last field of the file is a column of missing values. Must
+     * be called before the columns are added, with distinct columns.
+     *
+     * @param columns the indices of the columns of the file being read
+     * @param numColumns the number of columns being read
+     */
+    void select_columns(const size_t* columns, size_t numColumns);
+
+    /**
+     * Reads the rows of the data passing the given predicate from the given
+     * file starting from the specified byte for specified length (see
+     * select_rows()).
+     *
+     * @param f the file being read
+     * @param from the starting position of reading the file
+     * @param len the length of the sequence being read from the file
+     * @param predicate the predicate the rows being read must pass
+     */
+    void read(FILE* f, size_t from, size_t len, Predicate* predicate);
+
+    /**
+     * Restricts the following reads of this SOR to the rows passing the given
+     * predicate, or lifts the restriction given nullptr. The predicate is
+     * evaluated on the fields of a line as soon as it is split into fields,
+     * before any of them is converted, so a rejected row is never appended to
+     * the columns; reading and then filtering a data frame converts and
+     * copies every row. The conditions of the predicate refer to the columns
+     * of the file, which do not need to be read (see select_columns()). The
+     * predicate is not owned and must outlive the reads. The schema is still
+     * inferred from every row.
+     *
+     * @param predicate the predicate the rows being read must pass
+     */
+    void select_rows(Predicate* predicate);
+
+    /**
+     * Enables the counters and timers of the reads of this SOR (see
+     * LoadStats), which cost a few clock reads per line. They are reset at
+     * the start of every read and, given a file, written to it as a single
+     * line summary at its end. A read from the column cache (see
+     * read_cached()) only counts the rows.
+     *
+     * @param out the file the reads are reported to, or nullptr
+     */
+    void enable_stats(FILE* out);
+
+    /**
+     * Reads the data from the file at the given path starting from the
+     * specified byte for specified length. The file is mapped into memory and
+     * the fields are parsed in place, without copying lines and without a
+     * limit on their length. Every line starting within [from, from + len)
+     * is read in full; a line starting before from is left to the range
+     * holding its start. A range going past the end of the file ends with
+     * it, and an empty range reads nothing. The read value is stored as
+     * ColumnArray. The schema is inferred from a sample of the lines (see
+     * infer_columns_()) unless columns have already been added (see
+     * add_column_()), so that the ranges of a file can be read with the
+     * schema of the whole file.
+     *
+     * @param path the path of the file being read
+     * @param from the starting position of reading the file
+     * @param len the length of the sequence being read from the file
+     * @return false if the file cannot be opened and true otherwise
+     */
+    bool read_mapped(const char* path, size_t from, size_t len);
+
+    /**
+     * Reads the data from the file at the given path like read_mapped(), with
+     * the range split into one chunk per thread. The chunks are aligned to
+     * lines the same way read_mapped() aligns from and len, parsed in
+     * parallel into columns of their own and then moved, in order, to the
+     * bottom of the columns of this SOR. The schema is inferred once, with
+     * the sampled blocks split between the threads, and shared by all
+     * chunks.
+     *
+     * @param path the path of the file being read
+     * @param from the starting position of reading the file
+     * @param len the length of the sequence being read from the file
+     * @param numThreads the number of threads; 0 for one per core
+     * @return false if the file cannot be opened and true otherwise
+     */
+    bool read_parallel(const char* path, size_t from, size_t len,
+                       size_t numThreads);
+
+    /**
+     * Reads the whole file at the given path like read_mapped(), going
+     * through the binary columnar cache of the file (see ColumnCache): the
+     * columns are loaded from the cache when it matches the file, otherwise
+     * the file is parsed and the cache is written for the next run. The
+     * cache is only used if no columns have been added yet. The cache holds
+     * every column of the file, so a read restricted to some of them (see
+     * select_columns()) keeps these from the loaded or parsed columns. It
+     * also holds every row, so a read restricted to some rows (see
+     * select_rows()) parses the file without the cache.
+     *
+     * @param path the path of the file being read
+     * @return false if the file cannot be opened and true otherwise
+     */
+    bool read_cached(const char* path);
+
+    /**
+     * Streams the file at the given path into the given KVStore as chunks of
+     * columns (see ChunkStream) instead of reading it into the columns of
+     * this SOR. The file is mapped and parsed like read_mapped(); every time
+     * chunkRows rows are parsed, the chunk is handed over to a thread that
+     * serializes and puts it into the KVStore while the parsing goes on. At
+     * most maxPending parsed chunks wait to be stored, so the memory used
+     * does not depend on the size of the file; with a memory budget on the
+     * KVStore (see KVStore::set_memory_budget()), a node can ingest files
+     * larger than its RAM. The columns of this SOR only hold the schema. The
+     * data frame is read back with ChunkStream::load().
+     *
+     * @param path the path of the file being read
+     * @param kv the KVStore the chunks are put into
+     * @param name the name of the data frame in the KVStore
+     * @param chunkRows the number of rows of a chunk
+     * @param maxPending the number of chunks that may wait to be stored
+     * @return false if the file cannot be opened and true otherwise
+     */
+    bool stream_mapped(const char* path, KVStore* kv, const char* name,
+                       size_t chunkRows, size_t maxPending);
+
+    /**
+     * Reads the lines starting within [from, from + len) of the given sorer
+     * data held in memory, such as a mapped file.
+     *
+     * @param data the sorer data
+     * @param size the number of bytes of the data
+     * @param from the starting position of reading the data
+     * @param len the length of the sequence being read from the data
+     */
+    void read_bytes(const char* data, size_t size, size_t from, size_t len);
+
+    /**
+     * Returns the position of the first line starting at or after the given
+     * position of the data.
+     *
+     * @param data the sorer data
+     * @param size the number of bytes of the data
+     * @param from the position in the data
+     * @return the position of the start of the line
+     */
+    static size_t line_start_(const char* data, size_t size, size_t from);
+
+    /**
+     * Splits the line starting at the given position into fields, stored in
+     * fields and lengths of this SOR. A missing field has a nullptr start.
+     * Quotes of strings are not part of the fields. Jumps between the
+     * structural characters found by the tokenizer; only the spaces around
+     * values are looked for byte by byte.
+     *
+     * @param line the first character of the line
+     * @param end the end of the data
+     * @param numFields set to the number of fields of the line
+     * @return the start of the next line
+     */
+    const char* tokenize_line_(const char* line, const char* end,
+                               size_t* numFields);
+
+    /**
+     * Infers the schema of the columns from a sample of the lines of the
+     * data: the first sampleRows lines from the given start and
+     * sampleBlocks blocks of SCHEMA_BLOCK_ROWS lines at pseudo-random
+     * positions spread evenly over the rest of the data, so a large file gets
+     * the right types without a second full pass. Following the SoR rules,
+     * there are as many columns as fields in the longest sampled line and a
+     * column gets the lowest type holding all its sampled values; a column
+     * with only missing values is a bool column. The blocks are split
+     * between the given number of threads. The sampled positions do not
+     * depend on the number of threads, nor does the schema.
+     *
+     * @param data the sorer data
+     * @param size the number of bytes of the data
+     * @param start the position of the first line being sampled
+     * @param numThreads the number of threads sampling the data
+     */
+    void infer_columns_(const char* data, size_t size, size_t start,
+                        size_t numThreads);
+
+    /**
+     * Widens the given types of the columns with the types of the fields of
+     * at most the given number of lines starting at the given position of the
+     * data. Columns seen for the first time are appended.
+     *
+     * @param line the first character of the first line
+     * @param end the end of the data
+     * @param numLines the maximal number of lines being sampled
+     * @param types the types of the columns seen so far
+     */
+    void sample_lines_(const char* line, const char* end, size_t numLines,
+                       ColTypeArray* types);
+
+    /**
+     * Reads the lines starting within [line, last) of the data into the
+     * columns, stopping once the given number of rows have been added.
+     *
+     * @param line the first character of the first line
+     * @param last the position after which no line starts
+     * @param end the end of the data
+     * @param maxRows the maximal number of rows being added
+     * @return the first character of the first line not read
+     */
+    const char* parse_(const char* line, const char* last, const char* end,
+                       size_t maxRows);
+
     /**
      * Moves the file pointer to the start of the next line.
      *
@@ -90,7 +339,8 @@ class SOR : public Object {
     void seek_(FILE* f, size_t from);
 
     /**
-     * Infers the schema of the columns by reading the first row.
+     * Infers the schema of the columns from a sample of the lines of the
+     * file, the lines the mapped reader samples (see infer_columns_()).
      *
      * @param f the file being read
      * @param from the starting position of the file
@@ -98,6 +348,87 @@ class SOR : public Object {
      */
     void infer_columns_(FILE* f, size_t from, size_t len);
 
+    /**
+     * Widens the given types of the columns with the types of the fields of
+     * at most the given number of lines read from the given file. Columns
+     * seen for the first time are appended.
+     *
+     * @param f the file being read, at the start of a line
+     * @param numLines the maximal number of lines being sampled
+     * @param types the types of the columns seen so far
+     * @return the number of lines sampled
+     */
+    size_t sample_lines_(FILE* f, size_t numLines, ColTypeArray* types);
+
+    /**
+     * Adds an empty column of the given type to the schema of this SOR. A
+     * column of unknown type, which only had missing values, is a bool
+     * column.
+     *
+     * @param type the type of the column being added
+     */
+    void add_column_(ColType type);
+
+    /**
+     * Resets the counters and timers of this SOR at the start of a read.
+     *
+     * @return the time the read starts, or 0 if they are not enabled
+     */
+    uint64_t begin_stats_();
+
+    /**
+     * Sets the total time of a read and reports it at its end.
+     *
+     * @param start the time the read started
+     */
+    void end_stats_(uint64_t start);
+
+    /**
+     * Adds the time since the given time to the given timer, unless the step
+     * is not timed.
+     *
+     * @param start the time the timed step started, or 0 if it is not timed
+     * @param nanos the timer of the step
+     * @return the current time, the start of the next step, or 0
+     */
+    uint64_t lap_(uint64_t start, uint64_t* nanos);
+
+    /**
+     * Counts a row added to the columns, with the types of its fields, or a
+     * row skipped for not matching the schema.
+     *
+     * @param fields the fields of the row, nullptr for a missing one
+     * @param numFields the number of fields of the row
+     * @param added true if the row was added
+     * @param types the type of every column (see col_types_())
+     */
+    void count_row_(const char* const* fields, size_t numFields, bool added,
+                    const ColType* types);
+
+    /**
+     * Returns the types of the columns of this SOR as an array owned by the
+     * caller, looked up once per read instead of once per field.
+     *
+     * @return the type of every column
+     */
+    ColType* col_types_();
+
+    /**
+     * Adds the columns read by this SOR (see select_columns()) to its schema,
+     * given the types of all the columns of the file.
+     *
+     * @param types the types of the columns of the file
+     */
+    void add_columns_(ColTypeArray* types);
+
+    /**
+     * Returns the index of the field of a line read into the given column.
+     *
+     * @param col the index of the column
+     * @return the index of the field read into the column
+     */
+    size_t field_index_(size_t col);
+
     /**
      * Finds the start of the field value and null terminate it. Assumes that
      * input fields is terminated by '>' character. Note: muates the value of
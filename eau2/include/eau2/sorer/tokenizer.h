@@ -0,0 +1,96 @@
+#pragma once
+#include <cstdint>
+
+#include "../utils/object.h"
+
+// the number of bytes classified at once
+#define TOKENIZER_BLOCK 64
+
+/**
+ * Enumerator that represents the implementations of the block scan, from the
+ * portable one to the widest vector instructions.
+ */
+enum class ScanLevel { SCALAR = 0, SSE2 = 1, AVX2 = 2 };
+
+/**
+ * @brief Represents a scanner of the structural characters of sorer data
+ * ('<', '>', '"' and the end of line). The data is classified a block of 64
+ * bytes at a time into a bitmask of structural positions, using SSE2 (16
+ * bytes per instruction) or AVX2 (32 bytes per instruction) when the CPU
+ * supports them, or a scalar loop otherwise. The SOR reader jumps from one
+ * structural character to the next instead of looking at every byte.
+ * @file tokenizer.h
+ * @author Aliaksei Petrusevich <petrusevich.a@husky.neu.edu>
+ * @author Megha Rao <rao.m@husky.neu.edu>
+ * @date April 8, 2020
+ */
+class Tokenizer : public Object {
+   public:
+    const char* data;        // start of the data; blocks are relative to it
+    const char* end;         // end of the data
+    const char* blockStart;  // start of the block classified in mask
+    uint64_t mask;           // bit i is set if blockStart[i] is structural
+    ScanLevel level;
+
+    /**
+     * Constructor of this Tokenizer, using the best scan supported by the
+     * CPU.
+     */
+    Tokenizer();
+
+    /**
+     * Constructor of this Tokenizer using the given scan, used for testing
+     * and benchmarking the scans against each other.
+     *
+     * @param level the scan being used; must be supported by the CPU
+     */
+    Tokenizer(ScanLevel level);
+
+    /**
+     * Starts scanning the given data.
+     *
+     * @param data the start of the data
+     * @param end the end of the data
+     */
+    void reset(const char* data, const char* end);
+
+    /**
+     * Returns the first structural character at or after the given position,
+     * or the end of the data if there is none.
+     *
+     * @param position the position in the data
+     * @return the position of the next structural character or the end
+     */
+    // defined here so the calls for every field of a line are inlined
+    inline const char* next(const char* position) {
+        while (position < this->end) {
+            size_t offset = (position - this->data) % TOKENIZER_BLOCK;
+            const char* block = position - offset;
+            if (block != this->blockStart) {
+                this->blockStart = block;
+                this->mask = this->scan(block);
+            }
+            uint64_t remaining = this->mask >> offset;
+            if (remaining != 0) {
+                return position + __builtin_ctzll(remaining);
+            }
+            position = block + TOKENIZER_BLOCK;
+        }
+        return this->end;
+    }
+
+    /**
+     * Classifies the block starting at the given position.
+     *
+     * @param block the start of the block
+     * @return the bitmask of the structural characters of the block
+     */
+    uint64_t scan(const char* block);
+
+    /**
+     * Returns the widest scan supported by the CPU this runs on.
+     *
+     * @return the best supported ScanLevel
+     */
+    static ScanLevel best_level();
+};
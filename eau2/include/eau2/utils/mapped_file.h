@@ -0,0 +1,23 @@
+#pragma once
+#include "object.h"
+
+/** A read-only memory mapping of a whole file. The mapping is released when
+ *  the object is deleted, so pointers into data must not outlive it. */
+class MappedFile : public Object {
+   public:
+    byte* data;     // nullptr if the file is empty or could not be mapped
+    size_t length;  // number of bytes mapped
+    int fd;         // -1 if the file could not be opened
+
+    /** Maps the file at the given path. */
+    MappedFile(const char* path);
+
+    /** Returns true if the file was opened and mapped. */
+    bool is_open();
+
+    /** Returns the number of bytes in the mapped file. */
+    size_t size();
+
+    /** Unmaps the file. */
+    ~MappedFile();
+};
@@ -1,5 +1,6 @@
 #include "../../../include/eau2/collections/arrays/array.h"
 #include <cassert>
+#include <cstring>
 
 Array::Array() : Object() {
     this->array = new Object*[DEFAULT_ARRAY_SIZE];
@@ -23,6 +24,18 @@ void Array::append(Object* input) {
     this->elementsInserted++;
 }
 
+void Array::append_all(Object** inputs, int count) {
+    assert(count >= 0);
+    if (count == 0) {
+        return;
+    }
+    this->_ensure_size(this->elementsInserted + count);
+    memcpy(this->array + this->currentPosition, inputs,
+           count * sizeof(Object*));
+    this->currentPosition += count;
+    this->elementsInserted += count;
+}
+
 Object* Array::get(int index) {
     assert(index < this->elementsInserted);
     return this->array[index];
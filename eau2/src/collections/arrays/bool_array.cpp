@@ -1,5 +1,6 @@
 #include "../../../include/eau2/collections/arrays/bool_array.h"
 #include <cassert>
+#include <cstring>
 
 BoolArray::BoolArray() : Object() {
     this->array = new bool[DEFAULT_ARRAY_SIZE];
@@ -23,6 +24,17 @@ void BoolArray::append(bool input) {
     this->elementsInserted++;
 }
 
+void BoolArray::append_all(bool* inputs, int count) {
+    assert(count >= 0);
+    if (count == 0) {
+        return;
+    }
+    this->_ensure_size(this->elementsInserted + count);
+    memcpy(this->array + this->currentPosition, inputs, count * sizeof(bool));
+    this->currentPosition += count;
+    this->elementsInserted += count;
+}
+
 bool BoolArray::get(int index) {
     assert(index < this->elementsInserted);
     return this->array[index];
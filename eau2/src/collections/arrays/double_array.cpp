@@ -1,5 +1,6 @@
 #include "../../../include/eau2/collections/arrays/double_array.h"
 #include <cassert>
+#include <cstring>
 
 DoubleArray::DoubleArray() : Object() {
     this->array = new double[DEFAULT_ARRAY_SIZE];
@@ -23,6 +24,17 @@ void DoubleArray::append(double input) {
     this->elementsInserted++;
 }
 
+void DoubleArray::append_all(double* inputs, int count) {
+    assert(count >= 0);
+    if (count == 0) {
+        return;
+    }
+    this->_ensure_size(this->elementsInserted + count);
+    memcpy(this->array + this->currentPosition, inputs, count * sizeof(double));
+    this->currentPosition += count;
+    this->elementsInserted += count;
+}
+
 double DoubleArray::get(int index) {
     assert(index < this->elementsInserted);
     return this->array[index];
@@ -85,7 +97,6 @@ void DoubleArray::_ensure_size(int required) {
         }
         this->array = newArray;
         this->capacity = newCapacity;
-        this->capacity *= 2;
         delete[] oldArray;
     }
 }
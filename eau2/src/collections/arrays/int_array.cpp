@@ -1,5 +1,6 @@
 #include "../../../include/eau2/collections/arrays/int_array.h"
 #include <cassert>
+#include <cstring>
 
 IntArray::IntArray() : Object() {
     this->array = new int[DEFAULT_ARRAY_SIZE];
@@ -23,6 +24,17 @@ void IntArray::append(int& input) {
     this->elementsInserted++;
 }
 
+void IntArray::append_all(int* inputs, int count) {
+    assert(count >= 0);
+    if (count == 0) {
+        return;
+    }
+    this->_ensure_size(this->elementsInserted + count);
+    memcpy(this->array + this->currentPosition, inputs, count * sizeof(int));
+    this->currentPosition += count;
+    this->elementsInserted += count;
+}
+
 int IntArray::get(int index) {
     assert(index < this->elementsInserted);
     return this->array[index];
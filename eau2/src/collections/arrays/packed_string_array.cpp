@@ -0,0 +1,36 @@
+#include "../../../include/eau2/collections/arrays/packed_string_array.h"
+
+#include <cassert>
+
+#include "../../../include/eau2/utils/string.h"
+
+PackedStringArray::PackedStringArray(char* bytes, size_t* offsets,
+                                     size_t numElements)
+    : Object() {
+    assert(offsets != nullptr);
+    this->bytes = bytes;
+    this->offsets = offsets;
+    this->numElements = numElements;
+}
+
+size_t PackedStringArray::size() { return this->numElements; }
+
+const char* PackedStringArray::get_cstr(size_t index) {
+    assert(index < this->numElements);
+    return this->bytes + this->offsets[index];
+}
+
+size_t PackedStringArray::length(size_t index) {
+    assert(index < this->numElements);
+    // every string is followed by its terminator
+    return this->offsets[index + 1] - this->offsets[index] - 1;
+}
+
+String* PackedStringArray::get(size_t index) {
+    return new String(this->get_cstr(index), this->length(index));
+}
+
+PackedStringArray::~PackedStringArray() {
+    delete[] this->bytes;
+    delete[] this->offsets;
+}
@@ -17,47 +17,197 @@ size_t ByteMap::length() { return this->elementsInserted; }
 void ByteMap::clear() {
     for (size_t index = 0; index < tableSize; index++) {
         if (this->map[index] != nullptr) {
+            // superseded values are owned by this map
+            for (KeyValueBytes* old = this->map[index]->previous;
+                 old != nullptr; old = old->previous) {
+                if (!old->in_segment()) {
+                    delete[] old->getValue();
+                }
+            }
             delete this->map[index];
             this->map[index] = nullptr;
         }
     }
     this->elementsInserted = 0;
+    this->heapBytes = 0;
 }
 
 byte* ByteMap::get(Key* key) {
     assert(key != nullptr);
     size_t position = this->findPosition(key);
     KeyValueBytes* kv = this->map[position];
-    return kv == nullptr ? nullptr : kv->getValue();
+    if (kv == nullptr) {
+        return nullptr;
+    }
+    kv->lastAccess = ++this->clock;
+    return kv->getValue();
+}
+
+byte* ByteMap::get_version(Key* key, size_t version) {
+    assert(key != nullptr);
+    KeyValueBytes* kv = this->map[this->findPosition(key)];
+    if (kv == nullptr) {
+        return nullptr;
+    }
+    KeyValueBytes* found = kv->find_version(version);
+    if (found == nullptr) {
+        return nullptr;
+    }
+    found->lastAccess = ++this->clock;
+    return found->getValue();
+}
+
+size_t ByteMap::version(Key* key) {
+    assert(key != nullptr);
+    KeyValueBytes* kv = this->map[this->findPosition(key)];
+    return kv == nullptr ? 0 : kv->version;
+}
+
+KeyValueBytes* ByteMap::entry(Key* key) {
+    assert(key != nullptr);
+    return this->map[this->findPosition(key)];
+}
+
+void ByteMap::relocate(KeyValueBytes* kv, byte* view, size_t segment,
+                       size_t offset) {
+    assert(kv != nullptr);
+    assert(!kv->in_segment());
+    this->heapBytes -= kv->length;
+    kv->value = view;
+    kv->set_location(segment, offset);
+}
+
+size_t ByteMap::heap_bytes() { return this->heapBytes; }
+
+KeyValueBytes** ByteMap::getHeapItems(size_t* count) {
+    size_t capacity = this->elementsInserted + 1;
+    KeyValueBytes** items = new KeyValueBytes*[capacity];
+    *count = 0;
+    for (size_t index = 0; index < this->tableSize; index++) {
+        for (KeyValueBytes* kv = this->map[index]; kv != nullptr;
+             kv = kv->previous) {
+            if (kv->in_segment()) {
+                continue;
+            }
+            if (*count == capacity) {
+                KeyValueBytes** newItems = new KeyValueBytes*[capacity * 2];
+                memcpy(newItems, items, capacity * sizeof(KeyValueBytes*));
+                delete[] items;
+                items = newItems;
+                capacity *= 2;
+            }
+            items[*count] = kv;
+            (*count)++;
+        }
+    }
+    return items;
 }
 
-void ByteMap::set(Key* key, byte* value) {
+size_t ByteMap::set(Key* key, byte* value) {
     assert(key != nullptr);
     assert(value != nullptr);
     size_t position = this->findPosition(key);
-    if (!this->containsKey(key)) {
+    KeyValueBytes* current = this->map[position];
+    if (current == nullptr) {
         this->map[position] = new KeyValueBytes(key, value);
+        this->map[position]->lastAccess = ++this->clock;
+        this->heapBytes += this->map[position]->length;
         this->elementsInserted++;
         // check if rehashing required
         if (this->getLoadFactor() > LOAD_FACTOR) {
             this->rehash();
         }
-    } else {
-        this->map[position]->value = value;
+        return 1;
+    }
+    // the new version is fully built before it is published in the slot, the
+    // older versions stay untouched for readers still holding them
+    this->map[position] = new KeyValueBytes(current->getKey(), value,
+                                            current->version + 1, current);
+    this->map[position]->lastAccess = ++this->clock;
+    this->heapBytes += this->map[position]->length;
+    return current->version + 1;
+}
+
+bool ByteMap::restore(Key* key, byte* value, size_t version) {
+    assert(key != nullptr);
+    assert(value != nullptr);
+    size_t position = this->findPosition(key);
+    KeyValueBytes* current = this->map[position];
+    if (current == nullptr) {
+        this->map[position] = new KeyValueBytes(key, value, version, nullptr);
+        this->heapBytes += this->map[position]->length;
+        this->elementsInserted++;
+        if (this->getLoadFactor() > LOAD_FACTOR) {
+            this->rehash();
+        }
+        return true;
+    }
+    if (current->version >= version) {
+        return false;
+    }
+    this->map[position] =
+        new KeyValueBytes(current->getKey(), value, version, current);
+    this->heapBytes += this->map[position]->length;
+    return true;
+}
+
+bool ByteMap::set_if_version(Key* key, byte* value, size_t expected) {
+    if (this->version(key) != expected) {
+        return false;
+    }
+    this->set(key, value);
+    return true;
+}
+
+size_t ByteMap::prune(Key* key, size_t version) {
+    assert(key != nullptr);
+    KeyValueBytes* kv = this->map[this->findPosition(key)];
+    // find the oldest pair being kept
+    while (kv != nullptr && kv->previous != nullptr &&
+           kv->previous->version >= version) {
+        kv = kv->previous;
+    }
+    if (kv == nullptr) {
+        return 0;
+    }
+    size_t pruned = 0;
+    for (KeyValueBytes* old = kv->previous; old != nullptr;
+         old = old->previous) {
+        if (!old->in_segment()) {
+            this->heapBytes -= old->length;
+            delete[] old->getValue();
+        }
+        pruned++;
     }
+    delete kv->previous;
+    kv->previous = nullptr;
+    return pruned;
 }
 
 byte* ByteMap::remove(Key* key) {
     assert(key != nullptr);
-    if (this->containsKey(key)) {
-        size_t position = this->findPosition(key);
-        byte* value = this->map[position]->getValue();
-        delete this->map[position];
-        this->map[position] = nullptr;
-        this->elementsInserted--;
-        return value;
+    if (!this->containsKey(key)) {
+        return nullptr;
     }
-    return nullptr;
+    size_t position = this->findPosition(key);
+    KeyValueBytes* kv = this->map[position];
+    byte* value = kv->getValue();
+    this->prune(key, kv->version);
+    if (!kv->in_segment()) {
+        this->heapBytes -= kv->length;
+    }
+    delete kv;
+    this->map[position] = nullptr;
+    this->elementsInserted--;
+    // reinsert the rest of the probing cluster so lookups do not stop at the
+    // freed slot
+    for (size_t index = (position + 1) % this->tableSize;
+         this->map[index] != nullptr; index = (index + 1) % this->tableSize) {
+        KeyValueBytes* moved = this->map[index];
+        this->map[index] = nullptr;
+        this->map[this->findPosition(moved->getKey())] = moved;
+    }
+    return value;
 }
 
 Key** ByteMap::getKeys() {
@@ -135,7 +285,14 @@ size_t ByteMap::hash() {
 
 size_t ByteMap::findPosition(Key* key) {
     assert(key != nullptr);
-    size_t currentPosition = key->hash() % this->tableSize;
+    // spread similar keys (key1, key2, ...) apart to keep probe runs short
+    size_t hash = key->hash() * 0x9E3779B97F4A7C15ULL;
+    size_t currentPosition = (hash ^ (hash >> 32)) % this->tableSize;
+    // linear probing; the load factor guarantees an empty slot
+    while (this->map[currentPosition] != nullptr &&
+           !this->map[currentPosition]->getKey()->equals(key)) {
+        currentPosition = (currentPosition + 1) % this->tableSize;
+    }
     return currentPosition;
 }
 
@@ -191,4 +348,6 @@ void ByteMap::createMap() {
     this->tableSize = DEFAULT_MAP_SIZE;
     this->initMap(this->map, this->tableSize);
     this->elementsInserted = 0;
+    this->heapBytes = 0;
+    this->clock = 0;
 }
@@ -5,12 +5,48 @@
 
 #include "../../../include/eau2/serialization/deserializer.h"
 
-KeyValueBytes::KeyValueBytes(Key *key, byte *value) : Object() {
+KeyValueBytes::KeyValueBytes(Key *key, byte *value)
+    : KeyValueBytes(key, value, 1, nullptr) {}
+
+KeyValueBytes::KeyValueBytes(Key *key, byte *value, size_t version,
+                             KeyValueBytes *previous)
+    : Object() {
     this->key = key;
     this->value = value;
+    this->version = version;
+    this->previous = previous;
+    this->segment = NO_SEGMENT;
+    this->offset = 0;
+    this->length = Deserializer::num_bytes(value);
+    this->lastAccess = 0;
+}
+
+KeyValueBytes::~KeyValueBytes() {
+    // unlink the chain first so long histories are not deleted recursively
+    KeyValueBytes *current = this->previous;
+    while (current != nullptr) {
+        KeyValueBytes *older = current->previous;
+        current->previous = nullptr;
+        delete current;
+        current = older;
+    }
+}
+
+KeyValueBytes *KeyValueBytes::find_version(size_t version) {
+    KeyValueBytes *current = this;
+    while (current != nullptr && current->version > version) {
+        current = current->previous;
+    }
+    return current != nullptr && current->version == version ? current
+                                                             : nullptr;
+}
+
+void KeyValueBytes::set_location(size_t segment, size_t offset) {
+    this->segment = segment;
+    this->offset = offset;
 }
 
-KeyValueBytes::~KeyValueBytes() {}
+bool KeyValueBytes::in_segment() { return this->segment != NO_SEGMENT; }
 
 Key *KeyValueBytes::getKey() { return this->key; }
 
@@ -7,7 +7,7 @@
 ColType infer_type(char* c) {
     // missing values
     if (c == nullptr) {
-        return ColType::BOOLEAN;
+        return ColType::UNKNOWN;
     }
     // check boolean
     if (strlen(c) == 1) {
@@ -25,3 +25,42 @@ ColType infer_type(char* c) {
     }
     return ColType::STRING;
 }
+
+ColType infer_type(const char* c, size_t len) {
+    // missing values
+    if (c == nullptr) {
+        return ColType::UNKNOWN;
+    }
+    bool b;
+    int i;
+    double d;
+    if (parse_bool(c, len, &b)) {
+        return ColType::BOOLEAN;
+    }
+    if (parse_int(c, len, &i)) {
+        return ColType::INTEGER;
+    }
+    if (parse_double(c, len, &d)) {
+        return ColType::DOUBLE;
+    }
+    return ColType::STRING;
+}
+
+int type_order(ColType type) {
+    switch (type) {
+        case ColType::BOOLEAN:
+            return 0;
+        case ColType::INTEGER:
+            return 1;
+        case ColType::DOUBLE:
+            return 2;
+        case ColType::STRING:
+            return 3;
+        default:
+            return -1;
+    }
+}
+
+ColType widen_type(ColType type, ColType other) {
+    return type_order(other) > type_order(type) ? other : type;
+}
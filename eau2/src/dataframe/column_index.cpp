@@ -0,0 +1,452 @@
+#include "../../include/eau2/dataframe/column_index.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include "../../include/eau2/dataframe/columns/bool_column.h"
+#include "../../include/eau2/dataframe/columns/double_column.h"
+#include "../../include/eau2/dataframe/columns/int_column.h"
+#include "../../include/eau2/dataframe/columns/string_column.h"
+#include "../../include/eau2/dataframe/dataframe.h"
+#include "../../include/eau2/dataframe/sort_by.h"
+
+// mixes the bits of the given key, so nearby values land in far buckets
+static uint64_t mix(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+}
+
+// hashes ints, doubles and bools alike, as they compare with each other
+static uint64_t hash_number(double value) {
+    value = value == 0.0 ? 0.0 : value;  // -0.0 equals 0.0
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return mix(bits);
+}
+
+static uint64_t hash_chars(const char* chars, size_t length) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ static_cast<unsigned char>(chars[i])) *
+               1099511628211ULL;
+    }
+    return mix(hash);
+}
+
+// returns the thread whose share of the buckets holds the given bucket, the
+// share of a thread starting at thread * numBuckets / numThreads
+static size_t share(size_t bucket, size_t numThreads, size_t numBuckets) {
+    return ((bucket + 1) * numThreads - 1) / numBuckets;
+}
+
+static int compare_rows(const void* a, const void* b) {
+    size_t x = *static_cast<const size_t*>(a);
+    size_t y = *static_cast<const size_t*>(b);
+    return (x > y) - (x < y);
+}
+
+ColumnIndex::ColumnIndex(DataFrame* df, size_t col, IndexType type)
+    : Object() {
+    assert(df != nullptr);
+    assert(col < df->ncols());
+    this->df = df;
+    this->col = col;
+    this->type = type;
+    this->heads = nullptr;
+    this->next = nullptr;
+    this->rows = nullptr;
+    this->added = nullptr;
+    this->addedCapacity = 0;
+    this->numThreads = std::thread::hardware_concurrency();
+    this->numThreads = this->numThreads > 0 ? this->numThreads : 1;
+    this->build_();
+}
+
+ColumnIndex::~ColumnIndex() {
+    delete[] this->heads;
+    delete[] this->next;
+    delete[] this->rows;
+    delete[] this->added;
+}
+
+void ColumnIndex::extend() {
+    if (this->stale) {
+        this->build_();
+        return;
+    }
+    size_t numRows = this->df->nrows();
+    while (this->numRows < numRows) {
+        this->add_(this->numRows);
+    }
+}
+
+void ColumnIndex::invalidate() { this->stale = true; }
+
+bool ColumnIndex::supports(Condition* condition) {
+    assert(condition != nullptr);
+    if (condition->column != this->col) {
+        return false;
+    }
+    switch (condition->op) {
+        case CompareOp::EQUAL:
+            return true;
+        case CompareOp::LESS:
+        case CompareOp::LESS_EQUAL:
+        case CompareOp::GREATER:
+        case CompareOp::GREATER_EQUAL:
+            return this->type == IndexType::SORTED;
+        default:
+            return false;
+    }
+}
+
+size_t* ColumnIndex::lookup(Condition* condition, size_t* numRows) {
+    assert(this->supports(condition));
+    assert(!this->stale && this->numRows == this->df->nrows());
+    Column* column = this->df->columns->get(this->col);
+    size_t* result;
+    if (this->type == IndexType::HASH) {
+        // 0. the rows of the bucket of the value, in ascending order
+        uint64_t hash;
+        switch (condition->type) {
+            case ColType::INTEGER:
+                hash = hash_number(condition->intValue);
+                break;
+            case ColType::DOUBLE:
+                hash = hash_number(condition->doubleValue);
+                break;
+            case ColType::BOOLEAN:
+                hash = hash_number(condition->boolValue);
+                break;
+            default:
+                hash = hash_chars(condition->stringValue,
+                                  condition->stringLength);
+                break;
+        }
+        size_t bucket = hash & (this->numBuckets - 1);
+        size_t length = 0;
+        for (size_t row = this->heads[bucket]; row != SIZE_MAX;
+             row = this->next[row]) {
+            length++;
+        }
+        result = new size_t[length];
+        size_t position = length;
+        for (size_t row = this->heads[bucket]; row != SIZE_MAX;
+             row = this->next[row]) {
+            result[--position] = row;
+        }
+        // 1. the rows of the value, not only of its bucket
+        *numRows = condition->select(column, result, length);
+        return result;
+    }
+
+    // the range of the sorted rows passing the check
+    this->merge_();
+    size_t begin = 0;
+    size_t end = this->numSorted;
+    switch (condition->op) {
+        case CompareOp::EQUAL:
+            begin = this->partition_(condition, CompareOp::LESS, false);
+            end = this->partition_(condition, CompareOp::LESS_EQUAL, false);
+            break;
+        case CompareOp::LESS:
+        case CompareOp::LESS_EQUAL:
+            end = this->partition_(condition, condition->op, false);
+            break;
+        default:
+            begin = this->partition_(condition, condition->op, true);
+            break;
+    }
+    *numRows = end - begin;
+    result = new size_t[*numRows];
+    memcpy(result, this->rows + begin, *numRows * sizeof(size_t));
+    qsort(result, *numRows, sizeof(size_t), compare_rows);
+    return result;
+}
+
+size_t ColumnIndex::memory_bytes() {
+    size_t bytes = sizeof(ColumnIndex) + this->capacity * sizeof(size_t);
+    if (this->type == IndexType::HASH) {
+        bytes += this->numBuckets * sizeof(size_t);
+    }
+    return bytes + this->addedCapacity * sizeof(size_t);
+}
+
+void ColumnIndex::build_() {
+    delete[] this->heads;
+    delete[] this->next;
+    delete[] this->rows;
+    delete[] this->added;
+    this->heads = nullptr;
+    this->next = nullptr;
+    this->rows = nullptr;
+    this->added = nullptr;
+    this->addedCapacity = 0;
+    this->numBuckets = 0;
+    this->numSorted = 0;
+    this->numAdded = 0;
+    this->stale = false;
+    size_t numRows = this->df->nrows();
+    this->numRows = numRows;
+    // room for a quarter more rows before the arrays grow
+    this->capacity = numRows + numRows / 4 + 16;
+    size_t numThreads = numRows < PARALLEL_SORT_ROWS ? 1 : this->numThreads;
+
+    if (this->type == IndexType::SORTED) {
+        // the rows by value, less the ones of no value to compare
+        size_t col = this->col;
+        bool ascending = true;
+        SortBy sort(this->df, &col, &ascending, 1);
+        size_t* sorted = sort.permutation();
+        this->rows = new size_t[this->capacity];
+        for (size_t i = 0; i < numRows; i++) {
+            if (this->comparable_(sorted[i])) {
+                this->rows[this->numSorted++] = sorted[i];
+            }
+        }
+        delete[] sorted;
+        return;
+    }
+
+    // 0. the bucket of every row, by a range of rows per thread, and the
+    // number of rows of every thread in the share of the buckets of every
+    // thread
+    this->numBuckets = 1;
+    while (this->numBuckets < this->capacity) {
+        this->numBuckets *= 2;
+    }
+    this->heads = new size_t[this->numBuckets];
+    this->next = new size_t[this->capacity];
+    size_t numBuckets = this->numBuckets;
+    size_t* buckets = new size_t[numRows];
+    size_t* counts = new size_t[numThreads * numThreads]();
+    this->df->pmap_ranges(numThreads, [this, buckets, counts, numThreads,
+                                       numBuckets](size_t thread, size_t begin,
+                                                   size_t end) {
+        size_t* threadCounts = counts + thread * numThreads;
+        for (size_t row = begin; row < end; row++) {
+            if (!this->comparable_(row)) {
+                buckets[row] = SIZE_MAX;
+                continue;
+            }
+            buckets[row] = this->hash_(row) & (numBuckets - 1);
+            threadCounts[share(buckets[row], numThreads, numBuckets)]++;
+        }
+    });
+
+    // 1. the rows partitioned by share, in order: the rows of a share by
+    // the first thread, then by the second one and so on
+    size_t* offsets = new size_t[numThreads * numThreads];
+    size_t* shareStarts = new size_t[numThreads + 1];
+    size_t offset = 0;
+    for (size_t owner = 0; owner < numThreads; owner++) {
+        shareStarts[owner] = offset;
+        for (size_t thread = 0; thread < numThreads; thread++) {
+            offsets[thread * numThreads + owner] = offset;
+            offset += counts[thread * numThreads + owner];
+        }
+    }
+    shareStarts[numThreads] = offset;
+    size_t* partitioned = new size_t[offset];
+    this->df->pmap_ranges(numThreads, [buckets, offsets, partitioned,
+                                       numThreads, numBuckets](
+                                          size_t thread, size_t begin,
+                                          size_t end) {
+        size_t* threadOffsets = offsets + thread * numThreads;
+        for (size_t row = begin; row < end; row++) {
+            if (buckets[row] != SIZE_MAX) {
+                size_t owner = share(buckets[row], numThreads, numBuckets);
+                partitioned[threadOffsets[owner]++] = row;
+            }
+        }
+    });
+
+    // 2. the rows of the share of the buckets of every thread chained, so
+    // the rows of a bucket are chained in order
+    this->df->pmap_ranges(numThreads, [this, buckets, shareStarts,
+                                       partitioned, numThreads,
+                                       numBuckets](size_t thread, size_t,
+                                                   size_t) {
+        size_t first = thread * numBuckets / numThreads;
+        size_t last = (thread + 1) * numBuckets / numThreads;
+        for (size_t bucket = first; bucket < last; bucket++) {
+            this->heads[bucket] = SIZE_MAX;
+        }
+        for (size_t i = shareStarts[thread]; i < shareStarts[thread + 1];
+             i++) {
+            size_t row = partitioned[i];
+            this->next[row] = this->heads[buckets[row]];
+            this->heads[buckets[row]] = row;
+        }
+    });
+    delete[] partitioned;
+    delete[] shareStarts;
+    delete[] offsets;
+    delete[] counts;
+    delete[] buckets;
+}
+
+void ColumnIndex::add_(size_t row) {
+    assert(row == this->numRows);
+    if (row == this->capacity) {
+        size_t capacity = this->capacity * 2;
+        if (this->type == IndexType::HASH) {
+            // the table grows with the rows, so it is built again
+            this->build_();
+            return;
+        }
+        size_t* rows = new size_t[capacity];
+        memcpy(rows, this->rows, this->numSorted * sizeof(size_t));
+        delete[] this->rows;
+        this->rows = rows;
+        this->capacity = capacity;
+    }
+    this->numRows++;
+    if (!this->comparable_(row)) {
+        return;
+    }
+    if (this->type == IndexType::HASH) {
+        size_t bucket = this->hash_(row) & (this->numBuckets - 1);
+        this->next[row] = this->heads[bucket];
+        this->heads[bucket] = row;
+        return;
+    }
+    // set aside until the next lookup
+    if (this->numAdded == this->addedCapacity) {
+        size_t capacity = this->addedCapacity * 2 + 16;
+        size_t* added = new size_t[capacity];
+        if (this->numAdded > 0) {
+            memcpy(added, this->added, this->numAdded * sizeof(size_t));
+        }
+        delete[] this->added;
+        this->added = added;
+        this->addedCapacity = capacity;
+    }
+    this->added[this->numAdded++] = row;
+}
+
+void ColumnIndex::merge_() {
+    if (this->numAdded == 0) {
+        return;
+    }
+    // 0. the added rows by value, the ones of equal values in order
+    Column* column = this->df->columns->get(this->col);
+    size_t col = this->col;
+    bool ascending = true;
+    SortBy sort(this->df, &col, &ascending, 1);
+    size_t* buffer = new size_t[this->numAdded];
+    if (column->get_type() == ColType::STRING) {
+        sort.merge_sort_(column, true, this->added, buffer, this->numAdded);
+    } else {
+        sort.radix_sort_(column, true, this->added, buffer, this->numAdded);
+    }
+    delete[] buffer;
+
+    // 1. merged from the back, after every sorted row of an equal value
+    size_t sorted = this->numSorted;
+    size_t added = this->numAdded;
+    size_t position = sorted + added;
+    while (added > 0) {
+        if (sorted > 0 &&
+            this->compare_(this->rows[sorted - 1], this->added[added - 1]) >
+                0) {
+            this->rows[--position] = this->rows[--sorted];
+        } else {
+            this->rows[--position] = this->added[--added];
+        }
+    }
+    this->numSorted += this->numAdded;
+    this->numAdded = 0;
+}
+
+uint64_t ColumnIndex::hash_(size_t row) {
+    Column* column = this->df->columns->get(this->col);
+    switch (column->get_type()) {
+        case ColType::INTEGER:
+            return hash_number(column->as_int()->array->array[row]);
+        case ColType::DOUBLE:
+            return hash_number(column->as_double()->array->array[row]);
+        case ColType::BOOLEAN:
+            return hash_number(column->as_bool()->array->array[row]);
+        default: {
+            String* value = column->get_string(row);
+            return value == nullptr ? 0 : hash_chars(value->c_str(),
+                                                     value->size());
+        }
+    }
+}
+
+bool ColumnIndex::comparable_(size_t row) {
+    Column* column = this->df->columns->get(this->col);
+    switch (column->get_type()) {
+        case ColType::DOUBLE: {
+            double value = column->as_double()->array->array[row];
+            return value == value;
+        }
+        case ColType::STRING:
+            return column->get_string(row) != nullptr;
+        default:
+            return true;
+    }
+}
+
+int ColumnIndex::compare_(size_t row, size_t other) {
+    Column* column = this->df->columns->get(this->col);
+    switch (column->get_type()) {
+        case ColType::INTEGER: {
+            const int* values = column->as_int()->array->array;
+            return (values[row] > values[other]) -
+                   (values[row] < values[other]);
+        }
+        case ColType::DOUBLE: {
+            const double* values = column->as_double()->array->array;
+            return (values[row] > values[other]) -
+                   (values[row] < values[other]);
+        }
+        case ColType::BOOLEAN: {
+            const bool* values = column->as_bool()->array->array;
+            return (values[row] > values[other]) -
+                   (values[row] < values[other]);
+        }
+        default: {
+            String* value = column->get_string(row);
+            String* otherValue = column->get_string(other);
+            size_t length = value->size() < otherValue->size()
+                                ? value->size()
+                                : otherValue->size();
+            int order = memcmp(value->c_str(), otherValue->c_str(), length);
+            if (order != 0) {
+                return order;
+            }
+            return (value->size() > otherValue->size()) -
+                   (value->size() < otherValue->size());
+        }
+    }
+}
+
+size_t ColumnIndex::partition_(Condition* condition, CompareOp op,
+                               bool passes) {
+    Column* column = this->df->columns->get(this->col);
+    // the check is run with the operator given, then restored
+    CompareOp original = condition->op;
+    condition->op = op;
+    size_t low = 0;
+    size_t high = this->numSorted;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        size_t row = this->rows[middle];
+        if ((condition->select(column, &row, 1) == 1) == passes) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+    condition->op = original;
+    return low;
+}
@@ -1,9 +1,12 @@
 #include "../../../include/eau2/dataframe/columns/bool_column.h"
 
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 
 #include "../../../include/eau2/dataframe/visitors/visitor.h"
+#include "../../../include/eau2/dataframe/zone_map.h"
+#include "../../../include/eau2/sorer/helpers.h"
 
 BoolColumn::BoolColumn() : Column(ColType::BOOLEAN) {
     this->array = new BoolArray();
@@ -24,6 +27,9 @@ Object* BoolColumn::clone() {
 void BoolColumn::set_bool(size_t idx, bool val) {
     assert(idx < this->numElements);
     this->array->set(idx, val);
+    if (this->zones != nullptr) {
+        this->zones->widen(idx, val);
+    }
 }
 
 bool BoolColumn::get_bool(size_t idx) {
@@ -36,11 +42,43 @@ void BoolColumn::push_back(bool val) {
     this->numElements++;
 }
 
-void BoolColumn::push_nullptr() { this->array->append(null_bool); }
+void BoolColumn::push_nullptr() {
+    this->array->append(null_bool);
+    this->numElements++;
+}
+
+void BoolColumn::extend(Column* other) {
+    BoolColumn* column = other->as_bool();
+    this->array->append_all(column->array->array,
+                            column->array->elementsInserted);
+    this->numElements += column->numElements;
+    column->array->elementsInserted = 0;
+    column->array->currentPosition = 0;
+    column->numElements = 0;
+    column->trim_zones_();
+}
+
+Column* BoolColumn::gather(const size_t* indices, size_t size) {
+    BoolColumn* column = new BoolColumn();
+    if (size == 0) {
+        return column;
+    }
+    BoolArray* array = column->array;
+    array->_ensure_size(size);
+    for (size_t i = 0; i < size; i++) {
+        array->array[i] = indices[i] == SIZE_MAX
+                              ? this->null_bool
+                              : this->array->array[indices[i]];
+    }
+    array->elementsInserted = array->currentPosition = size;
+    column->numElements = size;
+    return column;
+}
 
 void BoolColumn::push_back(char* c) {
     if (c == nullptr) {
         this->push_nullptr();
+        return;
     }
     bool b;
     if (*c == '0') {
@@ -51,6 +89,27 @@ void BoolColumn::push_back(char* c) {
     this->push_back(b);
 }
 
+bool BoolColumn::push_back(const char* c, size_t len) {
+    if (c == nullptr) {
+        this->push_nullptr();
+        return true;
+    }
+    bool value;
+    if (!parse_bool(c, len, &value)) {
+        return false;
+    }
+    this->push_back(value);
+    return true;
+}
+
+void BoolColumn::pop_back() {
+    assert(this->numElements > 0);
+    this->array->elementsInserted--;
+    this->array->currentPosition--;
+    this->numElements--;
+    this->trim_zones_();
+}
+
 char* BoolColumn::get_char(size_t index) {
     if (index >= this->numElements) {
         return const_cast<char*>("0");
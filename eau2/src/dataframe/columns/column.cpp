@@ -1,12 +1,15 @@
 #include "../../../include/eau2/dataframe/columns/column.h"
 
 #include <cassert>
+#include <cstring>
 
 #include "../../../include/eau2/dataframe/visitors/visitor.h"
+#include "../../../include/eau2/dataframe/zone_map.h"
 
 Column::Column(ColType colType) : Object() {
     this->colType = colType;
     this->numElements = 0;
+    this->zones = nullptr;
 }
 
 void Column::push_back(int val) { assert(false); }
@@ -19,8 +22,34 @@ void Column::push_back(String* val) { assert(false); }
 
 void Column::push_back(char* val) { assert(false); }
 
+bool Column::push_back(const char* val, size_t len) {
+    if (val == nullptr) {
+        this->push_nullptr();
+        return true;
+    }
+    if (!this->can_add(val, len)) {
+        return false;
+    }
+    // columns without an in place parser get a terminated copy
+    char* copy = new char[len + 1];
+    memcpy(copy, val, len);
+    copy[len] = '\0';
+    this->push_back(copy);
+    delete[] copy;
+    return true;
+}
+
+void Column::pop_back() { assert(false); }
+
 void Column::push_nullptr() { assert(false); }
 
+void Column::extend(Column* other) { assert(false); }
+
+Column* Column::gather(const size_t* indices, size_t size) {
+    assert(false);
+    return nullptr;
+}
+
 size_t Column::size() { return this->numElements; }
 
 void Column::set_int(size_t index, int value) { assert(false); }
@@ -46,6 +75,13 @@ bool Column::can_add(char* c) {
     return infer_type(c) <= get_type();
 }
 
+bool Column::can_add(const char* c, size_t len) {
+    if (c == nullptr) {
+        return true;
+    }
+    return type_order(infer_type(c, len)) <= type_order(get_type());
+}
+
 char Column::get_type_char() { return static_cast<char>(this->colType); }
 
 ColType Column::get_type() { return this->colType; }
@@ -68,4 +104,18 @@ StringColumn* Column::as_string() {
     assert(false);
 }
 
-Column::~Column() {}
+ZoneMap* Column::zone_map() {
+    if (this->zones == nullptr) {
+        this->zones = new ZoneMap(this->colType);
+    }
+    this->zones->extend(this);
+    return this->zones;
+}
+
+void Column::trim_zones_() {
+    if (this->zones != nullptr) {
+        this->zones->truncate(this->numElements);
+    }
+}
+
+Column::~Column() { delete this->zones; }
@@ -1,9 +1,12 @@
 #include "../../../include/eau2/dataframe/columns/double_column.h"
 
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 
 #include "../../../include/eau2/dataframe/visitors/visitor.h"
+#include "../../../include/eau2/dataframe/zone_map.h"
+#include "../../../include/eau2/sorer/helpers.h"
 
 DoubleColumn::DoubleColumn() : Column(ColType::DOUBLE) {
     this->array = new DoubleArray();
@@ -25,6 +28,9 @@ Object* DoubleColumn::clone() {
 void DoubleColumn::set_double(size_t idx, double val) {
     assert(idx < this->numElements);
     this->array->set(idx, val);
+    if (this->zones != nullptr) {
+        this->zones->widen(idx, val);
+    }
 }
 
 double DoubleColumn::get_double(size_t idx) {
@@ -37,15 +43,69 @@ void DoubleColumn::push_back(double val) {
     this->numElements++;
 }
 
-void DoubleColumn::push_nullptr() { this->array->append(null_double); }
+void DoubleColumn::push_nullptr() {
+    this->array->append(null_double);
+    this->numElements++;
+}
+
+void DoubleColumn::extend(Column* other) {
+    DoubleColumn* column = other->as_double();
+    this->array->append_all(column->array->array,
+                            column->array->elementsInserted);
+    this->numElements += column->numElements;
+    column->array->elementsInserted = 0;
+    column->array->currentPosition = 0;
+    column->numElements = 0;
+    column->trim_zones_();
+}
+
+Column* DoubleColumn::gather(const size_t* indices, size_t size) {
+    DoubleColumn* column = new DoubleColumn();
+    if (size == 0) {
+        return column;
+    }
+    DoubleArray* array = column->array;
+    array->_ensure_size(size);
+    for (size_t i = 0; i < size; i++) {
+        array->array[i] = indices[i] == SIZE_MAX
+                              ? this->null_double
+                              : this->array->array[indices[i]];
+    }
+    array->elementsInserted = array->currentPosition = size;
+    column->numElements = size;
+    return column;
+}
 
 void DoubleColumn::push_back(char* c) {
     if (c == nullptr) {
         this->push_nullptr();
+        return;
     }
     this->push_back(atof(c));
 }
 
+bool DoubleColumn::push_back(const char* c, size_t len) {
+    if (c == nullptr) {
+        this->push_nullptr();
+        return true;
+    }
+    // bools and integers are doubles too, parse_double accepts them
+    double value;
+    if (!parse_double(c, len, &value)) {
+        return false;
+    }
+    this->push_back(value);
+    return true;
+}
+
+void DoubleColumn::pop_back() {
+    assert(this->numElements > 0);
+    this->array->elementsInserted--;
+    this->array->currentPosition--;
+    this->numElements--;
+    this->trim_zones_();
+}
+
 char* DoubleColumn::get_char(size_t index) {
     if (index >= this->numElements) {
         return const_cast<char*>("0");
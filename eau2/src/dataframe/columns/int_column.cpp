@@ -1,9 +1,12 @@
 #include "../../../include/eau2/dataframe/columns/int_column.h"
 
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 
 #include "../../../include/eau2/dataframe/visitors/visitor.h"
+#include "../../../include/eau2/dataframe/zone_map.h"
+#include "../../../include/eau2/sorer/helpers.h"
 
 IntColumn::IntColumn() : Column(ColType::INTEGER) {
     this->array = new IntArray();
@@ -24,6 +27,9 @@ Object* IntColumn::clone() {
 void IntColumn::set_int(size_t index, int val) {
     assert(index < this->numElements);
     this->array->set(index, val);
+    if (this->zones != nullptr) {
+        this->zones->widen(index, val);
+    }
 }
 
 int IntColumn::get_int(size_t idx) {
@@ -36,15 +42,69 @@ void IntColumn::push_back(int val) {
     this->numElements++;
 }
 
-void IntColumn::push_nullptr() { this->array->append(null_int); }
+void IntColumn::push_nullptr() {
+    this->array->append(null_int);
+    this->numElements++;
+}
+
+void IntColumn::extend(Column* other) {
+    IntColumn* column = other->as_int();
+    this->array->append_all(column->array->array,
+                            column->array->elementsInserted);
+    this->numElements += column->numElements;
+    column->array->elementsInserted = 0;
+    column->array->currentPosition = 0;
+    column->numElements = 0;
+    column->trim_zones_();
+}
+
+Column* IntColumn::gather(const size_t* indices, size_t size) {
+    IntColumn* column = new IntColumn();
+    if (size == 0) {
+        return column;
+    }
+    IntArray* array = column->array;
+    array->_ensure_size(size);
+    for (size_t i = 0; i < size; i++) {
+        array->array[i] = indices[i] == SIZE_MAX
+                              ? this->null_int
+                              : this->array->array[indices[i]];
+    }
+    array->elementsInserted = array->currentPosition = size;
+    column->numElements = size;
+    return column;
+}
 
 void IntColumn::push_back(char* c) {
     if (c == nullptr) {
         this->push_nullptr();
+        return;
     }
     this->push_back(atoi(c));
 }
 
+bool IntColumn::push_back(const char* c, size_t len) {
+    if (c == nullptr) {
+        this->push_nullptr();
+        return true;
+    }
+    // bools are integers too, parse_int accepts them
+    int value;
+    if (!parse_int(c, len, &value)) {
+        return false;
+    }
+    this->push_back(value);
+    return true;
+}
+
+void IntColumn::pop_back() {
+    assert(this->numElements > 0);
+    this->array->elementsInserted--;
+    this->array->currentPosition--;
+    this->numElements--;
+    this->trim_zones_();
+}
+
 char* IntColumn::get_char(size_t index) {
     if (index >= this->numElements) {
         return const_cast<char*>("0");
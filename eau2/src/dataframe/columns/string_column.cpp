@@ -1,8 +1,10 @@
 #include "../../../include/eau2/dataframe/columns/string_column.h"
 
 #include <cassert>
+#include <cstdint>
 
 #include "../../../include/eau2/dataframe/visitors/visitor.h"
+#include "../../../include/eau2/dataframe/zone_map.h"
 
 StringColumn::StringColumn() : Column(ColType::STRING) {
     this->array = new Array();
@@ -20,6 +22,10 @@ StringColumn::StringColumn(String** array, size_t size)
 Object* StringColumn::clone() {
     StringColumn* newCol = new StringColumn();
     for (size_t index = 0; index < this->numElements; index++) {
+        if (this->array->array[index] == nullptr) {
+            newCol->push_nullptr();
+            continue;
+        }
         newCol->push_back(
             dynamic_cast<String*>(this->array->array[index]->clone()));
     }
@@ -28,6 +34,10 @@ Object* StringColumn::clone() {
 
 void StringColumn::set_string(size_t idx, String* val) {
     assert(idx < this->numElements);
+    if (this->zones != nullptr) {
+        this->zones->set_missing(idx, this->array->array[idx] == nullptr,
+                                 val == nullptr);
+    }
     this->array->set(idx, val);
 }
 
@@ -41,15 +51,64 @@ void StringColumn::push_back(String* val) {
     this->numElements++;
 }
 
-void StringColumn::push_nullptr() { this->array->append(nullptr); }
+void StringColumn::push_nullptr() {
+    this->array->append(nullptr);
+    this->numElements++;
+}
+
+void StringColumn::extend(Column* other) {
+    StringColumn* column = other->as_string();
+    this->array->append_all(column->array->array,
+                            column->array->elementsInserted);
+    this->numElements += column->numElements;
+    // the strings are moved, the other column must not delete them
+    column->array->elementsInserted = 0;
+    column->array->currentPosition = 0;
+    column->numElements = 0;
+    column->trim_zones_();
+}
+
+Column* StringColumn::gather(const size_t* indices, size_t size) {
+    StringColumn* column = new StringColumn();
+    for (size_t i = 0; i < size; i++) {
+        Object* value =
+            indices[i] == SIZE_MAX ? nullptr : this->array->array[indices[i]];
+        if (value == nullptr) {
+            column->push_nullptr();
+        } else {
+            column->push_back(dynamic_cast<String*>(value->clone()));
+        }
+    }
+    return column;
+}
 
 void StringColumn::push_back(char* c) {
     if (c == nullptr) {
         this->push_nullptr();
+        return;
     }
     this->push_back(new String(c));
 }
 
+bool StringColumn::push_back(const char* c, size_t len) {
+    if (c == nullptr) {
+        this->push_nullptr();
+        return true;
+    }
+    // any value is a string
+    this->push_back(new String(c, len));
+    return true;
+}
+
+void StringColumn::pop_back() {
+    assert(this->numElements > 0);
+    this->array->elementsInserted--;
+    this->array->currentPosition--;
+    this->numElements--;
+    delete this->array->array[this->array->currentPosition];
+    this->trim_zones_();
+}
+
 char* StringColumn::get_char(size_t index) {
     if (index >= this->numElements || this->array->get(index) == nullptr) {
         return nullptr;
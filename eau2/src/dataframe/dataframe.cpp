@@ -8,18 +8,24 @@
 #include "../../include/eau2/serialization/deserializer.h"
 #include "../../include/eau2/serialization/serializer.h"
 #include "../../include/eau2/dataframe/handle_rower_thread.h"
+#include "../../include/eau2/dataframe/rowers/quantile_rower.h"
+#include "../../include/eau2/dataframe/rowers/top_k_rower.h"
 #include "../../include/eau2/dataframe/visitors/add_row_visitor.h"
 #include "../../include/eau2/dataframe/visitors/fill_row_visitor.h"
 
 DataFrame::DataFrame(DataFrame& df) {
     this->schema = new Schema(*(df.schema));
     this->schema->numRows = 0;
+    this->indexes = nullptr;
+    this->numIndexes = 0;
     this->initColumns();
 }
 
 DataFrame::DataFrame(Schema& schema) {
     this->schema = new Schema(schema);
     this->schema->numRows = 0;
+    this->indexes = nullptr;
+    this->numIndexes = 0;
     this->initColumns();
 }
 
@@ -221,9 +227,8 @@ DataFrame* DataFrame::from_string_array(String** array, size_t size) {
 }
 
 DataFrame* DataFrame::fromBytes(byte* bytes) {
-    Headers header;
     size_t size;
-    memcpy(&header, bytes, sizeof(Headers));
+    Headers header = Deserializer::get_header(bytes);
     switch (header) {
         case Headers::INT: {
             int val = Deserializer::deserialize_int(bytes);
@@ -389,6 +394,11 @@ void DataFrame::add_column(Column* col) {
     this->schema->add_column(static_cast<char>(col->get_type()));
 }
 
+void DataFrame::add_computed(Expr* expr) {
+    assert(expr != nullptr);
+    this->add_column(expr->evaluate(this));
+}
+
 int DataFrame::get_int(size_t col, size_t row) {
     assert(col < this->schema->numCols);
     assert(row < this->schema->numRows);
@@ -419,7 +429,8 @@ double DataFrame::get_double(size_t col, size_t row) {
 String* DataFrame::get_string(size_t col, size_t row) {
     assert(col < this->schema->numCols);
     assert(row < this->schema->numRows);
-    assert(this->schema->col_type(col) == STRING);
+    assert(static_cast<ColType>(this->schema->col_type(col)) ==
+           ColType::STRING);
     StringColumn* stringColumn = this->columns->get(col)->as_string();
     return stringColumn->get_string(row);
 }
@@ -431,6 +442,9 @@ void DataFrame::set(size_t col, size_t row, int val) {
            ColType::INTEGER);
     IntColumn* intColumn = this->columns->get(col)->as_int();
     intColumn->set_int(row, val);
+    if (this->get_index(col) != nullptr) {
+        this->indexes[col]->invalidate();
+    }
 }
 
 void DataFrame::set(size_t col, size_t row, bool val) {
@@ -440,6 +454,9 @@ void DataFrame::set(size_t col, size_t row, bool val) {
            ColType::BOOLEAN);
     BoolColumn* boolColumn = this->columns->get(col)->as_bool();
     boolColumn->set_bool(row, val);
+    if (this->get_index(col) != nullptr) {
+        this->indexes[col]->invalidate();
+    }
 }
 
 void DataFrame::set(size_t col, size_t row, double val) {
@@ -449,6 +466,9 @@ void DataFrame::set(size_t col, size_t row, double val) {
            ColType::DOUBLE);
     DoubleColumn* doubleColumn = this->columns->get(col)->as_double();
     doubleColumn->set_double(row, val);
+    if (this->get_index(col) != nullptr) {
+        this->indexes[col]->invalidate();
+    }
 }
 
 void DataFrame::set(size_t col, size_t row, String* val) {
@@ -458,6 +478,9 @@ void DataFrame::set(size_t col, size_t row, String* val) {
            ColType::STRING);
     StringColumn* stringColumn = this->columns->get(col)->as_string();
     stringColumn->set_string(row, val);
+    if (this->get_index(col) != nullptr) {
+        this->indexes[col]->invalidate();
+    }
 }
 
 void DataFrame::fill_row(size_t idx, Row& row) {
@@ -493,6 +516,13 @@ void DataFrame::add_row(Row& row) {
     this->schema->numRows++;
     row.schema->numRows++;
     row.rowIndex++;
+
+    // index the new row
+    for (size_t col = 0; col < this->numIndexes; col++) {
+        if (this->indexes[col] != nullptr) {
+            this->indexes[col]->extend();
+        }
+    }
 }
 
 size_t DataFrame::nrows() { return this->schema->numRows; }
@@ -556,21 +586,188 @@ DataFrame* DataFrame::filter(Rower& r) {
     // create new data frame
     DataFrame* newDataFrame = new DataFrame(*this);
 
+    // the row the values of every row are copied to
+    Row row = Row(*this->schema);
+
     // traverse through each row and if given Rower returns true,
     // add it to the new DataFrame.
     // The true/false value is determined by implementation of
     // the specific rower.
-    for (size_t rowIndex = 0; this->schema->numRows; rowIndex++) {
-        Row row = Row(this->columns, rowIndex);
-        if (r.accept(row)) {
-            newDataFrame->add_row(row);
+    for (size_t rowIndex = 0; rowIndex < this->schema->numRows; rowIndex++) {
+        for (size_t col = 0; col < this->schema->numCols; col++) {
+            switch (static_cast<ColType>(this->schema->col_type(col))) {
+                case ColType::INTEGER:
+                    row.set(col, this->get_int(col, rowIndex));
+                    break;
+                case ColType::DOUBLE:
+                    row.set(col, this->get_double(col, rowIndex));
+                    break;
+                case ColType::BOOLEAN:
+                    row.set(col, this->get_bool(col, rowIndex));
+                    break;
+                default:
+                    row.set(col, this->get_string(col, rowIndex));
+                    break;
+            }
+        }
+        if (!r.accept(row)) {
+            continue;
         }
+        for (size_t col = 0; col < this->schema->numCols; col++) {
+            Column* column = newDataFrame->columns->get(col);
+            switch (static_cast<ColType>(this->schema->col_type(col))) {
+                case ColType::INTEGER:
+                    column->push_back(row.get_int(col));
+                    break;
+                case ColType::DOUBLE:
+                    column->push_back(row.get_double(col));
+                    break;
+                case ColType::BOOLEAN:
+                    column->push_back(row.get_bool(col));
+                    break;
+                default: {
+                    // the new data frame owns copies of the strings
+                    String* value = row.get_string(col);
+                    if (value == nullptr) {
+                        column->push_nullptr();
+                    } else {
+                        column->push_back(
+                            dynamic_cast<String*>(value->clone()));
+                    }
+                    break;
+                }
+            }
+        }
+        newDataFrame->schema->numRows++;
     }
 
     return newDataFrame;
 }
 
+DataFrame* DataFrame::filter(Expr* predicate) {
+    assert(predicate != nullptr);
+    ColType type = predicate->bind(this);
+    assert(type == ColType::BOOLEAN);
+    size_t numRows = this->nrows();
+    size_t* rows = new size_t[numRows];
+    for (size_t row = 0; row < numRows; row++) {
+        rows[row] = row;
+    }
+    size_t numKept = predicate->select(0, numRows, rows, numRows);
+    DataFrame* result = this->gather(rows, numKept);
+    delete[] rows;
+    return result;
+}
+
+DataFrame* DataFrame::filter(Condition* condition) {
+    assert(condition != nullptr && condition->column < this->ncols());
+    ColumnIndex* index = this->get_index(condition->column);
+    if (index == nullptr || !index->supports(condition)) {
+        Query query(this);
+        return query.filter(condition)->run();
+    }
+    // rows pushed to the column directly are indexed first
+    index->extend();
+    size_t numRows;
+    size_t* rows = index->lookup(condition, &numRows);
+    DataFrame* result = this->gather(rows, numRows);
+    delete[] rows;
+    delete condition;
+    return result;
+}
+
+void DataFrame::create_index(size_t col, IndexType type) {
+    assert(col < this->ncols());
+    if (col >= this->numIndexes) {
+        // room for every column, added after the last index
+        size_t numIndexes = this->ncols();
+        ColumnIndex** indexes = new ColumnIndex*[numIndexes];
+        for (size_t i = 0; i < numIndexes; i++) {
+            indexes[i] = i < this->numIndexes ? this->indexes[i] : nullptr;
+        }
+        delete[] this->indexes;
+        this->indexes = indexes;
+        this->numIndexes = numIndexes;
+    }
+    delete this->indexes[col];
+    this->indexes[col] = new ColumnIndex(this, col, type);
+}
+
+void DataFrame::drop_index(size_t col) {
+    if (this->get_index(col) != nullptr) {
+        delete this->indexes[col];
+        this->indexes[col] = nullptr;
+    }
+}
+
+ColumnIndex* DataFrame::get_index(size_t col) {
+    return col < this->numIndexes ? this->indexes[col] : nullptr;
+}
+
+size_t DataFrame::index_bytes() {
+    size_t bytes = 0;
+    for (size_t col = 0; col < this->numIndexes; col++) {
+        if (this->indexes[col] != nullptr) {
+            bytes += this->indexes[col]->memory_bytes();
+        }
+    }
+    return bytes;
+}
+
+GroupBy* DataFrame::group_by(const size_t* keys, size_t numKeys) {
+    return new GroupBy(this, keys, numKeys);
+}
+
+DataFrame* DataFrame::join(DataFrame* other, const size_t* keys,
+                           const size_t* otherKeys, size_t numKeys,
+                           JoinType type) {
+    HashJoin join(this, other, keys, otherKeys, numKeys, type);
+    return join.run();
+}
+
+DataFrame* DataFrame::sort_by(const size_t* cols, const bool* ascending,
+                              size_t numCols) {
+    SortBy sort(this, cols, ascending, numCols);
+    return sort.run();
+}
+
+DataFrame* DataFrame::gather(const size_t* rows, size_t numRows) {
+    DataFrame* result = new DataFrame(*this->schema);
+    for (size_t col = 0; col < this->ncols(); col++) {
+        Column* column = this->columns->get(col)->gather(rows, numRows);
+        delete result->columns->set(col, column);
+    }
+    result->schema->numRows = numRows;
+    return result;
+}
+
+DataFrame* DataFrame::top_k(size_t col, size_t k) {
+    assert(col < this->ncols());
+    TopKRower rower(col, k);
+    this->pmap(rower);
+    size_t* rows = rower.sorted_rows();
+    DataFrame* result = this->gather(rows, rower.size);
+    delete[] rows;
+    return result;
+}
+
+QuantileSketch* DataFrame::quantile_sketch(size_t col, size_t k) {
+    assert(col < this->ncols());
+    QuantileRower rower(col, k);
+    this->pmap(rower);
+    QuantileSketch* sketch = rower.sketch;
+    // the sketch now belongs to the caller
+    rower.sketch = nullptr;
+    return sketch;
+}
+
+Query* DataFrame::query() { return new Query(this); }
+
 DataFrame::~DataFrame() {
+    for (size_t col = 0; col < this->numIndexes; col++) {
+        delete this->indexes[col];
+    }
+    delete[] this->indexes;
     delete this->schema;
     delete this->columns;
 }
@@ -0,0 +1,528 @@
+#include "../../include/eau2/dataframe/expr.h"
+
+#include <cassert>
+#include <climits>
+#include <cstring>
+
+#include "../../include/eau2/dataframe/columns/bool_column.h"
+#include "../../include/eau2/dataframe/columns/double_column.h"
+#include "../../include/eau2/dataframe/columns/int_column.h"
+#include "../../include/eau2/dataframe/dataframe.h"
+
+// the bytes of a value of the given type
+static size_t value_size(ColType type) {
+    switch (type) {
+        case ColType::INTEGER:
+            return sizeof(int);
+        case ColType::DOUBLE:
+            return sizeof(double);
+        default:
+            return sizeof(bool);
+    }
+}
+
+// the sum, difference and product of two ints, computed as unsigned ints
+// so they wrap around instead of overflowing
+static int add(int left, int right) {
+    return static_cast<int>(static_cast<unsigned int>(left) +
+                            static_cast<unsigned int>(right));
+}
+
+static int subtract(int left, int right) {
+    return static_cast<int>(static_cast<unsigned int>(left) -
+                            static_cast<unsigned int>(right));
+}
+
+static int multiply(int left, int right) {
+    return static_cast<int>(static_cast<unsigned int>(left) *
+                            static_cast<unsigned int>(right));
+}
+
+static double add(double left, double right) { return left + right; }
+
+static double subtract(double left, double right) { return left - right; }
+
+static double multiply(double left, double right) { return left * right; }
+
+// the quotient of two ints, 0 when divided by zero
+static int divide(int dividend, int divisor) {
+    if (divisor == 0) {
+        return 0;
+    }
+    // -INT_MIN overflows
+    if (divisor == -1) {
+        return static_cast<int>(0u - static_cast<unsigned int>(dividend));
+    }
+    return dividend / divisor;
+}
+
+static double divide(double dividend, double divisor) {
+    return dividend / divisor;
+}
+
+template <typename T>
+static void arithmetic(ExprOp op, const T* left, const T* right, T* out,
+                       size_t size) {
+    switch (op) {
+        case ExprOp::ADD:
+            for (size_t i = 0; i < size; i++) {
+                out[i] = add(left[i], right[i]);
+            }
+            break;
+        case ExprOp::SUBTRACT:
+            for (size_t i = 0; i < size; i++) {
+                out[i] = subtract(left[i], right[i]);
+            }
+            break;
+        case ExprOp::MULTIPLY:
+            for (size_t i = 0; i < size; i++) {
+                out[i] = multiply(left[i], right[i]);
+            }
+            break;
+        default:  // ExprOp::DIVIDE
+            for (size_t i = 0; i < size; i++) {
+                out[i] = divide(left[i], right[i]);
+            }
+            break;
+    }
+}
+
+template <typename T>
+static void compare(ExprOp op, const T* left, const T* right, bool* out,
+                    size_t size) {
+    switch (op) {
+        case ExprOp::EQUAL:
+            for (size_t i = 0; i < size; i++) {
+                out[i] = left[i] == right[i];
+            }
+            break;
+        case ExprOp::NOT_EQUAL:
+            for (size_t i = 0; i < size; i++) {
+                out[i] = left[i] != right[i];
+            }
+            break;
+        case ExprOp::LESS:
+            for (size_t i = 0; i < size; i++) {
+                out[i] = left[i] < right[i];
+            }
+            break;
+        case ExprOp::LESS_EQUAL:
+            for (size_t i = 0; i < size; i++) {
+                out[i] = left[i] <= right[i];
+            }
+            break;
+        case ExprOp::GREATER:
+            for (size_t i = 0; i < size; i++) {
+                out[i] = left[i] > right[i];
+            }
+            break;
+        default:  // ExprOp::GREATER_EQUAL
+            for (size_t i = 0; i < size; i++) {
+                out[i] = left[i] >= right[i];
+            }
+            break;
+    }
+}
+
+template <typename From, typename To>
+static void convert(const From* in, To* out, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        out[i] = static_cast<To>(in[i]);
+    }
+}
+
+// a double out of the range of an int is clamped to it, and a NaN is 0
+static void convert(const double* in, int* out, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        double value = in[i];
+        if (value != value) {
+            out[i] = 0;
+        } else if (value >= static_cast<double>(INT_MAX)) {
+            out[i] = INT_MAX;
+        } else if (value <= static_cast<double>(INT_MIN)) {
+            out[i] = INT_MIN;
+        } else {
+            out[i] = static_cast<int>(value);
+        }
+    }
+}
+
+template <typename From>
+static void convert(const From* in, ColType type, void* out, size_t size) {
+    switch (type) {
+        case ColType::INTEGER:
+            convert(in, static_cast<int*>(out), size);
+            break;
+        case ColType::DOUBLE:
+            convert(in, static_cast<double*>(out), size);
+            break;
+        default:
+            convert(in, static_cast<bool*>(out), size);
+            break;
+    }
+}
+
+Expr::Expr(ExprOp op) : Object() {
+    this->op = op;
+    this->type = ColType::UNKNOWN;
+    this->left = nullptr;
+    this->right = nullptr;
+    this->column = 0;
+    this->intValue = 0;
+    this->doubleValue = 0;
+    this->boolValue = false;
+    this->source = nullptr;
+    this->buffer = nullptr;
+    this->values = nullptr;
+}
+
+Expr* Expr::col(size_t column) {
+    Expr* expr = new Expr(ExprOp::COLUMN);
+    expr->column = column;
+    return expr;
+}
+
+Expr* Expr::literal(int value) {
+    Expr* expr = new Expr(ExprOp::LITERAL);
+    expr->type = ColType::INTEGER;
+    expr->intValue = value;
+    return expr;
+}
+
+Expr* Expr::literal(double value) {
+    Expr* expr = new Expr(ExprOp::LITERAL);
+    expr->type = ColType::DOUBLE;
+    expr->doubleValue = value;
+    return expr;
+}
+
+Expr* Expr::literal(bool value) {
+    Expr* expr = new Expr(ExprOp::LITERAL);
+    expr->type = ColType::BOOLEAN;
+    expr->boolValue = value;
+    return expr;
+}
+
+Expr* Expr::binary(ExprOp op, Expr* left, Expr* right) {
+    assert(op >= ExprOp::ADD && op <= ExprOp::OR);
+    assert(left != nullptr && right != nullptr);
+    Expr* expr = new Expr(op);
+    expr->left = left;
+    expr->right = right;
+    return expr;
+}
+
+Expr* Expr::negate(Expr* operand) {
+    assert(operand != nullptr);
+    Expr* expr = new Expr(ExprOp::NOT);
+    expr->left = operand;
+    return expr;
+}
+
+Expr* Expr::cast(Expr* operand, ColType type) {
+    assert(operand != nullptr);
+    assert(type == ColType::INTEGER || type == ColType::DOUBLE ||
+           type == ColType::BOOLEAN);
+    Expr* expr = new Expr(ExprOp::CAST);
+    expr->left = operand;
+    expr->type = type;
+    return expr;
+}
+
+Expr::~Expr() {
+    delete this->left;
+    delete this->right;
+    delete[] static_cast<char*>(this->buffer);
+}
+
+Object* Expr::clone() {
+    Expr* expr = new Expr(this->op);
+    expr->type = this->type;
+    expr->left = this->left == nullptr
+                     ? nullptr
+                     : dynamic_cast<Expr*>(this->left->clone());
+    expr->right = this->right == nullptr
+                      ? nullptr
+                      : dynamic_cast<Expr*>(this->right->clone());
+    expr->column = this->column;
+    expr->intValue = this->intValue;
+    expr->doubleValue = this->doubleValue;
+    expr->boolValue = this->boolValue;
+    return expr;
+}
+
+ColType Expr::bind(DataFrame* df) {
+    assert(df != nullptr);
+    switch (this->op) {
+        case ExprOp::COLUMN:
+            assert(this->column < df->ncols());
+            this->source = df->columns->get(this->column);
+            this->type = this->source->get_type();
+            assert(this->type != ColType::STRING);
+            break;
+        case ExprOp::LITERAL:
+            break;
+        case ExprOp::CAST:
+            this->left->bind(df);
+            break;
+        case ExprOp::NOT:
+            this->left->bind(df);
+            cast_operand_(&this->left, ColType::BOOLEAN);
+            this->type = ColType::BOOLEAN;
+            break;
+        case ExprOp::AND:
+        case ExprOp::OR:
+            this->left->bind(df);
+            this->right->bind(df);
+            cast_operand_(&this->left, ColType::BOOLEAN);
+            cast_operand_(&this->right, ColType::BOOLEAN);
+            this->type = ColType::BOOLEAN;
+            break;
+        default: {
+            ColType leftType = this->left->bind(df);
+            ColType rightType = this->right->bind(df);
+            bool arithmetic = this->op <= ExprOp::DIVIDE;
+            // the operands are compared as bools only if both are bools
+            ColType operandType = ColType::INTEGER;
+            if (leftType == ColType::DOUBLE || rightType == ColType::DOUBLE) {
+                operandType = ColType::DOUBLE;
+            } else if (!arithmetic && leftType == ColType::BOOLEAN &&
+                       rightType == ColType::BOOLEAN) {
+                operandType = ColType::BOOLEAN;
+            }
+            cast_operand_(&this->left, operandType);
+            cast_operand_(&this->right, operandType);
+            this->type = arithmetic ? operandType : ColType::BOOLEAN;
+            break;
+        }
+    }
+    this->allocate_();
+    return this->type;
+}
+
+void Expr::remap(const size_t* cols) {
+    if (this->op == ExprOp::COLUMN) {
+        this->column = cols[this->column];
+    }
+    if (this->left != nullptr) {
+        this->left->remap(cols);
+    }
+    if (this->right != nullptr) {
+        this->right->remap(cols);
+    }
+}
+
+void Expr::evaluate_batch(size_t begin, size_t end) {
+    assert(begin <= end && end - begin <= EXPR_BATCH);
+    size_t size = end - begin;
+    switch (this->op) {
+        case ExprOp::COLUMN:
+            switch (this->type) {
+                case ColType::INTEGER:
+                    this->values = this->source->as_int()->array->array + begin;
+                    break;
+                case ColType::DOUBLE:
+                    this->values =
+                        this->source->as_double()->array->array + begin;
+                    break;
+                default:
+                    this->values =
+                        this->source->as_bool()->array->array + begin;
+                    break;
+            }
+            return;
+        case ExprOp::LITERAL:
+            this->values = this->buffer;
+            return;
+        case ExprOp::CAST: {
+            this->left->evaluate_batch(begin, end);
+            if (this->left->type == this->type) {
+                this->values = this->left->values;
+                return;
+            }
+            const void* in = this->left->values;
+            switch (this->left->type) {
+                case ColType::INTEGER:
+                    convert(static_cast<const int*>(in), this->type,
+                            this->buffer, size);
+                    break;
+                case ColType::DOUBLE:
+                    convert(static_cast<const double*>(in), this->type,
+                            this->buffer, size);
+                    break;
+                default:
+                    convert(static_cast<const bool*>(in), this->type,
+                            this->buffer, size);
+                    break;
+            }
+            break;
+        }
+        case ExprOp::NOT: {
+            this->left->evaluate_batch(begin, end);
+            const bool* in = static_cast<const bool*>(this->left->values);
+            bool* out = static_cast<bool*>(this->buffer);
+            for (size_t i = 0; i < size; i++) {
+                out[i] = !in[i];
+            }
+            break;
+        }
+        case ExprOp::AND:
+        case ExprOp::OR: {
+            this->left->evaluate_batch(begin, end);
+            this->right->evaluate_batch(begin, end);
+            const bool* left = static_cast<const bool*>(this->left->values);
+            const bool* right = static_cast<const bool*>(this->right->values);
+            bool* out = static_cast<bool*>(this->buffer);
+            if (this->op == ExprOp::AND) {
+                for (size_t i = 0; i < size; i++) {
+                    out[i] = left[i] & right[i];
+                }
+            } else {
+                for (size_t i = 0; i < size; i++) {
+                    out[i] = left[i] | right[i];
+                }
+            }
+            break;
+        }
+        default: {
+            this->left->evaluate_batch(begin, end);
+            this->right->evaluate_batch(begin, end);
+            const void* left = this->left->values;
+            const void* right = this->right->values;
+            if (this->op <= ExprOp::DIVIDE) {
+                if (this->type == ColType::INTEGER) {
+                    arithmetic(this->op, static_cast<const int*>(left),
+                               static_cast<const int*>(right),
+                               static_cast<int*>(this->buffer), size);
+                } else {
+                    arithmetic(this->op, static_cast<const double*>(left),
+                               static_cast<const double*>(right),
+                               static_cast<double*>(this->buffer), size);
+                }
+                break;
+            }
+            bool* out = static_cast<bool*>(this->buffer);
+            switch (this->left->type) {
+                case ColType::INTEGER:
+                    compare(this->op, static_cast<const int*>(left),
+                            static_cast<const int*>(right), out, size);
+                    break;
+                case ColType::DOUBLE:
+                    compare(this->op, static_cast<const double*>(left),
+                            static_cast<const double*>(right), out, size);
+                    break;
+                default:
+                    compare(this->op, static_cast<const bool*>(left),
+                            static_cast<const bool*>(right), out, size);
+                    break;
+            }
+            break;
+        }
+    }
+    this->values = this->buffer;
+}
+
+Column* Expr::evaluate(DataFrame* df) {
+    ColType type = this->bind(df);
+    size_t numRows = df->nrows();
+    // the values of every batch are copied to the array of the column
+    Column* column;
+    void* out = nullptr;
+    switch (type) {
+        case ColType::INTEGER: {
+            IntColumn* ints = new IntColumn();
+            if (numRows > 0) {
+                ints->array->_ensure_size(numRows);
+                ints->array->elementsInserted = numRows;
+                ints->array->currentPosition = numRows;
+            }
+            out = ints->array->array;
+            column = ints;
+            break;
+        }
+        case ColType::DOUBLE: {
+            DoubleColumn* doubles = new DoubleColumn();
+            if (numRows > 0) {
+                doubles->array->_ensure_size(numRows);
+                doubles->array->elementsInserted = numRows;
+                doubles->array->currentPosition = numRows;
+            }
+            out = doubles->array->array;
+            column = doubles;
+            break;
+        }
+        default: {
+            BoolColumn* bools = new BoolColumn();
+            if (numRows > 0) {
+                bools->array->_ensure_size(numRows);
+                bools->array->elementsInserted = numRows;
+                bools->array->currentPosition = numRows;
+            }
+            out = bools->array->array;
+            column = bools;
+            break;
+        }
+    }
+    column->numElements = numRows;
+    size_t valueSize = value_size(type);
+    for (size_t begin = 0; begin < numRows; begin += EXPR_BATCH) {
+        size_t end = begin + EXPR_BATCH < numRows ? begin + EXPR_BATCH
+                                                  : numRows;
+        this->evaluate_batch(begin, end);
+        memcpy(static_cast<char*>(out) + begin * valueSize, this->values,
+               (end - begin) * valueSize);
+    }
+    return column;
+}
+
+size_t Expr::select(size_t begin, size_t end, size_t* rows, size_t numRows) {
+    assert(this->type == ColType::BOOLEAN);
+    size_t kept = 0;
+    size_t i = 0;
+    for (size_t batch = begin; batch < end && i < numRows;
+         batch += EXPR_BATCH) {
+        size_t batchEnd = batch + EXPR_BATCH < end ? batch + EXPR_BATCH : end;
+        if (rows[i] >= batchEnd) {
+            continue;  // no row of the batch is left
+        }
+        this->evaluate_batch(batch, batchEnd);
+        const bool* values = static_cast<const bool*>(this->values);
+        for (; i < numRows && rows[i] < batchEnd; i++) {
+            size_t row = rows[i];
+            rows[kept] = row;
+            kept += values[row - batch];
+        }
+    }
+    return kept;
+}
+
+void Expr::allocate_() {
+    delete[] static_cast<char*>(this->buffer);
+    this->buffer = nullptr;
+    if (this->op == ExprOp::COLUMN) {
+        return;  // read in place
+    }
+    this->buffer = new char[EXPR_BATCH * value_size(this->type)];
+    if (this->op == ExprOp::LITERAL) {
+        for (size_t i = 0; i < EXPR_BATCH; i++) {
+            switch (this->type) {
+                case ColType::INTEGER:
+                    static_cast<int*>(this->buffer)[i] = this->intValue;
+                    break;
+                case ColType::DOUBLE:
+                    static_cast<double*>(this->buffer)[i] = this->doubleValue;
+                    break;
+                default:
+                    static_cast<bool*>(this->buffer)[i] = this->boolValue;
+                    break;
+            }
+        }
+    }
+}
+
+void Expr::cast_operand_(Expr** operand, ColType type) {
+    if ((*operand)->type != type) {
+        *operand = Expr::cast(*operand, type);
+        (*operand)->allocate_();
+    }
+}
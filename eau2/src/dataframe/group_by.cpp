@@ -0,0 +1,187 @@
+#include "../../include/eau2/dataframe/group_by.h"
+
+#include <cassert>
+#include <climits>
+#include <cstring>
+#include <thread>
+
+#include "../../include/eau2/dataframe/columns/bool_column.h"
+#include "../../include/eau2/dataframe/columns/double_column.h"
+#include "../../include/eau2/dataframe/columns/int_column.h"
+#include "../../include/eau2/dataframe/columns/string_column.h"
+#include "../../include/eau2/dataframe/dataframe.h"
+#include "../../include/eau2/dataframe/group_by_thread.h"
+#include "../../include/eau2/dataframe/group_table.h"
+
+// returns an empty column of the given type
+static Column* empty_column(ColType type) {
+    switch (type) {
+        case ColType::INTEGER:
+            return new IntColumn();
+        case ColType::DOUBLE:
+            return new DoubleColumn();
+        case ColType::BOOLEAN:
+            return new BoolColumn();
+        default:
+            return new StringColumn();
+    }
+}
+
+// returns the type of the given aggregation of a column of the given type
+static ColType agg_type(AggOp op, ColType type) {
+    switch (op) {
+        case AggOp::COUNT:
+            return ColType::INTEGER;
+        case AggOp::SUM:  // exact up to 2^53, unlike an int
+        case AggOp::MEAN:
+            return ColType::DOUBLE;
+        default:  // MIN and MAX
+            return type;
+    }
+}
+
+GroupBy::GroupBy(DataFrame* df, const size_t* keys, size_t numKeys)
+    : Object() {
+    assert(df != nullptr);
+    assert(numKeys > 0);
+    for (size_t key = 0; key < numKeys; key++) {
+        assert(keys[key] < df->ncols());
+    }
+    this->df = df;
+    this->keys = new size_t[numKeys];
+    memcpy(this->keys, keys, numKeys * sizeof(size_t));
+    this->numKeys = numKeys;
+    this->numThreads = std::thread::hardware_concurrency();
+    this->numThreads = this->numThreads > 0 ? this->numThreads : 1;
+}
+
+GroupBy::~GroupBy() { delete[] this->keys; }
+
+DataFrame* GroupBy::agg(const AggOp* ops, const size_t* cols,
+                        size_t numAggs) {
+    DataFrame* df = this->df;
+    size_t numRows = df->nrows();
+    Column** keys = new Column*[this->numKeys];
+    for (size_t key = 0; key < this->numKeys; key++) {
+        keys[key] = df->columns->get(this->keys[key]);
+    }
+    Column** values = new Column*[numAggs];
+    for (size_t agg = 0; agg < numAggs; agg++) {
+        assert(cols[agg] < df->ncols());
+        values[agg] = df->columns->get(cols[agg]);
+        assert(ops[agg] == AggOp::COUNT ||
+               values[agg]->get_type() != ColType::STRING);
+    }
+
+    // 0. initialize a table per range of rows
+    size_t numThreads = this->numThreads;
+    GroupByThread** threads = new GroupByThread*[numThreads];
+    for (size_t i = 0; i < numThreads; i++) {
+        GroupTable* table =
+            new GroupTable(keys, this->numKeys, values, ops, numAggs);
+        threads[i] = new GroupByThread(table, i * numRows / numThreads,
+                                       (i + 1) * numRows / numThreads);
+    }
+
+    // 1. aggregate the ranges
+    if (numThreads == 1) {
+        threads[0]->run();
+    } else {
+        for (size_t i = 0; i < numThreads; i++) {
+            threads[i]->start();
+        }
+        for (size_t i = 0; i < numThreads; i++) {
+            threads[i]->join();
+        }
+    }
+
+    // 2. merge the tables in order, so the groups keep their first rows
+    GroupTable* table = threads[0]->table;
+    for (size_t i = 1; i < numThreads; i++) {
+        table->merge(threads[i]->table);
+    }
+
+    // 3. one row per group, the keys and then the aggregations
+    DataFrame* result = GroupBy::to_frame(table);
+
+    for (size_t i = 0; i < numThreads; i++) {
+        delete threads[i];
+    }
+    delete[] threads;
+    delete[] keys;
+    delete[] values;
+    return result;
+}
+
+DataFrame* GroupBy::to_frame(GroupTable* table) {
+    Schema* schema = new Schema();
+    ColumnArray* columns = new ColumnArray();
+    for (size_t key = 0; key < table->numKeys; key++) {
+        Column* keys = table->keys[key];
+        ColType type = keys->get_type();
+        Column* column = empty_column(type);
+        for (size_t group = 0; group < table->numGroups; group++) {
+            size_t row = table->firstRows[group];
+            switch (type) {
+                case ColType::INTEGER:
+                    column->push_back(keys->get_int(row));
+                    break;
+                case ColType::DOUBLE:
+                    column->push_back(keys->get_double(row));
+                    break;
+                case ColType::BOOLEAN:
+                    column->push_back(keys->get_bool(row));
+                    break;
+                default: {
+                    String* value = keys->get_string(row);
+                    if (value == nullptr) {
+                        column->push_nullptr();
+                    } else {
+                        column->push_back(
+                            dynamic_cast<String*>(value->clone()));
+                    }
+                    break;
+                }
+            }
+        }
+        schema->add_col_type(type);
+        columns->append(column);
+    }
+    for (size_t agg = 0; agg < table->numAggs; agg++) {
+        AggOp op = table->ops[agg];
+        ColType type = agg_type(op, table->values[agg]->get_type());
+        Column* column = empty_column(type);
+        for (size_t group = 0; group < table->numGroups; group++) {
+            double value = table->aggregates[group * table->numAggs + agg];
+            if (op == AggOp::COUNT) {
+                assert(table->counts[group] <= INT_MAX);
+                value = table->counts[group];
+            } else if (op == AggOp::MEAN) {
+                value /= table->counts[group];
+            }
+            switch (type) {
+                case ColType::INTEGER:
+                    column->push_back(static_cast<int>(value));
+                    break;
+                case ColType::DOUBLE:
+                    column->push_back(value);
+                    break;
+                default:
+                    column->push_back(value != 0);
+                    break;
+            }
+        }
+        schema->add_col_type(type);
+        columns->append(column);
+    }
+    DataFrame* result = new DataFrame(*schema);
+    for (int col = 0; col < columns->size(); col++) {
+        delete result->columns->set(col, columns->get(col));
+    }
+    result->schema->numRows = table->numGroups;
+    // the columns now belong to the result
+    columns->elementsInserted = 0;
+    delete columns;
+    delete schema;
+    return result;
+}
@@ -0,0 +1,22 @@
+#include "../../include/eau2/dataframe/group_by_thread.h"
+
+#include <cassert>
+
+GroupByThread::GroupByThread(GroupTable *table, size_t beginRowIndex,
+                             size_t endRowIndex)
+    : Thread() {
+    assert(table != nullptr);
+    assert(beginRowIndex <= endRowIndex);
+    this->table = table;
+    this->beginRowIndex = beginRowIndex;
+    this->endRowIndex = endRowIndex;
+}
+
+GroupByThread::~GroupByThread() { delete this->table; }
+
+void GroupByThread::run() {
+    for (size_t rowIndex = this->beginRowIndex; rowIndex < this->endRowIndex;
+         rowIndex++) {
+        this->table->add_row(rowIndex);
+    }
+}
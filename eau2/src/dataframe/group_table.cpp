@@ -0,0 +1,197 @@
+#include "../../include/eau2/dataframe/group_table.h"
+
+#include <cassert>
+#include <cstring>
+#include <limits>
+
+#include "../../include/eau2/dataframe/columns/bool_column.h"
+#include "../../include/eau2/dataframe/columns/double_column.h"
+#include "../../include/eau2/dataframe/columns/int_column.h"
+#include "../../include/eau2/dataframe/row_keys.h"
+
+// the initial number of slots and groups of a table
+#define INITIAL_GROUPS 64
+
+GroupTable::GroupTable(Column** keys, size_t numKeys, Column** values,
+                       const AggOp* ops, size_t numAggs)
+    : Object() {
+    assert(keys != nullptr || numKeys == 0);
+    this->keys = keys;
+    this->numKeys = numKeys;
+    this->values = values;
+    this->ops = ops;
+    this->numAggs = numAggs;
+    this->numSlots = INITIAL_GROUPS * 2;
+    this->slots = new uint64_t[this->numSlots * 2];
+    for (size_t slot = 0; slot < this->numSlots; slot++) {
+        this->slots[slot * 2 + 1] = EMPTY_SLOT;
+    }
+    this->groupCapacity = INITIAL_GROUPS;
+    this->groupHashes = new uint64_t[this->groupCapacity];
+    this->firstRows = new size_t[this->groupCapacity];
+    this->counts = new size_t[this->groupCapacity];
+    this->aggregates = new double[this->groupCapacity * numAggs];
+    this->numGroups = 0;
+}
+
+GroupTable::~GroupTable() {
+    delete[] this->slots;
+    delete[] this->groupHashes;
+    delete[] this->firstRows;
+    delete[] this->counts;
+    delete[] this->aggregates;
+}
+
+void GroupTable::add_row(size_t row) {
+    uint64_t hash = RowKeys::hash(this->keys, this->numKeys, row);
+    size_t group = this->find_or_add(row, hash);
+    this->counts[group]++;
+    double* aggregates = this->aggregates + group * this->numAggs;
+    for (size_t agg = 0; agg < this->numAggs; agg++) {
+        switch (this->ops[agg]) {
+            case AggOp::COUNT:  // the rows of the group are counted anyway
+                break;
+            case AggOp::SUM:
+            case AggOp::MEAN:
+                aggregates[agg] += value(this->values[agg], row);
+                break;
+            case AggOp::MIN: {
+                double current = value(this->values[agg], row);
+                if (current < aggregates[agg]) {
+                    aggregates[agg] = current;
+                }
+                break;
+            }
+            case AggOp::MAX: {
+                double current = value(this->values[agg], row);
+                if (current > aggregates[agg]) {
+                    aggregates[agg] = current;
+                }
+                break;
+            }
+        }
+    }
+}
+
+void GroupTable::merge(GroupTable* other) {
+    for (size_t otherGroup = 0; otherGroup < other->numGroups; otherGroup++) {
+        size_t group = this->find_or_add(other->firstRows[otherGroup],
+                                         other->groupHashes[otherGroup]);
+        this->counts[group] += other->counts[otherGroup];
+        double* aggregates = this->aggregates + group * this->numAggs;
+        double* otherAggregates =
+            other->aggregates + otherGroup * this->numAggs;
+        for (size_t agg = 0; agg < this->numAggs; agg++) {
+            switch (this->ops[agg]) {
+                case AggOp::MIN:
+                    if (otherAggregates[agg] < aggregates[agg]) {
+                        aggregates[agg] = otherAggregates[agg];
+                    }
+                    break;
+                case AggOp::MAX:
+                    if (otherAggregates[agg] > aggregates[agg]) {
+                        aggregates[agg] = otherAggregates[agg];
+                    }
+                    break;
+                default:
+                    aggregates[agg] += otherAggregates[agg];
+                    break;
+            }
+        }
+    }
+}
+
+size_t GroupTable::find_or_add(size_t row, uint64_t hash) {
+    // at most half of the slots are used, so the probes stay short
+    if ((this->numGroups + 1) * 2 > this->numSlots) {
+        this->grow_slots_();
+    }
+    size_t mask = this->numSlots - 1;
+    size_t slot = hash & mask;
+    while (this->slots[slot * 2 + 1] != EMPTY_SLOT) {
+        size_t group = this->slots[slot * 2 + 1];
+        if (this->slots[slot * 2] == hash &&
+            RowKeys::equal(this->keys, this->firstRows[group], this->keys,
+                           row, this->numKeys)) {
+            return group;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    // a new group
+    if (this->numGroups == this->groupCapacity) {
+        size_t capacity = this->groupCapacity * 2;
+        uint64_t* groupHashes = new uint64_t[capacity];
+        size_t* firstRows = new size_t[capacity];
+        size_t* counts = new size_t[capacity];
+        double* aggregates = new double[capacity * this->numAggs];
+        memcpy(groupHashes, this->groupHashes,
+               this->numGroups * sizeof(uint64_t));
+        memcpy(firstRows, this->firstRows, this->numGroups * sizeof(size_t));
+        memcpy(counts, this->counts, this->numGroups * sizeof(size_t));
+        memcpy(aggregates, this->aggregates,
+               this->numGroups * this->numAggs * sizeof(double));
+        delete[] this->groupHashes;
+        delete[] this->firstRows;
+        delete[] this->counts;
+        delete[] this->aggregates;
+        this->groupHashes = groupHashes;
+        this->firstRows = firstRows;
+        this->counts = counts;
+        this->aggregates = aggregates;
+        this->groupCapacity = capacity;
+    }
+    size_t group = this->numGroups++;
+    this->groupHashes[group] = hash;
+    this->firstRows[group] = row;
+    this->counts[group] = 0;
+    double* aggregates = this->aggregates + group * this->numAggs;
+    for (size_t agg = 0; agg < this->numAggs; agg++) {
+        switch (this->ops[agg]) {
+            case AggOp::MIN:
+                aggregates[agg] = std::numeric_limits<double>::infinity();
+                break;
+            case AggOp::MAX:
+                aggregates[agg] = -std::numeric_limits<double>::infinity();
+                break;
+            default:
+                aggregates[agg] = 0;
+                break;
+        }
+    }
+    this->slots[slot * 2] = hash;
+    this->slots[slot * 2 + 1] = group;
+    return group;
+}
+
+double GroupTable::value(Column* column, size_t row) {
+    switch (column->colType) {
+        case ColType::INTEGER:
+            return static_cast<IntColumn*>(column)->array->array[row];
+        case ColType::DOUBLE:
+            return static_cast<DoubleColumn*>(column)->array->array[row];
+        case ColType::BOOLEAN:
+            return static_cast<BoolColumn*>(column)->array->array[row];
+        default:
+            assert(false);  // strings are only counted
+            return 0;
+    }
+}
+
+void GroupTable::grow_slots_() {
+    delete[] this->slots;
+    this->numSlots *= 2;
+    this->slots = new uint64_t[this->numSlots * 2];
+    for (size_t slot = 0; slot < this->numSlots; slot++) {
+        this->slots[slot * 2 + 1] = EMPTY_SLOT;
+    }
+    size_t mask = this->numSlots - 1;
+    for (size_t group = 0; group < this->numGroups; group++) {
+        size_t slot = this->groupHashes[group] & mask;
+        while (this->slots[slot * 2 + 1] != EMPTY_SLOT) {
+            slot = (slot + 1) & mask;
+        }
+        this->slots[slot * 2] = this->groupHashes[group];
+        this->slots[slot * 2 + 1] = group;
+    }
+}
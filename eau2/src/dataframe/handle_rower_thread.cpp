@@ -15,9 +15,14 @@ HandleRowerThread::HandleRowerThread(ColumnArray *columnArray, Rower *rower,
 }
 
 void HandleRowerThread::run() {
+    if (this->beginRowIndex == this->endRowIndex) {
+        return;
+    }
+    // a single row, on loan to the rower, moved from row to row
+    Row row = Row(this->columnArray, this->beginRowIndex);
     for (size_t rowIndex = this->beginRowIndex; rowIndex < this->endRowIndex;
          rowIndex++) {
-        Row row = Row(this->columnArray, rowIndex);
+        row.rowIndex = rowIndex;
         rower->accept(row);
     }
 }
@@ -0,0 +1,148 @@
+#include "../../include/eau2/dataframe/hash_join.h"
+
+#include <cassert>
+#include <cstring>
+#include <thread>
+
+#include "../../include/eau2/dataframe/dataframe.h"
+#include "../../include/eau2/dataframe/join_table.h"
+#include "../../include/eau2/dataframe/join_thread.h"
+
+// the bytes of a row of a JoinTable: its hash, row, next entry and bucket
+#define JOIN_ENTRY_BYTES 32
+// the most radix bits, so partitioning writes to few enough places at once
+#define MAX_RADIX_BITS 12
+
+HashJoin::HashJoin(DataFrame* left, DataFrame* right, const size_t* leftKeys,
+                   const size_t* rightKeys, size_t numKeys, JoinType type)
+    : Object() {
+    assert(left != nullptr && right != nullptr);
+    assert(numKeys > 0);
+    for (size_t key = 0; key < numKeys; key++) {
+        assert(leftKeys[key] < left->ncols());
+        assert(rightKeys[key] < right->ncols());
+        assert(left->get_schema().col_type(leftKeys[key]) ==
+               right->get_schema().col_type(rightKeys[key]));
+    }
+    this->left = left;
+    this->right = right;
+    this->leftKeys = new size_t[numKeys];
+    memcpy(this->leftKeys, leftKeys, numKeys * sizeof(size_t));
+    this->rightKeys = new size_t[numKeys];
+    memcpy(this->rightKeys, rightKeys, numKeys * sizeof(size_t));
+    this->numKeys = numKeys;
+    this->type = type;
+    this->numThreads = std::thread::hardware_concurrency();
+    this->numThreads = this->numThreads > 0 ? this->numThreads : 1;
+    this->cacheBytes = JOIN_CACHE_BYTES;
+}
+
+HashJoin::~HashJoin() {
+    delete[] this->leftKeys;
+    delete[] this->rightKeys;
+}
+
+DataFrame* HashJoin::run() {
+    // a LEFT join keeps every row of left, so it probes with left
+    bool buildLeft = this->type == JoinType::INNER &&
+                     this->left->nrows() < this->right->nrows();
+    DataFrame* build = buildLeft ? this->left : this->right;
+    DataFrame* probe = buildLeft ? this->right : this->left;
+    size_t* buildCols = buildLeft ? this->leftKeys : this->rightKeys;
+    size_t* probeCols = buildLeft ? this->rightKeys : this->leftKeys;
+    Column** buildKeys = new Column*[this->numKeys];
+    Column** probeKeys = new Column*[this->numKeys];
+    for (size_t key = 0; key < this->numKeys; key++) {
+        buildKeys[key] = build->columns->get(buildCols[key]);
+        probeKeys[key] = probe->columns->get(probeCols[key]);
+    }
+    size_t numBuildRows = build->nrows();
+    size_t numProbeRows = probe->nrows();
+
+    // 0. build the table, partitioned until a partition fits in the cache
+    size_t radixBits = 0;
+    while (radixBits < MAX_RADIX_BITS &&
+           (numBuildRows * JOIN_ENTRY_BYTES >> radixBits) > this->cacheBytes) {
+        radixBits++;
+    }
+    JoinTable* table =
+        new JoinTable(buildKeys, this->numKeys, numBuildRows, radixBits, true);
+    JoinTable* probed = nullptr;
+    size_t numUnits = numProbeRows;
+    if (radixBits > 0) {
+        probed = new JoinTable(probeKeys, this->numKeys, numProbeRows,
+                               radixBits, false);
+        numUnits = table->numPartitions;
+    }
+    size_t numThreads = this->numThreads;
+    JoinThread** threads = new JoinThread*[numThreads];
+    for (size_t i = 0; i < numThreads; i++) {
+        threads[i] = new JoinThread(table, probeKeys, probed,
+                                    i * numUnits / numThreads,
+                                    (i + 1) * numUnits / numThreads,
+                                    this->type == JoinType::LEFT);
+    }
+
+    // 1. probe the ranges of rows or partitions
+    if (numThreads == 1) {
+        threads[0]->run();
+    } else {
+        for (size_t i = 0; i < numThreads; i++) {
+            threads[i]->start();
+        }
+        for (size_t i = 0; i < numThreads; i++) {
+            threads[i]->join();
+        }
+    }
+
+    // 2. concatenate the pairs in order, as rows of left and right
+    size_t numPairs = 0;
+    for (size_t i = 0; i < numThreads; i++) {
+        numPairs += threads[i]->numPairs;
+    }
+    size_t* leftRows = new size_t[numPairs];
+    size_t* rightRows = new size_t[numPairs];
+    size_t* buildRows = buildLeft ? leftRows : rightRows;
+    size_t* probeRows = buildLeft ? rightRows : leftRows;
+    size_t pair = 0;
+    for (size_t i = 0; i < numThreads; i++) {
+        JoinThread* thread = threads[i];
+        memcpy(buildRows + pair, thread->buildRows,
+               thread->numPairs * sizeof(size_t));
+        memcpy(probeRows + pair, thread->probeRows,
+               thread->numPairs * sizeof(size_t));
+        pair += thread->numPairs;
+        delete thread;
+    }
+    delete[] threads;
+    delete probed;
+    delete table;
+    delete[] buildKeys;
+    delete[] probeKeys;
+
+    // 3. gather the columns of left, then of right
+    Schema* schema = new Schema();
+    ColumnArray* columns = new ColumnArray();
+    DataFrame* sides[] = {this->left, this->right};
+    size_t* sideRows[] = {leftRows, rightRows};
+    for (size_t side = 0; side < 2; side++) {
+        for (size_t col = 0; col < sides[side]->ncols(); col++) {
+            Column* column = sides[side]->columns->get(col);
+            schema->add_col_type(column->get_type());
+            // NO_ROW is SIZE_MAX, so unmatched rows gather missing values
+            columns->append(column->gather(sideRows[side], numPairs));
+        }
+    }
+    DataFrame* result = new DataFrame(*schema);
+    for (int col = 0; col < columns->size(); col++) {
+        delete result->columns->set(col, columns->get(col));
+    }
+    result->schema->numRows = numPairs;
+    // the columns now belong to the result
+    columns->elementsInserted = 0;
+    delete columns;
+    delete schema;
+    delete[] leftRows;
+    delete[] rightRows;
+    return result;
+}
@@ -0,0 +1,108 @@
+#include "../../include/eau2/dataframe/join_table.h"
+
+#include <cassert>
+
+#include "../../include/eau2/dataframe/row_keys.h"
+
+JoinTable::JoinTable(Column** keys, size_t numKeys, size_t numRows,
+                     size_t radixBits, bool chained)
+    : Object() {
+    assert(keys != nullptr && numKeys > 0);
+    assert(radixBits < 64);
+    this->keys = keys;
+    this->numKeys = numKeys;
+    this->radixBits = radixBits;
+    this->numPartitions = static_cast<size_t>(1) << radixBits;
+    this->partitionStarts = new size_t[this->numPartitions + 1];
+    this->hashes = new uint64_t[numRows];
+    this->rows = new size_t[numRows];
+    this->bucketStarts = nullptr;
+    this->buckets = nullptr;
+    this->next = nullptr;
+
+    // 1. partition the rows, keeping them in order within a partition
+    if (radixBits == 0) {
+        for (size_t row = 0; row < numRows; row++) {
+            this->hashes[row] = RowKeys::hash(keys, numKeys, row);
+            this->rows[row] = row;
+        }
+        this->partitionStarts[0] = 0;
+        this->partitionStarts[1] = numRows;
+    } else {
+        uint64_t* rowHashes = new uint64_t[numRows];
+        size_t* counts = new size_t[this->numPartitions]();
+        for (size_t row = 0; row < numRows; row++) {
+            rowHashes[row] = RowKeys::hash(keys, numKeys, row);
+            counts[this->partition(rowHashes[row])]++;
+        }
+        size_t start = 0;
+        for (size_t p = 0; p < this->numPartitions; p++) {
+            this->partitionStarts[p] = start;
+            start += counts[p];
+            counts[p] = this->partitionStarts[p];  // the next free entry
+        }
+        this->partitionStarts[this->numPartitions] = numRows;
+        for (size_t row = 0; row < numRows; row++) {
+            size_t entry = counts[this->partition(rowHashes[row])]++;
+            this->hashes[entry] = rowHashes[row];
+            this->rows[entry] = row;
+        }
+        delete[] rowHashes;
+        delete[] counts;
+    }
+    if (!chained) {
+        return;
+    }
+
+    // 2. a power of two of buckets per partition, at least one per entry
+    this->bucketStarts = new size_t[this->numPartitions + 1];
+    size_t numBuckets = 0;
+    for (size_t p = 0; p < this->numPartitions; p++) {
+        size_t size =
+            this->partitionStarts[p + 1] - this->partitionStarts[p];
+        size_t partitionBuckets = 1;
+        while (partitionBuckets < size) {
+            partitionBuckets *= 2;
+        }
+        this->bucketStarts[p] = numBuckets;
+        numBuckets += partitionBuckets;
+    }
+    this->bucketStarts[this->numPartitions] = numBuckets;
+    this->buckets = new size_t[numBuckets];
+    for (size_t bucket = 0; bucket < numBuckets; bucket++) {
+        this->buckets[bucket] = NO_ROW;
+    }
+
+    // 3. chain the entries, the last first, so every chain is in order
+    this->next = new size_t[numRows];
+    for (size_t p = 0; p < this->numPartitions; p++) {
+        size_t mask = this->bucketStarts[p + 1] - this->bucketStarts[p] - 1;
+        for (size_t entry = this->partitionStarts[p + 1];
+             entry > this->partitionStarts[p]; entry--) {
+            size_t bucket =
+                this->bucketStarts[p] + (this->hashes[entry - 1] & mask);
+            this->next[entry - 1] = this->buckets[bucket];
+            this->buckets[bucket] = entry - 1;
+        }
+    }
+}
+
+JoinTable::~JoinTable() {
+    delete[] this->partitionStarts;
+    delete[] this->hashes;
+    delete[] this->rows;
+    delete[] this->bucketStarts;
+    delete[] this->buckets;
+    delete[] this->next;
+}
+
+size_t JoinTable::partition(uint64_t hash) {
+    // the buckets use the low bits, so the partitions use the high ones
+    return this->radixBits == 0 ? 0 : hash >> (64 - this->radixBits);
+}
+
+size_t JoinTable::first(size_t partition, uint64_t hash) {
+    size_t start = this->bucketStarts[partition];
+    size_t mask = this->bucketStarts[partition + 1] - start - 1;
+    return this->buckets[start + (hash & mask)];
+}
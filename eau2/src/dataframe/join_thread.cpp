@@ -0,0 +1,87 @@
+#include "../../include/eau2/dataframe/join_thread.h"
+
+#include <cassert>
+#include <cstring>
+
+#include "../../include/eau2/dataframe/row_keys.h"
+
+// the initial number of pairs of a thread
+#define INITIAL_PAIRS 1024
+
+JoinThread::JoinThread(JoinTable *table, Column **probeKeys,
+                       JoinTable *probed, size_t begin, size_t end,
+                       bool keepUnmatched)
+    : Thread() {
+    assert(table != nullptr && probeKeys != nullptr);
+    assert(begin <= end);
+    this->table = table;
+    this->probeKeys = probeKeys;
+    this->probed = probed;
+    this->begin = begin;
+    this->end = end;
+    this->keepUnmatched = keepUnmatched;
+    this->capacity = INITIAL_PAIRS;
+    this->probeRows = new size_t[this->capacity];
+    this->buildRows = new size_t[this->capacity];
+    this->numPairs = 0;
+}
+
+JoinThread::~JoinThread() {
+    delete[] this->probeRows;
+    delete[] this->buildRows;
+}
+
+void JoinThread::run() {
+    JoinTable *table = this->table;
+    if (this->probed == nullptr) {
+        for (size_t row = this->begin; row < this->end; row++) {
+            uint64_t hash =
+                RowKeys::hash(this->probeKeys, table->numKeys, row);
+            this->probe_(row, table->partition(hash), hash);
+        }
+        return;
+    }
+    // a partition of the probed side only reads the same partition of the
+    // table, which fits in the cache
+    JoinTable *probed = this->probed;
+    for (size_t p = this->begin; p < this->end; p++) {
+        for (size_t entry = probed->partitionStarts[p];
+             entry < probed->partitionStarts[p + 1]; entry++) {
+            this->probe_(probed->rows[entry], p, probed->hashes[entry]);
+        }
+    }
+}
+
+void JoinThread::probe_(size_t probeRow, size_t partition, uint64_t hash) {
+    JoinTable *table = this->table;
+    size_t matches = this->numPairs;
+    for (size_t entry = table->first(partition, hash); entry != NO_ROW;
+         entry = table->next[entry]) {
+        if (table->hashes[entry] == hash &&
+            RowKeys::equal(table->keys, table->rows[entry], this->probeKeys,
+                           probeRow, table->numKeys)) {
+            this->add_pair_(probeRow, table->rows[entry]);
+        }
+    }
+    if (this->keepUnmatched && this->numPairs == matches) {
+        this->add_pair_(probeRow, NO_ROW);
+    }
+}
+
+void JoinThread::add_pair_(size_t probeRow, size_t buildRow) {
+    if (this->numPairs == this->capacity) {
+        size_t capacity = this->capacity * 2;
+        size_t *probeRows = new size_t[capacity];
+        size_t *buildRows = new size_t[capacity];
+        memcpy(probeRows, this->probeRows, this->numPairs * sizeof(size_t));
+        memcpy(buildRows, this->buildRows, this->numPairs * sizeof(size_t));
+        delete[] this->probeRows;
+        delete[] this->buildRows;
+        this->probeRows = probeRows;
+        this->buildRows = buildRows;
+        this->capacity = capacity;
+    }
+    this->probeRows[this->numPairs] = probeRow;
+    this->buildRows[this->numPairs] = buildRow;
+    this->numPairs++;
+}
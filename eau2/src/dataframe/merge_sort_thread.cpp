@@ -0,0 +1,103 @@
+#include "../../include/eau2/dataframe/merge_sort_thread.h"
+
+#include <cassert>
+#include <cstring>
+
+#include "../../include/eau2/utils/string.h"
+
+// compares the given strings, a missing string before every string
+static int compare(String *s, String *t) {
+    if (s == nullptr || t == nullptr) {
+        return (s != nullptr) - (t != nullptr);
+    }
+    size_t length = s->size_ < t->size_ ? s->size_ : t->size_;
+    int result = memcmp(s->cstr_, t->cstr_, length);
+    if (result != 0) {
+        return result;
+    }
+    return (s->size_ > t->size_) - (s->size_ < t->size_);
+}
+
+MergeSortThread::MergeSortThread(Object **strings, bool ascending,
+                                 size_t *rows, size_t *buffer, size_t begin,
+                                 size_t middle, size_t end)
+    : Thread() {
+    assert(strings != nullptr || begin == end);
+    assert(begin <= middle && middle <= end);
+    this->strings = strings;
+    this->ascending = ascending;
+    this->rows = rows;
+    this->buffer = buffer;
+    this->begin = begin;
+    this->middle = middle;
+    this->end = end;
+}
+
+void MergeSortThread::run() {
+    if (this->middle != this->end) {
+        this->merge_(this->rows, this->buffer, this->begin, this->middle,
+                     this->end);
+        memcpy(this->rows + this->begin, this->buffer + this->begin,
+               (this->end - this->begin) * sizeof(size_t));
+        return;
+    }
+
+    // 1. sort short runs by insertion
+    size_t *rows = this->rows;
+    for (size_t run = this->begin; run < this->end; run += INSERTION_RUN) {
+        size_t runEnd =
+            run + INSERTION_RUN < this->end ? run + INSERTION_RUN : this->end;
+        for (size_t i = run + 1; i < runEnd; i++) {
+            size_t row = rows[i];
+            size_t j = i;
+            for (; j > run && this->before_(row, rows[j - 1]); j--) {
+                rows[j] = rows[j - 1];
+            }
+            rows[j] = row;
+        }
+    }
+
+    // 2. merge the runs back and forth between the rows and the buffer
+    size_t *from = this->rows;
+    size_t *to = this->buffer;
+    for (size_t width = INSERTION_RUN; width < this->end - this->begin;
+         width *= 2) {
+        for (size_t low = this->begin; low < this->end; low += 2 * width) {
+            size_t middle = low + width < this->end ? low + width : this->end;
+            size_t high =
+                middle + width < this->end ? middle + width : this->end;
+            this->merge_(from, to, low, middle, high);
+        }
+        size_t *swap = from;
+        from = to;
+        to = swap;
+    }
+    if (from != this->rows) {
+        memcpy(this->rows + this->begin, from + this->begin,
+               (this->end - this->begin) * sizeof(size_t));
+    }
+}
+
+bool MergeSortThread::before_(size_t row, size_t other) {
+    int result = compare(static_cast<String *>(this->strings[row]),
+                         static_cast<String *>(this->strings[other]));
+    return this->ascending ? result < 0 : result > 0;
+}
+
+void MergeSortThread::merge_(const size_t *from, size_t *to, size_t begin,
+                             size_t middle, size_t end) {
+    size_t left = begin;
+    size_t right = middle;
+    size_t out = begin;
+    // a row of the second half only goes first if it sorts strictly before
+    while (left < middle && right < end) {
+        if (this->before_(from[right], from[left])) {
+            to[out++] = from[right++];
+        } else {
+            to[out++] = from[left++];
+        }
+    }
+    memcpy(to + out, from + left, (middle - left) * sizeof(size_t));
+    out += middle - left;
+    memcpy(to + out, from + right, (end - right) * sizeof(size_t));
+}
@@ -0,0 +1,288 @@
+#include "../../include/eau2/dataframe/quantile_sketch.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+
+#include "../../include/eau2/serialization/deserializer.h"
+#include "../../include/eau2/serialization/serializer.h"
+
+// the least capacity of a level
+#define MIN_LEVEL_CAPACITY 8
+// the most values of a level sorted by insertion sort when compacted
+#define INSERTION_SORT_VALUES 32
+// the doubles serialized before the sizes of the levels
+#define SKETCH_HEADER 6
+
+// a retained value and the number of added values it stands for
+struct WeightedValue {
+    double value;
+    size_t weight;
+};
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *static_cast<const double*>(a);
+    double y = *static_cast<const double*>(b);
+    return (x > y) - (x < y);
+}
+
+static int compare_weighted(const void* a, const void* b) {
+    return compare_doubles(&static_cast<const WeightedValue*>(a)->value,
+                           &static_cast<const WeightedValue*>(b)->value);
+}
+
+QuantileSketch::QuantileSketch(size_t k) {
+    assert(k >= 2);
+    this->k = k;
+    this->numLevels = 1;
+    this->levels = new double*[1];
+    this->levels[0] = new double[k];
+    this->sizes = new size_t[1]();
+    this->allocated = new size_t[1];
+    this->allocated[0] = k;
+    this->capacities = new size_t[1];
+    this->retained = 0;
+    this->count = 0;
+    this->minimum = 0;
+    this->maximum = 0;
+    this->seed = 1;
+    this->set_capacities_();
+}
+
+QuantileSketch::~QuantileSketch() {
+    for (size_t level = 0; level < this->numLevels; level++) {
+        delete[] this->levels[level];
+    }
+    delete[] this->levels;
+    delete[] this->sizes;
+    delete[] this->allocated;
+    delete[] this->capacities;
+}
+
+void QuantileSketch::add(double value) {
+    if (this->count == 0 || value < this->minimum) {
+        this->minimum = value;
+    }
+    if (this->count == 0 || value > this->maximum) {
+        this->maximum = value;
+    }
+    this->count++;
+    this->append_(0, value);
+    if (this->retained > this->capacity) {
+        this->compress_();
+    }
+}
+
+void QuantileSketch::merge(QuantileSketch* other) {
+    assert(other != nullptr && other != this);
+    if (other->count == 0) {
+        return;
+    }
+    if (this->count == 0 || other->minimum < this->minimum) {
+        this->minimum = other->minimum;
+    }
+    if (this->count == 0 || other->maximum > this->maximum) {
+        this->maximum = other->maximum;
+    }
+    this->count += other->count;
+    if (other->k > this->k) {
+        this->k = other->k;
+        this->set_capacities_();
+    }
+    for (size_t level = 0; level < other->numLevels; level++) {
+        for (size_t i = 0; i < other->sizes[level]; i++) {
+            this->append_(level, other->levels[level][i]);
+        }
+    }
+    this->compress_();
+}
+
+double QuantileSketch::quantile(double q) {
+    if (this->count == 0) {
+        return 0;
+    }
+    if (q <= 0) {
+        return this->minimum;
+    }
+    if (q >= 1) {
+        return this->maximum;
+    }
+    // 0. every retained value with its weight, in ascending order
+    size_t numValues = 0;
+    for (size_t level = 0; level < this->numLevels; level++) {
+        numValues += this->sizes[level];
+    }
+    WeightedValue* values = new WeightedValue[numValues];
+    size_t position = 0;
+    for (size_t level = 0; level < this->numLevels; level++) {
+        for (size_t i = 0; i < this->sizes[level]; i++) {
+            values[position].value = this->levels[level][i];
+            values[position].weight = static_cast<size_t>(1) << level;
+            position++;
+        }
+    }
+    qsort(values, numValues, sizeof(WeightedValue), compare_weighted);
+
+    // 1. the first value whose rank reaches the fraction of the count
+    double rank = q * this->count;
+    double result = this->maximum;
+    size_t weight = 0;
+    for (size_t i = 0; i < numValues; i++) {
+        weight += values[i].weight;
+        if (weight >= rank) {
+            result = values[i].value;
+            break;
+        }
+    }
+    delete[] values;
+    return result;
+}
+
+size_t QuantileSketch::size() { return this->count; }
+
+byte* QuantileSketch::serialize() {
+    size_t numValues = 0;
+    for (size_t level = 0; level < this->numLevels; level++) {
+        numValues += this->sizes[level];
+    }
+    size_t size = SKETCH_HEADER + this->numLevels + numValues;
+    double* array = new double[size];
+    array[0] = this->k;
+    array[1] = this->numLevels;
+    array[2] = this->count;
+    array[3] = this->minimum;
+    array[4] = this->maximum;
+    array[5] = this->seed;
+    size_t position = SKETCH_HEADER;
+    for (size_t level = 0; level < this->numLevels; level++) {
+        array[position++] = this->sizes[level];
+    }
+    for (size_t level = 0; level < this->numLevels; level++) {
+        // an empty level may not be allocated yet
+        if (this->sizes[level] > 0) {
+            memcpy(array + position, this->levels[level],
+                   this->sizes[level] * sizeof(double));
+        }
+        position += this->sizes[level];
+    }
+    byte* bytes = Serializer::serialize_double_array(array, size);
+    delete[] array;
+    return bytes;
+}
+
+QuantileSketch* QuantileSketch::deserialize(byte* bytes) {
+    size_t size = Deserializer::array_size(bytes);
+    assert(size >= SKETCH_HEADER);
+    double* array = Deserializer::deserialize_double_array(bytes);
+    QuantileSketch* sketch =
+        new QuantileSketch(static_cast<size_t>(array[0]));
+    size_t numLevels = static_cast<size_t>(array[1]);
+    sketch->count = static_cast<size_t>(array[2]);
+    sketch->minimum = array[3];
+    sketch->maximum = array[4];
+    sketch->seed = static_cast<unsigned int>(array[5]);
+    size_t position = SKETCH_HEADER + numLevels;
+    for (size_t level = 0; level < numLevels; level++) {
+        size_t levelSize = static_cast<size_t>(array[SKETCH_HEADER + level]);
+        for (size_t i = 0; i < levelSize; i++) {
+            sketch->append_(level, array[position++]);
+        }
+    }
+    assert(position == size);
+    delete[] array;
+    return sketch;
+}
+
+void QuantileSketch::set_capacities_() {
+    // k * (2/3)^depth, where the top level has depth 0
+    double capacity = this->k;
+    this->capacity = 0;
+    for (size_t level = this->numLevels; level > 0; level--) {
+        size_t rounded = static_cast<size_t>(capacity + 0.5);
+        if (rounded < MIN_LEVEL_CAPACITY) {
+            rounded = MIN_LEVEL_CAPACITY;
+        }
+        this->capacities[level - 1] = rounded;
+        this->capacity += rounded;
+        capacity = capacity * 2 / 3;
+    }
+}
+
+void QuantileSketch::append_(size_t level, double value) {
+    if (level >= this->numLevels) {
+        size_t numLevels = level + 1;
+        double** levels = new double*[numLevels];
+        size_t* sizes = new size_t[numLevels]();
+        size_t* allocated = new size_t[numLevels]();
+        memcpy(levels, this->levels, this->numLevels * sizeof(double*));
+        memcpy(sizes, this->sizes, this->numLevels * sizeof(size_t));
+        memcpy(allocated, this->allocated, this->numLevels * sizeof(size_t));
+        for (size_t added = this->numLevels; added < numLevels; added++) {
+            levels[added] = nullptr;
+        }
+        delete[] this->levels;
+        delete[] this->sizes;
+        delete[] this->allocated;
+        delete[] this->capacities;
+        this->levels = levels;
+        this->sizes = sizes;
+        this->allocated = allocated;
+        this->capacities = new size_t[numLevels];
+        this->numLevels = numLevels;
+        this->set_capacities_();
+    }
+    if (this->sizes[level] == this->allocated[level]) {
+        size_t length = this->allocated[level] == 0
+                            ? this->k
+                            : this->allocated[level] * 2;
+        double* values = new double[length];
+        if (this->sizes[level] > 0) {
+            memcpy(values, this->levels[level],
+                   this->sizes[level] * sizeof(double));
+        }
+        delete[] this->levels[level];
+        this->levels[level] = values;
+        this->allocated[level] = length;
+    }
+    this->levels[level][this->sizes[level]++] = value;
+    this->retained++;
+}
+
+void QuantileSketch::compress_() {
+    while (this->retained > this->capacity) {
+        // 0. the lowest level at its capacity
+        size_t full = 0;
+        while (full < this->numLevels &&
+               this->sizes[full] < this->capacities[full]) {
+            full++;
+        }
+        if (full == this->numLevels) {
+            return;
+        }
+
+        // 1. promotes every other sorted value, leaving one behind if odd
+        double* values = this->levels[full];
+        size_t size = this->sizes[full];
+        if (size <= INSERTION_SORT_VALUES) {
+            for (size_t i = 1; i < size; i++) {
+                double value = values[i];
+                size_t j = i;
+                for (; j > 0 && values[j - 1] > value; j--) {
+                    values[j] = values[j - 1];
+                }
+                values[j] = value;
+            }
+        } else {
+            qsort(values, size, sizeof(double), compare_doubles);
+        }
+        size_t offset = rand_r(&this->seed) % 2;
+        size_t paired = size - size % 2;
+        this->sizes[full] = size % 2;
+        this->retained -= paired;
+        for (size_t i = offset; i < paired; i += 2) {
+            // may replace the array of levels, not the values of this one
+            this->append_(full + 1, values[i]);
+        }
+        values[0] = values[size - 1];
+    }
+}
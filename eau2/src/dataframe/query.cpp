@@ -0,0 +1,211 @@
+#include "../../include/eau2/dataframe/query.h"
+
+#include <cassert>
+#include <cstring>
+#include <thread>
+
+#include "../../include/eau2/dataframe/dataframe.h"
+#include "../../include/eau2/dataframe/group_table.h"
+#include "../../include/eau2/dataframe/query_thread.h"
+
+Query::Query(DataFrame* df) : Object() {
+    assert(df != nullptr);
+    this->df = df;
+    this->predicate = new Predicate();
+    this->zones = nullptr;
+    this->expr = nullptr;
+    this->numCols = df->ncols();
+    this->cols = new size_t[this->numCols];
+    for (size_t col = 0; col < this->numCols; col++) {
+        this->cols[col] = col;
+    }
+    this->keys = nullptr;
+    this->numKeys = 0;
+    this->ops = nullptr;
+    this->aggCols = nullptr;
+    this->numAggs = 0;
+    this->aggregated = false;
+    this->numThreads = std::thread::hardware_concurrency();
+    this->numThreads = this->numThreads > 0 ? this->numThreads : 1;
+}
+
+Query::~Query() {
+    delete this->predicate;
+    delete[] this->zones;
+    delete this->expr;
+    delete[] this->cols;
+    delete[] this->keys;
+    delete[] this->ops;
+    delete[] this->aggCols;
+}
+
+Query* Query::filter(Condition* condition) {
+    assert(!this->aggregated);
+    assert(condition != nullptr && condition->column < this->numCols);
+    condition->column = this->cols[condition->column];
+    this->predicate->add(condition);
+    return this;
+}
+
+Query* Query::filter(Expr* predicate) {
+    assert(!this->aggregated);
+    assert(predicate != nullptr);
+    predicate->remap(this->cols);
+    this->expr = this->expr == nullptr
+                     ? predicate
+                     : Expr::binary(ExprOp::AND, this->expr, predicate);
+    return this;
+}
+
+Query* Query::project(const size_t* cols, size_t numCols) {
+    assert(!this->aggregated);
+    size_t* projected = new size_t[numCols];
+    for (size_t col = 0; col < numCols; col++) {
+        assert(cols[col] < this->numCols);
+        projected[col] = this->cols[cols[col]];
+    }
+    delete[] this->cols;
+    this->cols = projected;
+    this->numCols = numCols;
+    return this;
+}
+
+Query* Query::aggregate(const size_t* keys, size_t numKeys, const AggOp* ops,
+                        const size_t* cols, size_t numAggs) {
+    assert(!this->aggregated);
+    this->keys = new size_t[numKeys];
+    for (size_t key = 0; key < numKeys; key++) {
+        assert(keys[key] < this->numCols);
+        this->keys[key] = this->cols[keys[key]];
+    }
+    this->numKeys = numKeys;
+    this->ops = new AggOp[numAggs];
+    memcpy(this->ops, ops, numAggs * sizeof(AggOp));
+    this->aggCols = new size_t[numAggs];
+    for (size_t agg = 0; agg < numAggs; agg++) {
+        assert(cols[agg] < this->numCols);
+        this->aggCols[agg] = this->cols[cols[agg]];
+        assert(ops[agg] == AggOp::COUNT ||
+               this->df->columns->get(this->aggCols[agg])->get_type() !=
+                   ColType::STRING);
+    }
+    this->numAggs = numAggs;
+    this->aggregated = true;
+    return this;
+}
+
+size_t Query::select(size_t begin, size_t end, size_t* rows, Expr* expr) {
+    Predicate* predicate = this->predicate;
+    for (size_t i = 0; i < predicate->numConditions; i++) {
+        if (!this->zones[i]->may_match(predicate->conditions[i], begin, end)) {
+            return 0;
+        }
+    }
+    size_t numRows = end - begin;
+    for (size_t i = 0; i < numRows; i++) {
+        rows[i] = begin + i;
+    }
+    // every check reads its column for the rows kept by the checks before it
+    for (size_t i = 0; i < predicate->numConditions && numRows > 0; i++) {
+        Condition* condition = predicate->conditions[i];
+        numRows = condition->select(this->df->columns->get(condition->column),
+                                    rows, numRows);
+    }
+    if (expr != nullptr && numRows > 0) {
+        numRows = expr->select(begin, end, rows, numRows);
+    }
+    return numRows;
+}
+
+DataFrame* Query::run() {
+    DataFrame* df = this->df;
+    size_t numRows = df->nrows();
+    Column** keys = new Column*[this->numKeys];
+    for (size_t key = 0; key < this->numKeys; key++) {
+        keys[key] = df->columns->get(this->keys[key]);
+    }
+    Column** values = new Column*[this->numAggs];
+    for (size_t agg = 0; agg < this->numAggs; agg++) {
+        values[agg] = df->columns->get(this->aggCols[agg]);
+    }
+    // the zone maps are brought up to date before the threads read them
+    Predicate* predicate = this->predicate;
+    delete[] this->zones;
+    this->zones = new ZoneMap*[predicate->numConditions];
+    for (size_t i = 0; i < predicate->numConditions; i++) {
+        Column* column = df->columns->get(predicate->conditions[i]->column);
+        this->zones[i] = column->zone_map();
+    }
+
+    // 0. initialize a range of rows per thread
+    size_t numThreads = this->numThreads;
+    QueryThread** threads = new QueryThread*[numThreads];
+    for (size_t i = 0; i < numThreads; i++) {
+        GroupTable* table = nullptr;
+        if (this->aggregated) {
+            table = new GroupTable(keys, this->numKeys, values, this->ops,
+                                   this->numAggs);
+        }
+        threads[i] = new QueryThread(this, table, i * numRows / numThreads,
+                                     (i + 1) * numRows / numThreads);
+    }
+
+    // 1. take the ranges through the operators
+    if (numThreads == 1) {
+        threads[0]->run();
+    } else {
+        for (size_t i = 0; i < numThreads; i++) {
+            threads[i]->start();
+        }
+        for (size_t i = 0; i < numThreads; i++) {
+            threads[i]->join();
+        }
+    }
+
+    DataFrame* result;
+    if (this->aggregated) {
+        // 2. merge the tables in order, so the groups keep their first rows
+        GroupTable* table = threads[0]->table;
+        for (size_t i = 1; i < numThreads; i++) {
+            table->merge(threads[i]->table);
+        }
+        result = GroupBy::to_frame(table);
+    } else {
+        // 2. the rows kept by every thread, in order
+        size_t numKept = 0;
+        for (size_t i = 0; i < numThreads; i++) {
+            numKept += threads[i]->numRows;
+        }
+        size_t* rows = new size_t[numKept];
+        size_t position = 0;
+        for (size_t i = 0; i < numThreads; i++) {
+            memcpy(rows + position, threads[i]->rows,
+                   threads[i]->numRows * sizeof(size_t));
+            position += threads[i]->numRows;
+        }
+
+        // 3. the kept columns of the kept rows
+        Schema* schema = new Schema();
+        for (size_t col = 0; col < this->numCols; col++) {
+            Column* column = df->columns->get(this->cols[col]);
+            schema->add_col_type(column->get_type());
+        }
+        result = new DataFrame(*schema);
+        for (size_t col = 0; col < this->numCols; col++) {
+            Column* column =
+                df->columns->get(this->cols[col])->gather(rows, numKept);
+            delete result->columns->set(col, column);
+        }
+        result->schema->numRows = numKept;
+        delete schema;
+        delete[] rows;
+    }
+
+    for (size_t i = 0; i < numThreads; i++) {
+        delete threads[i];
+    }
+    delete[] threads;
+    delete[] keys;
+    delete[] values;
+    return result;
+}
@@ -0,0 +1,52 @@
+#include "../../include/eau2/dataframe/query_thread.h"
+
+#include <cassert>
+
+QueryThread::QueryThread(Query *query, GroupTable *table,
+                         size_t beginRowIndex, size_t endRowIndex)
+    : Thread() {
+    assert(query != nullptr);
+    assert(beginRowIndex <= endRowIndex);
+    this->query = query;
+    this->table = table;
+    this->expr = nullptr;
+    if (query->expr != nullptr) {
+        // the values of a batch are kept in the nodes, so one copy per thread
+        this->expr = dynamic_cast<Expr *>(query->expr->clone());
+        ColType type = this->expr->bind(query->df);
+        assert(type == ColType::BOOLEAN);
+    }
+    // an aggregation needs the rows of one morsel at a time
+    size_t numRows = endRowIndex - beginRowIndex;
+    this->rows = new size_t[table != nullptr && numRows > MORSEL_ROWS
+                                ? MORSEL_ROWS
+                                : numRows];
+    this->numRows = 0;
+    this->beginRowIndex = beginRowIndex;
+    this->endRowIndex = endRowIndex;
+}
+
+QueryThread::~QueryThread() {
+    delete this->table;
+    delete this->expr;
+    delete[] this->rows;
+}
+
+void QueryThread::run() {
+    for (size_t begin = this->beginRowIndex; begin < this->endRowIndex;
+         begin += MORSEL_ROWS) {
+        size_t end = begin + MORSEL_ROWS < this->endRowIndex
+                         ? begin + MORSEL_ROWS
+                         : this->endRowIndex;
+        if (this->table == nullptr) {
+            this->numRows += this->query->select(
+                begin, end, this->rows + this->numRows, this->expr);
+        } else {
+            size_t numRows =
+                this->query->select(begin, end, this->rows, this->expr);
+            for (size_t i = 0; i < numRows; i++) {
+                this->table->add_row(this->rows[i]);
+            }
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#include "../../include/eau2/dataframe/radix_sort_thread.h"
+
+#include <cassert>
+
+RadixSortThread::RadixSortThread(size_t begin, size_t end) : Thread() {
+    assert(begin <= end);
+    this->keys = nullptr;
+    this->rows = nullptr;
+    this->outKeys = nullptr;
+    this->outRows = nullptr;
+    this->begin = begin;
+    this->end = end;
+    this->shift = 0;
+    this->counts = new size_t[RADIX_BUCKETS];
+    this->scatter = false;
+}
+
+RadixSortThread::~RadixSortThread() { delete[] this->counts; }
+
+void RadixSortThread::run() {
+    const uint64_t *keys = this->keys;
+    size_t shift = this->shift;
+    size_t *counts = this->counts;
+    if (!this->scatter) {
+        for (size_t digit = 0; digit < RADIX_BUCKETS; digit++) {
+            counts[digit] = 0;
+        }
+        for (size_t i = this->begin; i < this->end; i++) {
+            counts[(keys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+        }
+        return;
+    }
+    for (size_t i = this->begin; i < this->end; i++) {
+        size_t position = counts[(keys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+        this->outKeys[position] = keys[i];
+        this->outRows[position] = this->rows[i];
+    }
+}
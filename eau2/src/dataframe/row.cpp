@@ -29,7 +29,7 @@ void Row::initColumnArray() {
                 break;
             case ColType::DOUBLE:
                 this->columnArray->append(new DoubleColumn());
-                this->columnArray->get(colIndex)->push_back(0);
+                this->columnArray->get(colIndex)->push_back(0.0);
                 break;
             case ColType::BOOLEAN:
                 this->columnArray->append(new BoolColumn());
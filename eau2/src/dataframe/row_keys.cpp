@@ -0,0 +1,100 @@
+#include "../../include/eau2/dataframe/row_keys.h"
+
+#include <cstring>
+
+#include "../../include/eau2/dataframe/columns/bool_column.h"
+#include "../../include/eau2/dataframe/columns/double_column.h"
+#include "../../include/eau2/dataframe/columns/int_column.h"
+#include "../../include/eau2/dataframe/columns/string_column.h"
+#include "../../include/eau2/utils/string.h"
+
+// the finalizer of splitmix64, spreading every bit of x over the result
+static uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+uint64_t RowKeys::hash(Column** keys, size_t numKeys, size_t row) {
+    uint64_t hash = 0;
+    for (size_t key = 0; key < numKeys; key++) {
+        Column* column = keys[key];
+        uint64_t bits;
+        switch (column->colType) {
+            case ColType::INTEGER:
+                bits = static_cast<uint32_t>(
+                    static_cast<IntColumn*>(column)->array->array[row]);
+                break;
+            case ColType::DOUBLE: {
+                DoubleColumn* doubles = static_cast<DoubleColumn*>(column);
+                double d = doubles->array->array[row];
+                d = d == 0.0 ? 0.0 : d;  // -0.0 equals 0.0
+                memcpy(&bits, &d, sizeof(bits));
+                break;
+            }
+            case ColType::BOOLEAN:
+                bits = static_cast<BoolColumn*>(column)->array->array[row];
+                break;
+            default: {
+                String* s = static_cast<String*>(
+                    static_cast<StringColumn*>(column)->array->array[row]);
+                // FNV-1a of the characters; missing strings hash to 1
+                bits = s == nullptr ? 1 : 14695981039346656037ULL;
+                for (size_t i = 0; s != nullptr && i < s->size_; i++) {
+                    bits = (bits ^ static_cast<unsigned char>(s->cstr_[i])) *
+                           1099511628211ULL;
+                }
+                break;
+            }
+        }
+        hash = mix(hash + bits + 0x9e3779b97f4a7c15ULL);
+    }
+    return hash;
+}
+
+bool RowKeys::equal(Column** keys, size_t row, Column** otherKeys,
+                    size_t otherRow, size_t numKeys) {
+    for (size_t key = 0; key < numKeys; key++) {
+        Column* column = keys[key];
+        Column* other = otherKeys[key];
+        switch (column->colType) {
+            case ColType::INTEGER:
+                if (static_cast<IntColumn*>(column)->array->array[row] !=
+                    static_cast<IntColumn*>(other)->array->array[otherRow]) {
+                    return false;
+                }
+                break;
+            case ColType::DOUBLE:
+                if (static_cast<DoubleColumn*>(column)->array->array[row] !=
+                    static_cast<DoubleColumn*>(other)
+                        ->array->array[otherRow]) {
+                    return false;
+                }
+                break;
+            case ColType::BOOLEAN:
+                if (static_cast<BoolColumn*>(column)->array->array[row] !=
+                    static_cast<BoolColumn*>(other)->array->array[otherRow]) {
+                    return false;
+                }
+                break;
+            default: {
+                String* s = static_cast<String*>(
+                    static_cast<StringColumn*>(column)->array->array[row]);
+                String* t = static_cast<String*>(
+                    static_cast<StringColumn*>(other)->array->array[otherRow]);
+                if (s == nullptr || t == nullptr) {
+                    if (s != t) {
+                        return false;
+                    }
+                } else if (s->size_ != t->size_ ||
+                           memcmp(s->cstr_, t->cstr_, s->size_) != 0) {
+                    return false;
+                }
+                break;
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,29 @@
+#include "../../../include/eau2/dataframe/rowers/quantile_rower.h"
+
+#include <cstdlib>
+
+QuantileRower::QuantileRower(size_t colIndex, size_t k) : Rower(colIndex) {
+    this->sketch = new QuantileSketch(k);
+}
+
+bool QuantileRower::accept(Row &r) {
+    this->sketch->add(this->get_number(r));
+    return false;
+}
+
+Object *QuantileRower::clone() {
+    QuantileRower *clone = new QuantileRower(this->colIndex, this->sketch->k);
+    // the compactions of the clones should not pick the same values
+    clone->sketch->seed = rand_r(&this->sketch->seed);
+    return clone;
+}
+
+void QuantileRower::join_delete(Rower *other) {
+    QuantileRower *quantileRower = dynamic_cast<QuantileRower *>(other);
+    if (quantileRower != nullptr) {
+        this->sketch->merge(quantileRower->sketch);
+        delete quantileRower;
+    }
+}
+
+QuantileRower::~QuantileRower() { delete this->sketch; }
@@ -1,7 +1,28 @@
 #include "../../../include/eau2/dataframe/rowers/rower.h"
 
+#include <cassert>
+
+#include "../../../include/eau2/dataframe/columns/bool_column.h"
+#include "../../../include/eau2/dataframe/columns/double_column.h"
+#include "../../../include/eau2/dataframe/columns/int_column.h"
+
 Rower::Rower(size_t colIndex) { this->colIndex = colIndex; }
 
 void Rower::join_delete(Rower *other) {
     // empty to be used in the single threaded rower
 }
+
+double Rower::get_number(Row &r) {
+    Column *column = r.columnArray->get(this->colIndex);
+    switch (column->get_type()) {
+        case ColType::INTEGER:
+            return column->as_int()->get_int(r.rowIndex);
+        case ColType::DOUBLE:
+            return column->as_double()->get_double(r.rowIndex);
+        case ColType::BOOLEAN:
+            return column->as_bool()->get_bool(r.rowIndex);
+        default:
+            assert(false);
+            return 0;
+    }
+}
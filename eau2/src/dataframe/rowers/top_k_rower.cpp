@@ -0,0 +1,105 @@
+#include "../../../include/eau2/dataframe/rowers/top_k_rower.h"
+
+#include <cstring>
+
+// true if the first row is worse than the second one
+static bool worse(double value, size_t row, double otherValue,
+                  size_t otherRow) {
+    return value < otherValue || (value == otherValue && row > otherRow);
+}
+
+// moves the entry at the given index of a heap of the given size down until
+// no child is worse than it
+static void sift_down(double *values, size_t *rows, size_t size,
+                      size_t index) {
+    double value = values[index];
+    size_t row = rows[index];
+    while (2 * index + 1 < size) {
+        size_t child = 2 * index + 1;
+        if (child + 1 < size && worse(values[child + 1], rows[child + 1],
+                                      values[child], rows[child])) {
+            child++;
+        }
+        if (!worse(values[child], rows[child], value, row)) {
+            break;
+        }
+        values[index] = values[child];
+        rows[index] = rows[child];
+        index = child;
+    }
+    values[index] = value;
+    rows[index] = row;
+}
+
+TopKRower::TopKRower(size_t colIndex, size_t k) : Rower(colIndex) {
+    this->k = k;
+    this->values = new double[k];
+    this->rows = new size_t[k];
+}
+
+bool TopKRower::accept(Row &r) {
+    this->offer(this->get_number(r), r.rowIndex);
+    return false;
+}
+
+Object *TopKRower::clone() { return new TopKRower(this->colIndex, this->k); }
+
+void TopKRower::join_delete(Rower *other) {
+    TopKRower *topKRower = dynamic_cast<TopKRower *>(other);
+    if (topKRower != nullptr) {
+        for (size_t i = 0; i < topKRower->size; i++) {
+            this->offer(topKRower->values[i], topKRower->rows[i]);
+        }
+        delete topKRower;
+    }
+}
+
+void TopKRower::offer(double value, size_t row) {
+    if (value != value) {
+        return;  // a NaN passes no comparison, so it is never among the best
+    }
+    if (this->size < this->k) {
+        // moves the new entry up while worse than its parent
+        size_t index = this->size++;
+        while (index > 0) {
+            size_t parent = (index - 1) / 2;
+            if (!worse(value, row, this->values[parent], this->rows[parent])) {
+                break;
+            }
+            this->values[index] = this->values[parent];
+            this->rows[index] = this->rows[parent];
+            index = parent;
+        }
+        this->values[index] = value;
+        this->rows[index] = row;
+    } else if (this->k > 0 &&
+               worse(this->values[0], this->rows[0], value, row)) {
+        this->values[0] = value;
+        this->rows[0] = row;
+        sift_down(this->values, this->rows, this->size, 0);
+    }
+}
+
+size_t *TopKRower::sorted_rows() {
+    // a heap sort of a copy, moving the worst row to the end each time
+    double *values = new double[this->size];
+    size_t *rows = new size_t[this->size];
+    memcpy(values, this->values, this->size * sizeof(double));
+    memcpy(rows, this->rows, this->size * sizeof(size_t));
+    for (size_t last = this->size; last > 1; last--) {
+        double value = values[0];
+        size_t row = rows[0];
+        values[0] = values[last - 1];
+        rows[0] = rows[last - 1];
+        values[last - 1] = value;
+        rows[last - 1] = row;
+        sift_down(values, rows, last - 1, 0);
+    }
+    delete[] values;
+    return rows;
+}
+
+TopKRower::~TopKRower() {
+    delete[] this->values;
+    delete[] this->rows;
+}
@@ -0,0 +1,234 @@
+#include "../../include/eau2/dataframe/sort_by.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+#include "../../include/eau2/dataframe/columns/bool_column.h"
+#include "../../include/eau2/dataframe/columns/double_column.h"
+#include "../../include/eau2/dataframe/columns/int_column.h"
+#include "../../include/eau2/dataframe/columns/string_column.h"
+#include "../../include/eau2/dataframe/dataframe.h"
+#include "../../include/eau2/dataframe/merge_sort_thread.h"
+#include "../../include/eau2/dataframe/radix_sort_thread.h"
+
+SortBy::SortBy(DataFrame* df, const size_t* cols, const bool* ascending,
+               size_t numCols)
+    : Object() {
+    assert(df != nullptr);
+    assert(numCols > 0);
+    for (size_t col = 0; col < numCols; col++) {
+        assert(cols[col] < df->ncols());
+    }
+    this->df = df;
+    this->cols = new size_t[numCols];
+    memcpy(this->cols, cols, numCols * sizeof(size_t));
+    this->ascending = new bool[numCols];
+    memcpy(this->ascending, ascending, numCols * sizeof(bool));
+    this->numCols = numCols;
+    this->numThreads = std::thread::hardware_concurrency();
+    this->numThreads = this->numThreads > 0 ? this->numThreads : 1;
+}
+
+SortBy::~SortBy() {
+    delete[] this->cols;
+    delete[] this->ascending;
+}
+
+size_t* SortBy::permutation() {
+    size_t numRows = this->df->nrows();
+    size_t* rows = new size_t[numRows];
+    for (size_t row = 0; row < numRows; row++) {
+        rows[row] = row;
+    }
+    size_t* buffer = new size_t[numRows];
+    // every sort is stable, so the least significant column goes first
+    for (size_t col = this->numCols; col-- > 0;) {
+        Column* column = this->df->columns->get(this->cols[col]);
+        if (column->get_type() == ColType::STRING) {
+            this->merge_sort_(column, this->ascending[col], rows, buffer,
+                              numRows);
+        } else {
+            this->radix_sort_(column, this->ascending[col], rows, buffer,
+                              numRows);
+        }
+    }
+    delete[] buffer;
+    return rows;
+}
+
+DataFrame* SortBy::run() {
+    size_t* rows = this->permutation();
+    DataFrame* result = this->df->gather(rows, this->df->nrows());
+    delete[] rows;
+    return result;
+}
+
+void SortBy::radix_sort_(Column* column, bool ascending, size_t* rows,
+                         size_t* buffer, size_t numRows) {
+    // 0. an unsigned key per row, ordered like the values
+    uint64_t* keys = new uint64_t[numRows];
+    size_t numBytes;
+    switch (column->get_type()) {
+        case ColType::INTEGER: {
+            int* array = static_cast<IntColumn*>(column)->array->array;
+            for (size_t i = 0; i < numRows; i++) {
+                // flipping the sign bit orders negative ints first
+                keys[i] = static_cast<uint32_t>(array[rows[i]]) ^ 0x80000000U;
+            }
+            numBytes = sizeof(uint32_t);
+            break;
+        }
+        case ColType::DOUBLE: {
+            double* array = static_cast<DoubleColumn*>(column)->array->array;
+            for (size_t i = 0; i < numRows; i++) {
+                double value = array[rows[i]];
+                value = value == 0.0 ? 0.0 : value;  // -0.0 sorts as 0.0
+                uint64_t bits;
+                memcpy(&bits, &value, sizeof(bits));
+                // negative doubles are ordered backwards by their bits
+                keys[i] = bits >> 63 ? ~bits : bits | (1ULL << 63);
+            }
+            numBytes = sizeof(uint64_t);
+            break;
+        }
+        default: {
+            bool* array = static_cast<BoolColumn*>(column)->array->array;
+            for (size_t i = 0; i < numRows; i++) {
+                keys[i] = array[rows[i]];
+            }
+            numBytes = 1;
+            break;
+        }
+    }
+    if (!ascending) {
+        uint64_t mask =
+            numBytes == 8 ? UINT64_MAX : (1ULL << (numBytes * 8)) - 1;
+        for (size_t i = 0; i < numRows; i++) {
+            keys[i] ^= mask;
+        }
+    }
+
+    // 1. a stable pass per digit, least significant first
+    size_t numThreads = numRows < PARALLEL_SORT_ROWS ? 1 : this->numThreads;
+    RadixSortThread** threads = new RadixSortThread*[numThreads];
+    Thread** runnable = new Thread*[numThreads];
+    for (size_t i = 0; i < numThreads; i++) {
+        threads[i] = new RadixSortThread(i * numRows / numThreads,
+                                         (i + 1) * numRows / numThreads);
+        runnable[i] = threads[i];
+    }
+    uint64_t* keyBuffer = new uint64_t[numRows];
+    uint64_t* fromKeys = keys;
+    uint64_t* toKeys = keyBuffer;
+    size_t* fromRows = rows;
+    size_t* toRows = buffer;
+    for (size_t shift = 0; shift < numBytes * 8; shift += 8) {
+        for (size_t i = 0; i < numThreads; i++) {
+            threads[i]->keys = fromKeys;
+            threads[i]->rows = fromRows;
+            threads[i]->outKeys = toKeys;
+            threads[i]->outRows = toRows;
+            threads[i]->shift = shift;
+            threads[i]->scatter = false;
+        }
+        SortBy::run_threads_(runnable, numThreads);
+
+        // the offsets of the digits of every thread, in order; a digit
+        // shared by every key leaves the order as it is
+        size_t offset = 0;
+        bool shared = false;
+        for (size_t digit = 0; digit < RADIX_BUCKETS; digit++) {
+            size_t total = 0;
+            for (size_t i = 0; i < numThreads; i++) {
+                size_t count = threads[i]->counts[digit];
+                threads[i]->counts[digit] = offset + total;
+                total += count;
+            }
+            shared = shared || total == numRows;
+            offset += total;
+        }
+        if (shared) {
+            continue;
+        }
+        for (size_t i = 0; i < numThreads; i++) {
+            threads[i]->scatter = true;
+        }
+        SortBy::run_threads_(runnable, numThreads);
+        uint64_t* swapKeys = fromKeys;
+        fromKeys = toKeys;
+        toKeys = swapKeys;
+        size_t* swapRows = fromRows;
+        fromRows = toRows;
+        toRows = swapRows;
+    }
+    if (fromRows != rows) {
+        memcpy(rows, fromRows, numRows * sizeof(size_t));
+    }
+    for (size_t i = 0; i < numThreads; i++) {
+        delete threads[i];
+    }
+    delete[] threads;
+    delete[] runnable;
+    delete[] keys;
+    delete[] keyBuffer;
+}
+
+void SortBy::merge_sort_(Column* column, bool ascending, size_t* rows,
+                         size_t* buffer, size_t numRows) {
+    Object** strings = static_cast<StringColumn*>(column)->array->array;
+    size_t numThreads = numRows < PARALLEL_SORT_ROWS ? 1 : this->numThreads;
+    size_t* bounds = new size_t[numThreads + 1];
+    for (size_t i = 0; i <= numThreads; i++) {
+        bounds[i] = i * numRows / numThreads;
+    }
+    Thread** threads = new Thread*[numThreads];
+
+    // 1. sort a range per thread
+    for (size_t i = 0; i < numThreads; i++) {
+        threads[i] = new MergeSortThread(strings, ascending, rows, buffer,
+                                         bounds[i], bounds[i + 1],
+                                         bounds[i + 1]);
+    }
+    SortBy::run_threads_(threads, numThreads);
+    for (size_t i = 0; i < numThreads; i++) {
+        delete threads[i];
+    }
+
+    // 2. merge pairs of neighboring ranges until one is left
+    size_t numRanges = numThreads;
+    while (numRanges > 1) {
+        size_t numMerges = numRanges / 2;
+        for (size_t i = 0; i < numMerges; i++) {
+            threads[i] = new MergeSortThread(
+                strings, ascending, rows, buffer, bounds[2 * i],
+                bounds[2 * i + 1], bounds[2 * i + 2]);
+        }
+        SortBy::run_threads_(threads, numMerges);
+        for (size_t i = 0; i < numMerges; i++) {
+            delete threads[i];
+        }
+        // the merged ranges, and the last one if it had no pair
+        for (size_t i = 0; i <= numRanges / 2; i++) {
+            bounds[i] = bounds[2 * i < numRanges ? 2 * i : numRanges];
+        }
+        bounds[(numRanges + 1) / 2] = numRows;
+        numRanges = (numRanges + 1) / 2;
+    }
+    delete[] threads;
+    delete[] bounds;
+}
+
+void SortBy::run_threads_(Thread** threads, size_t numThreads) {
+    if (numThreads == 1) {
+        threads[0]->run();
+        return;
+    }
+    for (size_t i = 0; i < numThreads; i++) {
+        threads[i]->start();
+    }
+    for (size_t i = 0; i < numThreads; i++) {
+        threads[i]->join();
+    }
+}
@@ -0,0 +1,230 @@
+#include "../../include/eau2/dataframe/zone_map.h"
+
+#include <cassert>
+#include <cstring>
+#include <limits>
+
+#include "../../include/eau2/dataframe/columns/bool_column.h"
+#include "../../include/eau2/dataframe/columns/double_column.h"
+#include "../../include/eau2/dataframe/columns/int_column.h"
+#include "../../include/eau2/dataframe/columns/string_column.h"
+#include "../../include/eau2/serialization/deserializer.h"
+#include "../../include/eau2/serialization/serializer.h"
+#include "../../include/eau2/sorer/predicate.h"
+
+// the doubles serialized before the zones
+#define ZONE_MAP_HEADER 3
+// the doubles serialized per zone
+#define ZONE_DOUBLES 4
+
+ZoneMap::ZoneMap(ColType type, size_t zoneRows) : Object() {
+    assert(zoneRows > 0);
+    this->type = type;
+    this->zoneRows = zoneRows;
+    this->numZones = 0;
+    this->capacity = 4;
+    this->minimums = new double[this->capacity];
+    this->maximums = new double[this->capacity];
+    this->missing = new size_t[this->capacity];
+    this->counts = new size_t[this->capacity];
+    this->numRows = 0;
+}
+
+ZoneMap::~ZoneMap() {
+    delete[] this->minimums;
+    delete[] this->maximums;
+    delete[] this->missing;
+    delete[] this->counts;
+}
+
+void ZoneMap::append(Column* column, size_t begin, size_t end) {
+    assert(column != nullptr);
+    assert(column->get_type() == this->type);
+    assert(begin <= end && end <= column->size());
+    size_t row = begin;
+    while (row < end) {
+        if (this->numZones == 0 ||
+            this->counts[this->numZones - 1] == this->zoneRows) {
+            this->add_zone_();
+        }
+        // the rows of the range that fit in the last zone
+        size_t zone = this->numZones - 1;
+        size_t stop = row + (this->zoneRows - this->counts[zone]);
+        stop = stop < end ? stop : end;
+        switch (this->type) {
+            case ColType::INTEGER: {
+                const int* values = column->as_int()->array->array;
+                for (size_t i = row; i < stop; i++) {
+                    this->bound_(zone, values[i]);
+                }
+                break;
+            }
+            case ColType::DOUBLE: {
+                const double* values = column->as_double()->array->array;
+                for (size_t i = row; i < stop; i++) {
+                    if (values[i] == values[i]) {
+                        this->bound_(zone, values[i]);
+                    }
+                }
+                break;
+            }
+            case ColType::BOOLEAN: {
+                const bool* values = column->as_bool()->array->array;
+                for (size_t i = row; i < stop; i++) {
+                    this->bound_(zone, values[i]);
+                }
+                break;
+            }
+            default:
+                for (size_t i = row; i < stop; i++) {
+                    this->missing[zone] += column->get_string(i) == nullptr;
+                }
+                break;
+        }
+        this->counts[zone] += stop - row;
+        this->numRows += stop - row;
+        row = stop;
+    }
+}
+
+void ZoneMap::extend(Column* column) {
+    assert(column != nullptr);
+    if (this->numRows > column->size()) {
+        this->truncate(column->size());
+    }
+    this->append(column, this->numRows, column->size());
+}
+
+void ZoneMap::add_zone(Column* column) {
+    assert(column != nullptr);
+    this->add_zone_();
+    size_t zoneRows = this->zoneRows;
+    // a zone as large as the column, so the rows are not split
+    this->zoneRows = column->size() == 0 ? 1 : column->size();
+    this->append(column, 0, column->size());
+    this->zoneRows = zoneRows;
+}
+
+void ZoneMap::widen(size_t row, double value) {
+    if (row >= this->numRows || value != value) {
+        return;
+    }
+    this->bound_(row / this->zoneRows, value);
+}
+
+void ZoneMap::set_missing(size_t row, bool before, bool after) {
+    if (row >= this->numRows) {
+        return;
+    }
+    size_t zone = row / this->zoneRows;
+    this->missing[zone] += after;
+    this->missing[zone] -= before;
+}
+
+void ZoneMap::truncate(size_t numRows) {
+    if (numRows >= this->numRows) {
+        return;
+    }
+    this->numZones = numRows / this->zoneRows;
+    this->numRows = this->numZones * this->zoneRows;
+}
+
+bool ZoneMap::may_match(Condition* condition, size_t zone) {
+    assert(condition != nullptr);
+    assert(zone < this->numZones);
+    return condition->may_match(this->type, this->minimums[zone],
+                                this->maximums[zone], this->missing[zone],
+                                this->counts[zone]);
+}
+
+bool ZoneMap::may_match(Condition* condition, size_t begin, size_t end) {
+    if (end > this->numRows) {
+        // rows this map does not know of may match anything
+        return true;
+    }
+    for (size_t row = begin; row < end;
+         row = (row / this->zoneRows + 1) * this->zoneRows) {
+        if (this->may_match(condition, row / this->zoneRows)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+byte* ZoneMap::serialize() {
+    size_t size = ZONE_MAP_HEADER + ZONE_DOUBLES * this->numZones;
+    double* array = new double[size];
+    array[0] = static_cast<double>(this->type);
+    array[1] = this->zoneRows;
+    array[2] = this->numZones;
+    for (size_t zone = 0; zone < this->numZones; zone++) {
+        double* stats = array + ZONE_MAP_HEADER + ZONE_DOUBLES * zone;
+        stats[0] = this->minimums[zone];
+        stats[1] = this->maximums[zone];
+        stats[2] = this->missing[zone];
+        stats[3] = this->counts[zone];
+    }
+    byte* bytes = Serializer::serialize_double_array(array, size);
+    delete[] array;
+    return bytes;
+}
+
+ZoneMap* ZoneMap::deserialize(byte* bytes) {
+    size_t size = Deserializer::array_size(bytes);
+    assert(size >= ZONE_MAP_HEADER);
+    double* array = Deserializer::deserialize_double_array(bytes);
+    ZoneMap* map = new ZoneMap(static_cast<ColType>(array[0]),
+                               static_cast<size_t>(array[1]));
+    size_t numZones = static_cast<size_t>(array[2]);
+    assert(size == ZONE_MAP_HEADER + ZONE_DOUBLES * numZones);
+    const double* zones = array + ZONE_MAP_HEADER;
+    for (size_t zone = 0; zone < numZones; zone++) {
+        map->add_zone_();
+        const double* stats = zones + ZONE_DOUBLES * zone;
+        map->minimums[zone] = stats[0];
+        map->maximums[zone] = stats[1];
+        map->missing[zone] = static_cast<size_t>(stats[2]);
+        map->counts[zone] = static_cast<size_t>(stats[3]);
+        map->numRows += map->counts[zone];
+    }
+    delete[] array;
+    return map;
+}
+
+void ZoneMap::add_zone_() {
+    if (this->numZones == this->capacity) {
+        size_t capacity = this->capacity * 2;
+        double* minimums = new double[capacity];
+        double* maximums = new double[capacity];
+        size_t* missing = new size_t[capacity];
+        size_t* counts = new size_t[capacity];
+        memcpy(minimums, this->minimums, this->numZones * sizeof(double));
+        memcpy(maximums, this->maximums, this->numZones * sizeof(double));
+        memcpy(missing, this->missing, this->numZones * sizeof(size_t));
+        memcpy(counts, this->counts, this->numZones * sizeof(size_t));
+        delete[] this->minimums;
+        delete[] this->maximums;
+        delete[] this->missing;
+        delete[] this->counts;
+        this->minimums = minimums;
+        this->maximums = maximums;
+        this->missing = missing;
+        this->counts = counts;
+        this->capacity = capacity;
+    }
+    // empty bounds, which no value falls between
+    this->minimums[this->numZones] = std::numeric_limits<double>::infinity();
+    this->maximums[this->numZones] = -std::numeric_limits<double>::infinity();
+    this->missing[this->numZones] = 0;
+    this->counts[this->numZones] = 0;
+    this->numZones++;
+}
+
+void ZoneMap::bound_(size_t zone, double value) {
+    if (value < this->minimums[zone]) {
+        this->minimums[zone] = value;
+    }
+    if (value > this->maximums[zone]) {
+        this->maximums[zone] = value;
+    }
+}
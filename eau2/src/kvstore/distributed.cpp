@@ -0,0 +1,176 @@
+#include "../../include/eau2/kvstore/distributed.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#include "../../include/eau2/dataframe/dataframe.h"
+#include "../../include/eau2/kvstore/kvstore.h"
+#include "../../include/eau2/kvstore/reduce_thread.h"
+#include "../../include/eau2/serialization/serializer.h"
+#include "../../include/eau2/sorer/chunk_stream.h"
+
+// returns a new cstring of the given name and suffix, the prefix of the keys
+// of the pieces of a shuffle
+static char* shuffle_prefix(const char* name, const char* suffix) {
+    size_t length = strlen(name) + strlen(suffix) + 1;
+    char* prefix = new char[length];
+    snprintf(prefix, length, "%s%s", name, suffix);
+    return prefix;
+}
+
+Distributed::Distributed(KVStore* kv, const char* result, Shuffle* left,
+                         Shuffle* right)
+    : Object() {
+    assert(kv != nullptr && result != nullptr && left != nullptr);
+    assert(right == nullptr || (right->numPartitions == left->numPartitions &&
+                                right->numKeys == left->numKeys));
+    this->kv = kv;
+    this->result = duplicate(result);
+    this->left = left;
+    this->right = right;
+    this->ops = nullptr;
+    this->cols = nullptr;
+    this->numAggs = 0;
+    this->type = JoinType::INNER;
+    // the nodes share the cores of this machine
+    this->threadsPerNode = std::thread::hardware_concurrency() / kv->num_nodes;
+    this->threadsPerNode = this->threadsPerNode > 0 ? this->threadsPerNode : 1;
+    this->partitionRows = new size_t[left->numPartitions]();
+    this->resultTypes = nullptr;
+    this->numResultCols = 0;
+}
+
+Distributed::~Distributed() {
+    delete[] this->result;
+    delete this->left;
+    delete this->right;
+    delete[] this->partitionRows;
+    delete[] this->resultTypes;
+}
+
+bool Distributed::group_by(KVStore* kv, const char* name, const size_t* keys,
+                           size_t numKeys, const AggOp* ops,
+                           const size_t* cols, size_t numAggs,
+                           const char* result, size_t nodeBudget) {
+    if (kv->get_bytes(Key(name, 0)) == nullptr) {
+        return false;
+    }
+    size_t numPartitions = Distributed::num_partitions(
+        Shuffle::frame_bytes(kv, name), kv->num_nodes, nodeBudget);
+    char* prefix = shuffle_prefix(result, ".shuffle");
+    Shuffle* shuffle =
+        new Shuffle(kv, name, prefix, keys, numKeys, numPartitions);
+    delete[] prefix;
+    Distributed job(kv, result, shuffle, nullptr);
+    job.ops = ops;
+    job.cols = cols;
+    job.numAggs = numAggs;
+    job.run();
+    return true;
+}
+
+bool Distributed::join(KVStore* kv, const char* left, const char* right,
+                       const size_t* leftKeys, const size_t* rightKeys,
+                       size_t numKeys, JoinType type, const char* result,
+                       size_t nodeBudget) {
+    if (kv->get_bytes(Key(left, 0)) == nullptr ||
+        kv->get_bytes(Key(right, 0)) == nullptr) {
+        return false;
+    }
+    // both sides of a partition are loaded together
+    size_t bytes =
+        Shuffle::frame_bytes(kv, left) + Shuffle::frame_bytes(kv, right);
+    size_t numPartitions =
+        Distributed::num_partitions(bytes, kv->num_nodes, nodeBudget);
+    char* leftPrefix = shuffle_prefix(result, ".left");
+    char* rightPrefix = shuffle_prefix(result, ".right");
+    Shuffle* leftShuffle = new Shuffle(kv, left, leftPrefix, leftKeys,
+                                       numKeys, numPartitions);
+    Shuffle* rightShuffle = new Shuffle(kv, right, rightPrefix, rightKeys,
+                                        numKeys, numPartitions);
+    delete[] leftPrefix;
+    delete[] rightPrefix;
+    Distributed job(kv, result, leftShuffle, rightShuffle);
+    job.type = type;
+    job.run();
+    return true;
+}
+
+size_t Distributed::num_partitions(size_t bytes, size_t numNodes,
+                                   size_t nodeBudget) {
+    size_t perNode = 1;
+    while (nodeBudget > 0 && bytes > nodeBudget * numNodes * perNode) {
+        perNode *= 2;
+    }
+    return numNodes * perNode;
+}
+
+void Distributed::run() {
+    // 0. shuffle the rows to the owners of their partitions
+    this->left->run();
+    if (this->right != nullptr) {
+        this->right->run();
+    }
+
+    // 1. reduce the partitions, every node in parallel
+    size_t numNodes = this->kv->num_nodes;
+    ReduceThread** threads = new ReduceThread*[numNodes];
+    for (size_t node = 0; node < numNodes; node++) {
+        threads[node] = new ReduceThread(this, node);
+        threads[node]->start();
+    }
+    for (size_t node = 0; node < numNodes; node++) {
+        threads[node]->join();
+        delete threads[node];
+    }
+    delete[] threads;
+
+    // 2. the metadata of the result, one chunk per partition
+    size_t numRows = 0;
+    for (size_t p = 0; p < this->left->numPartitions; p++) {
+        numRows += this->partitionRows[p];
+    }
+    // the chunks hold any number of rows
+    this->kv->put_owned(new Key(true, duplicate(this->result), 0),
+                        ChunkStream::serialize_metadata(
+                            numRows, 0, this->left->numPartitions,
+                            this->resultTypes, this->numResultCols));
+}
+
+DataFrame* Distributed::reduce(size_t partition) {
+    DataFrame* df = this->left->load(partition);
+    DataFrame* result;
+    if (this->right == nullptr) {
+        GroupBy groupBy(df, this->left->keys, this->left->numKeys);
+        groupBy.numThreads = this->threadsPerNode;
+        result = groupBy.agg(this->ops, this->cols, this->numAggs);
+    } else {
+        DataFrame* other = this->right->load(partition);
+        HashJoin join(df, other, this->left->keys, this->right->keys,
+                      this->left->numKeys, this->type);
+        join.numThreads = this->threadsPerNode;
+        result = join.run();
+        delete other;
+    }
+    delete df;
+    return result;
+}
+
+void Distributed::store(size_t partition, DataFrame* df) {
+    for (size_t col = 0; col < df->ncols(); col++) {
+        this->kv->put_owned(
+            ChunkStream::chunk_key(this->kv, this->result, col, partition),
+            Serializer::serialize_column(df->columns->get(col)));
+    }
+    this->partitionRows[partition] = df->nrows();
+    if (partition == 0) {
+        // every partition has the same columns
+        this->numResultCols = df->ncols();
+        this->resultTypes = new ColType[this->numResultCols];
+        for (size_t col = 0; col < this->numResultCols; col++) {
+            this->resultTypes[col] = df->columns->get(col)->get_type();
+        }
+    }
+}
@@ -1,8 +1,43 @@
 #include "../../include/eau2/kvstore/key.h"
 
+#include <cassert>
+#include <cstring>
+
 Key::Key(const char *key, size_t nodeId) : Object() {
     this->key = key;
     this->nodeId = nodeId;
+    this->owned = false;
+}
+
+Key::Key(bool steal, char *key, size_t nodeId) : Object() {
+    assert(steal && key != nullptr);
+    this->key = key;
+    this->nodeId = nodeId;
+    this->owned = true;
+}
+
+bool Key::equals(Object *o) {
+    if (o == this) {
+        return true;
+    }
+    Key *other = dynamic_cast<Key *>(o);
+    if (other == nullptr) {
+        return false;
+    }
+    return this->nodeId == other->nodeId && strcmp(this->key, other->key) == 0;
+}
+
+size_t Key::hash_me() {
+    size_t hash = this->nodeId;
+    for (size_t i = 0; this->key[i] != '\0'; ++i) {
+        hash = this->key[i] + (hash << 6) + (hash << 16) - hash;
+    }
+    // Object::hash() treats 0 as "not computed yet"
+    return hash == 0 ? 1 : hash;
 }
 
-Key::~Key() {}
\ No newline at end of file
+Key::~Key() {
+    if (this->owned) {
+        delete[] this->key;
+    }
+}
\ No newline at end of file
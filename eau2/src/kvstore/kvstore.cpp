@@ -1,6 +1,16 @@
 #include "../../include/eau2/kvstore/kvstore.h"
 
+#include <unistd.h>
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+
+#include "../../include/eau2/kvstore/snapshot.h"
+#include "../../include/eau2/serialization/deserializer.h"
+
 FakeNode::FakeNode(size_t nodeId, Lock* lock) {
+    this->store = new ByteMap();
     this->nodeId = nodeId;
     this->lock = lock;
 }
@@ -15,7 +25,21 @@ byte* FakeNode::request_data(Key* key) {
 }
 
 KVStore::KVStore() {
-    this->map = map;
+    this->map = new ByteMap();
+    this->wal = nullptr;
+    this->snapshotPath = nullptr;
+    this->snapshotEvery = 0;
+    this->ownedKeys = new Array();
+    this->segments = nullptr;
+    this->putToSegments = false;
+    this->memoryBudget = 0;
+    this->activeReaders = 0;
+    this->retired = nullptr;
+    this->numRetired = 0;
+    this->retiredCapacity = 0;
+    this->activeCopies = 0;
+    this->evicting = false;
+    this->snapshotting = false;
     // init network here; or fake KVStores
 
     this->fake_nodes = new FakeNode*[this->num_nodes];
@@ -31,15 +55,165 @@ KVStore::KVStore() {
     }
 }
 
-void KVStore::put(Key* key, byte* value) { this->map->set(key, value); }
+size_t KVStore::put(Key* key, byte* value) {
+    size_t segment = NO_SEGMENT;
+    size_t offset = 0;
+    byte* view = nullptr;
+    if (this->putToSegments) {
+        // copied before locking the map so readers are not held up
+        view = this->segments->append(value, &segment, &offset);
+    }
+    this->mapLock.lock();
+    size_t version = this->map->set(key, value);
+    if (view != nullptr) {
+        this->map->relocate(this->map->entry(key), view, segment, offset);
+    }
+    // logged under the lock so records of a key are in version order; the
+    // log is only written to disk once the lock is released
+    bool commitDue =
+        this->wal != nullptr && this->wal->append(key, value, version);
+    bool overBudget = this->memoryBudget > 0 &&
+                      this->map->heap_bytes() > this->memoryBudget;
+    bool snapshotDue = this->wal != nullptr && this->snapshotEvery > 0 &&
+                       this->wal->length() >= this->snapshotEvery;
+    this->mapLock.unlock();
+    if (view != nullptr) {
+        delete[] value;
+    }
+    this->finish_put_(commitDue, overBudget, snapshotDue);
+    return version;
+}
+
+size_t KVStore::put_owned(Key* key, byte* value) {
+    size_t version = this->put(key, value);
+    this->mapLock.lock();
+    if (version == 1) {
+        this->ownedKeys->append(key);
+    } else {
+        // the map keeps the key of the first version
+        delete key;
+    }
+    this->mapLock.unlock();
+    return version;
+}
+
+bool KVStore::put_if_version(Key* key, byte* value, size_t expected) {
+    size_t segment = NO_SEGMENT;
+    size_t offset = 0;
+    byte* view = nullptr;
+    if (this->putToSegments) {
+        // the space of a value that loses the race is not reclaimed
+        view = this->segments->append(value, &segment, &offset);
+    }
+    this->mapLock.lock();
+    bool stored = this->map->set_if_version(key, value, expected);
+    if (stored && view != nullptr) {
+        this->map->relocate(this->map->entry(key), view, segment, offset);
+    }
+    bool commitDue = stored && this->wal != nullptr &&
+                     this->wal->append(key, value, expected + 1);
+    bool overBudget = stored && this->memoryBudget > 0 &&
+                      this->map->heap_bytes() > this->memoryBudget;
+    bool snapshotDue = this->wal != nullptr && this->snapshotEvery > 0 &&
+                       this->wal->length() >= this->snapshotEvery;
+    this->mapLock.unlock();
+    if (stored && view != nullptr) {
+        delete[] value;
+    }
+    this->finish_put_(commitDue, overBudget, snapshotDue);
+    return stored;
+}
+
+void KVStore::finish_put_(bool commitDue, bool overBudget,
+                          bool snapshotDue) {
+    if (commitDue) {
+        this->wal->commit();
+    }
+    if (overBudget) {
+        this->enforce_budget();
+    }
+    if (snapshotDue) {
+        this->snapshot();
+    }
+}
+
+size_t KVStore::version(Key key) {
+    this->mapLock.lock();
+    size_t version = this->map->version(&key);
+    this->mapLock.unlock();
+    return version;
+}
+
+size_t KVStore::prune(Key key, size_t version) {
+    this->mapLock.lock();
+    // the versions being deleted may be copied by a snapshot or an eviction
+    while (this->activeCopies > 0) {
+        this->mapLock.wait();
+    }
+    size_t pruned = this->map->prune(&key, version);
+    this->mapLock.unlock();
+    return pruned;
+}
 
 DataFrame* KVStore::get(Key key) {
+    this->mapLock.lock();
+    byte* bytes = this->map->get(&key);
+    this->activeReaders++;
+    this->mapLock.unlock();
+    // the value is immutable once published, so it is decoded unlocked
+    DataFrame* df = bytes == nullptr ? nullptr : DataFrame::fromBytes(bytes);
+    this->release();
+    return df;
+}
+
+DataFrame* KVStore::get(Key key, size_t version) {
+    this->mapLock.lock();
+    byte* bytes = this->map->get_version(&key, version);
+    this->activeReaders++;
+    this->mapLock.unlock();
+    DataFrame* df = bytes == nullptr ? nullptr : DataFrame::fromBytes(bytes);
+    this->release();
+    return df;
+}
+
+Column* KVStore::get_column(Key key) {
+    this->mapLock.lock();
+    byte* bytes = this->map->get(&key);
+    this->activeReaders++;
+    this->mapLock.unlock();
+    Column* column =
+        bytes == nullptr ? nullptr : Deserializer::deserialize_column(bytes);
+    this->release();
+    return column;
+}
+
+byte* KVStore::get_bytes(Key key) {
+    this->mapLock.lock();
     byte* bytes = this->map->get(&key);
-    return DataFrame::fromBytes(bytes);
+    this->mapLock.unlock();
+    return bytes;
+}
+
+byte* KVStore::get_bytes(Key key, size_t version) {
+    this->mapLock.lock();
+    byte* bytes = this->map->get_version(&key, version);
+    this->mapLock.unlock();
+    return bytes;
+}
+
+size_t KVStore::value_bytes(Key key) {
+    this->mapLock.lock();
+    byte* bytes = this->map->get(&key);
+    size_t numBytes = bytes == nullptr ? 0 : Deserializer::num_bytes(bytes);
+    this->mapLock.unlock();
+    return numBytes;
 }
 
 DataFrame* KVStore::wait_and_get(Key key) {
+    this->mapLock.lock();
     byte* local_bytes = this->map->get(&key);
+    this->activeReaders++;
+    this->mapLock.unlock();
     byte** remote_bytes = new byte*[num_nodes];
     // 1. check every node for serialized objects with the given key
     for (size_t i = 0; i < this->num_nodes; i++) {
@@ -51,8 +225,253 @@ DataFrame* KVStore::wait_and_get(Key key) {
     }
 
     // 2. merge all objects in one DataFrame and return
-    return DataFrame::merge(local_bytes, remote_bytes, num_nodes);
+    DataFrame* df = DataFrame::merge(local_bytes, remote_bytes, num_nodes);
+    this->release();
+    return df;
+}
+
+void KVStore::set_memory_budget(size_t maxBytes, const char* spillDirectory) {
+    this->mapLock.lock();
+    if (this->segments == nullptr) {
+        this->segments = new SegmentStore(spillDirectory, DEFAULT_SEGMENT_SIZE);
+    }
+    this->memoryBudget = maxBytes;
+    this->mapLock.unlock();
+    this->enforce_budget();
+}
+
+size_t KVStore::resident_bytes() {
+    this->mapLock.lock();
+    size_t bytes = this->map->heap_bytes();
+    this->mapLock.unlock();
+    return bytes;
+}
+
+void KVStore::enforce_budget() {
+    this->mapLock.lock();
+    bool overBudget = this->memoryBudget > 0 &&
+                      this->map->heap_bytes() > this->memoryBudget;
+    size_t targetBytes = this->memoryBudget * EVICTION_WATERMARK;
+    this->mapLock.unlock();
+    if (overBudget) {
+        // evict below the budget so a burst of puts does not evict on
+        // every put
+        this->evict(targetBytes);
+    }
+}
+
+// a value on the heap picked for eviction, as it was when picked, and the
+// location of its copy in a segment
+struct Victim {
+    KeyValueBytes* pair;
+    byte* value;
+    size_t length;
+    size_t lastAccess;
+    byte* view;
+    size_t segment;
+    size_t offset;
+};
+
+// orders victims by their last access, least recently used first
+static int compare_access(const void* a, const void* b) {
+    size_t first = static_cast<const Victim*>(a)->lastAccess;
+    size_t second = static_cast<const Victim*>(b)->lastAccess;
+    return first < second ? -1 : first > second ? 1 : 0;
+}
+
+size_t KVStore::evict(size_t targetBytes) {
+    // 0. the values on the heap, picked under the lock; a single eviction
+    // runs at a time and prune() waits for it, so the pairs stay alive
+    this->mapLock.lock();
+    size_t heapBytes = this->map->heap_bytes();
+    if (this->evicting || heapBytes <= targetBytes) {
+        this->mapLock.unlock();
+        return 0;
+    }
+    this->evicting = true;
+    this->activeCopies++;
+    size_t count;
+    KeyValueBytes** items = this->map->getHeapItems(&count);
+    Victim* victims = new Victim[count];
+    for (size_t i = 0; i < count; i++) {
+        victims[i].pair = items[i];
+        victims[i].value = items[i]->getValue();
+        victims[i].length = items[i]->length;
+        victims[i].lastAccess = items[i]->lastAccess;
+    }
+    this->mapLock.unlock();
+    delete[] items;
+
+    // 1. the least recently used values, copied into segments unlocked
+    qsort(victims, count, sizeof(Victim), compare_access);
+    size_t evicted = 0;
+    for (; evicted < count && heapBytes > targetBytes; evicted++) {
+        Victim* victim = victims + evicted;
+        victim->view = this->segments->append(victim->value, &victim->segment,
+                                              &victim->offset);
+        heapBytes -= victim->length;
+    }
+
+    // 2. the pairs switched to the copies; the heap values are freed once
+    // no get is decoding them
+    this->mapLock.lock();
+    for (size_t i = 0; i < evicted; i++) {
+        this->map->relocate(victims[i].pair, victims[i].view,
+                            victims[i].segment, victims[i].offset);
+        this->retire(victims[i].value);
+    }
+    this->evicting = false;
+    this->activeCopies--;
+    this->mapLock.notify_all();
+    this->mapLock.unlock();
+    delete[] victims;
+    return evicted;
+}
+
+void KVStore::retire(byte* value) {
+    if (this->activeReaders == 0) {
+        delete[] value;
+        return;
+    }
+    if (this->numRetired == this->retiredCapacity) {
+        size_t newCapacity = this->retiredCapacity * 2 + 16;
+        byte** newRetired = new byte*[newCapacity];
+        if (this->numRetired > 0) {
+            memcpy(newRetired, this->retired,
+                   this->numRetired * sizeof(byte*));
+        }
+        delete[] this->retired;
+        this->retired = newRetired;
+        this->retiredCapacity = newCapacity;
+    }
+    this->retired[this->numRetired] = value;
+    this->numRetired++;
+}
+
+void KVStore::release() {
+    this->mapLock.lock();
+    this->activeReaders--;
+    if (this->activeReaders == 0) {
+        for (size_t i = 0; i < this->numRetired; i++) {
+            delete[] this->retired[i];
+        }
+        this->numRetired = 0;
+    }
+    this->mapLock.unlock();
+}
+
+// returns a new cstring made of the given prefix and suffix
+static char* concat(const char* prefix, const char* suffix) {
+    size_t prefixLength = strlen(prefix);
+    size_t suffixLength = strlen(suffix);
+    char* result = new char[prefixLength + suffixLength + 1];
+    memcpy(result, prefix, prefixLength);
+    memcpy(result + prefixLength, suffix, suffixLength + 1);
+    return result;
+}
+
+size_t KVStore::enable_durability(const char* path, size_t snapshotEvery,
+                                  size_t groupBytes) {
+    assert(this->wal == nullptr);
+    char* logPath = concat(path, ".wal");
+    this->snapshotPath = concat(path, ".snap");
+    this->snapshotEvery = snapshotEvery;
+    this->mapLock.lock();
+    size_t recovered =
+        Snapshot::load(this->snapshotPath, this->map, this->ownedKeys);
+    this->wal = new WriteAheadLog(logPath, groupBytes);
+    // a log set aside by a snapshot that did not complete comes first
+    bool rotated = access(this->wal->rotatedPath, F_OK) == 0;
+    recovered += WriteAheadLog::replay(this->wal->rotatedPath, this->map,
+                                       this->ownedKeys);
+    recovered += WriteAheadLog::replay(logPath, this->map, this->ownedKeys);
+    if (rotated) {
+        // compacted now, as the next snapshot sets the current log aside
+        KeyValueBytes** items = this->map->getItems();
+        if (Snapshot::write(this->snapshotPath, items, this->map->length()) &&
+            this->wal->reset()) {
+            this->wal->discard_rotated();
+        }
+        delete[] items;
+    }
+    this->mapLock.unlock();
+    this->enforce_budget();
+    delete[] logPath;
+    return recovered;
+}
+
+void KVStore::enable_segments(const char* directory, size_t segmentSize) {
+    assert(!this->putToSegments);
+    this->mapLock.lock();
+    if (this->segments == nullptr) {
+        this->segments = new SegmentStore(directory, segmentSize);
+    }
+    this->putToSegments = true;
+    this->mapLock.unlock();
+}
+
+bool KVStore::sync() {
+    return this->wal == nullptr || this->wal->commit();
+}
+
+bool KVStore::snapshot() {
+    if (this->wal == nullptr) {
+        return false;
+    }
+    this->mapLock.lock();
+    if (this->snapshotting) {
+        this->mapLock.unlock();
+        return false;
+    }
+    this->snapshotting = true;
+    this->mapLock.unlock();
+
+    // 0. the log so far is set aside; the puts from then on go to a new log
+    bool rotated = this->wal->rotate();
+
+    // 1. the latest version of every key, taken under the lock; the values
+    // are neither freed by an eviction nor deleted by prune() until written
+    this->mapLock.lock();
+    size_t numRecords = this->map->length();
+    KeyValueBytes** items = this->map->getItems();
+    for (size_t i = 0; i < numRecords; i++) {
+        items[i] = new KeyValueBytes(items[i]->getKey(), items[i]->getValue(),
+                                     items[i]->version, nullptr);
+    }
+    this->activeReaders++;
+    this->activeCopies++;
+    this->mapLock.unlock();
+
+    // 2. the snapshot is written unlocked; a crash before the log set aside
+    // is deleted replays records the snapshot already has, which restoring
+    // ignores by version
+    bool written = Snapshot::write(this->snapshotPath, items, numRecords);
+    if (written && rotated) {
+        this->wal->discard_rotated();
+    }
+    for (size_t i = 0; i < numRecords; i++) {
+        delete items[i];
+    }
+    delete[] items;
+    this->release();
+    this->mapLock.lock();
+    this->activeCopies--;
+    this->snapshotting = false;
+    this->mapLock.notify_all();
+    this->mapLock.unlock();
+    return written;
 }
 
 // destructor
-KVStore::~KVStore() { delete this->map; }
+KVStore::~KVStore() {
+    delete this->wal;
+    delete[] this->snapshotPath;
+    delete this->map;
+    delete this->ownedKeys;
+    for (size_t i = 0; i < this->numRetired; i++) {
+        delete[] this->retired[i];
+    }
+    delete[] this->retired;
+    // the map holds views into the segments, so they are unmapped last
+    delete this->segments;
+}
@@ -0,0 +1,23 @@
+#include "../../include/eau2/kvstore/reduce_thread.h"
+
+#include <cassert>
+
+#include "../../include/eau2/dataframe/dataframe.h"
+#include "../../include/eau2/kvstore/kvstore.h"
+
+ReduceThread::ReduceThread(Distributed *job, size_t node) : Thread() {
+    assert(job != nullptr);
+    this->job = job;
+    this->node = node;
+}
+
+void ReduceThread::run() {
+    size_t numNodes = this->job->kv->num_nodes;
+    for (size_t partition = this->node;
+         partition < this->job->left->numPartitions;
+         partition += numNodes) {
+        DataFrame *df = this->job->reduce(partition);
+        this->job->store(partition, df);
+        delete df;
+    }
+}
@@ -0,0 +1,109 @@
+#include "../../include/eau2/kvstore/segment_store.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "../../include/eau2/serialization/deserializer.h"
+
+SegmentStore::SegmentStore(const char* directory, size_t segmentSize)
+    : Object() {
+    assert(directory != nullptr);
+    assert(segmentSize > 0);
+    this->directory = duplicate(directory);
+    this->segmentSize = segmentSize;
+    this->capacity = 16;
+    this->segments = new byte*[this->capacity];
+    this->sizes = new size_t[this->capacity];
+    this->numSegments = 0;
+    this->current = NO_SEGMENT;
+    this->used = 0;
+}
+
+SegmentStore::~SegmentStore() {
+    for (size_t i = 0; i < this->numSegments; i++) {
+        munmap(this->segments[i], this->sizes[i]);
+    }
+    delete[] this->segments;
+    delete[] this->sizes;
+    delete[] this->directory;
+}
+
+byte* SegmentStore::append(byte* value, size_t* segment, size_t* offset) {
+    size_t numBytes = Deserializer::num_bytes(value);
+    this->lock.lock();
+    if (numBytes > this->segmentSize) {
+        // an oversized value gets a segment of its own, the current segment
+        // keeps being filled
+        this->add_segment(numBytes);
+        *segment = this->numSegments - 1;
+        *offset = 0;
+    } else {
+        if (this->current == NO_SEGMENT ||
+            this->used + numBytes > this->sizes[this->current]) {
+            this->add_segment(this->segmentSize);
+            this->current = this->numSegments - 1;
+            this->used = 0;
+        }
+        *segment = this->current;
+        *offset = this->used;
+        this->used += numBytes;
+    }
+    byte* destination = this->segments[*segment] + *offset;
+    this->lock.unlock();
+    // the space is reserved, so the copy does not need the lock
+    memcpy(destination, value, numBytes);
+    return destination;
+}
+
+byte* SegmentStore::view(size_t segment, size_t offset) {
+    assert(segment < this->numSegments);
+    assert(offset < this->sizes[segment]);
+    return this->segments[segment] + offset;
+}
+
+size_t SegmentStore::mapped_bytes() {
+    size_t total = 0;
+    for (size_t i = 0; i < this->numSegments; i++) {
+        total += this->sizes[i];
+    }
+    return total;
+}
+
+void SegmentStore::add_segment(size_t size) {
+    if (this->numSegments == this->capacity) {
+        size_t newCapacity = this->capacity * 2;
+        byte** newSegments = new byte*[newCapacity];
+        size_t* newSizes = new size_t[newCapacity];
+        memcpy(newSegments, this->segments, this->numSegments * sizeof(byte*));
+        memcpy(newSizes, this->sizes, this->numSegments * sizeof(size_t));
+        delete[] this->segments;
+        delete[] this->sizes;
+        this->segments = newSegments;
+        this->sizes = newSizes;
+        this->capacity = newCapacity;
+    }
+    size_t pageSize = sysconf(_SC_PAGESIZE);
+    size = (size + pageSize - 1) / pageSize * pageSize;
+    size_t pathLength = strlen(this->directory) + 32;
+    char* path = new char[pathLength];
+    snprintf(path, pathLength, "%s/segmentXXXXXX", this->directory);
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    int result = ftruncate(fd, size);
+    assert(result == 0);
+    void* mapping =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    assert(mapping != MAP_FAILED);
+    // the mapping keeps the file alive; nothing is left behind on exit
+    unlink(path);
+    close(fd);
+    delete[] path;
+    this->segments[this->numSegments] = static_cast<byte*>(mapping);
+    this->sizes[this->numSegments] = size;
+    this->numSegments++;
+}
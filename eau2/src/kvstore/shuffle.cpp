@@ -0,0 +1,242 @@
+#include "../../include/eau2/kvstore/shuffle.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+#include "../../include/eau2/dataframe/columns/bool_column.h"
+#include "../../include/eau2/dataframe/columns/double_column.h"
+#include "../../include/eau2/dataframe/columns/int_column.h"
+#include "../../include/eau2/dataframe/columns/string_column.h"
+#include "../../include/eau2/dataframe/dataframe.h"
+#include "../../include/eau2/dataframe/row_keys.h"
+#include "../../include/eau2/kvstore/kvstore.h"
+#include "../../include/eau2/kvstore/shuffle_thread.h"
+#include "../../include/eau2/serialization/serializer.h"
+#include "../../include/eau2/sorer/chunk_stream.h"
+
+// returns the serialized values of the given column at the given rows
+static byte* serialize_rows(Column* column, const size_t* rows,
+                            size_t numRows) {
+    switch (column->get_type()) {
+        case ColType::INTEGER: {
+            int* array = static_cast<IntColumn*>(column)->array->array;
+            int* values = new int[numRows];
+            for (size_t i = 0; i < numRows; i++) {
+                values[i] = array[rows[i]];
+            }
+            byte* bytes = Serializer::serialize_int_array(values, numRows);
+            delete[] values;
+            return bytes;
+        }
+        case ColType::DOUBLE: {
+            double* array = static_cast<DoubleColumn*>(column)->array->array;
+            double* values = new double[numRows];
+            for (size_t i = 0; i < numRows; i++) {
+                values[i] = array[rows[i]];
+            }
+            byte* bytes = Serializer::serialize_double_array(values, numRows);
+            delete[] values;
+            return bytes;
+        }
+        case ColType::BOOLEAN: {
+            bool* array = static_cast<BoolColumn*>(column)->array->array;
+            bool* values = new bool[numRows];
+            for (size_t i = 0; i < numRows; i++) {
+                values[i] = array[rows[i]];
+            }
+            byte* bytes = Serializer::serialize_bool_array(values, numRows);
+            delete[] values;
+            return bytes;
+        }
+        default: {
+            Object** array = static_cast<StringColumn*>(column)->array->array;
+            String** values = new String*[numRows];
+            for (size_t i = 0; i < numRows; i++) {
+                values[i] = static_cast<String*>(array[rows[i]]);
+            }
+            byte* bytes = Serializer::serialize_string_array(values, numRows);
+            delete[] values;
+            return bytes;
+        }
+    }
+}
+
+Shuffle::Shuffle(KVStore* kv, const char* name, const char* prefix,
+                 const size_t* keys, size_t numKeys, size_t numPartitions)
+    : Object() {
+    assert(kv != nullptr && name != nullptr && prefix != nullptr);
+    assert(numKeys > 0 && numPartitions > 0);
+    this->types = ChunkStream::read_metadata(kv, name, &this->numChunks,
+                                             &this->numCols);
+    assert(this->types != nullptr);
+    for (size_t key = 0; key < numKeys; key++) {
+        assert(keys[key] < this->numCols);
+    }
+    this->kv = kv;
+    this->name = duplicate(name);
+    this->prefix = duplicate(prefix);
+    this->keys = new size_t[numKeys];
+    memcpy(this->keys, keys, numKeys * sizeof(size_t));
+    this->numKeys = numKeys;
+    this->numPartitions = numPartitions;
+}
+
+Shuffle::~Shuffle() {
+    delete[] this->name;
+    delete[] this->prefix;
+    delete[] this->keys;
+    delete[] this->types;
+}
+
+void Shuffle::run() {
+    size_t numNodes = this->kv->num_nodes;
+    ShuffleThread** threads = new ShuffleThread*[numNodes];
+    for (size_t node = 0; node < numNodes; node++) {
+        threads[node] = new ShuffleThread(this, node);
+        threads[node]->start();
+    }
+    for (size_t node = 0; node < numNodes; node++) {
+        threads[node]->join();
+        delete threads[node];
+    }
+    delete[] threads;
+}
+
+void Shuffle::partition_chunk(size_t chunk) {
+    // 0. load the chunk
+    Column** columns = new Column*[this->numCols];
+    for (size_t col = 0; col < this->numCols; col++) {
+        Key* key = ChunkStream::chunk_key(this->kv, this->name, col, chunk);
+        columns[col] = this->kv->get_column(Key(key->key, key->nodeId));
+        delete key;
+        assert(columns[col] != nullptr);
+    }
+    Column** keys = new Column*[this->numKeys];
+    for (size_t key = 0; key < this->numKeys; key++) {
+        keys[key] = columns[this->keys[key]];
+    }
+    size_t numRows = this->numCols == 0 ? 0 : columns[0]->size();
+
+    // 1. order the rows by partition, keeping their order within one
+    size_t* partitions = new size_t[numRows];
+    size_t* starts = new size_t[this->numPartitions + 1]();
+    for (size_t row = 0; row < numRows; row++) {
+        partitions[row] =
+            this->partition(RowKeys::hash(keys, this->numKeys, row));
+        starts[partitions[row] + 1]++;
+    }
+    for (size_t p = 0; p < this->numPartitions; p++) {
+        starts[p + 1] += starts[p];
+    }
+    size_t* rows = new size_t[numRows];
+    size_t* next = new size_t[this->numPartitions];
+    memcpy(next, starts, this->numPartitions * sizeof(size_t));
+    for (size_t row = 0; row < numRows; row++) {
+        rows[next[partitions[row]]++] = row;
+    }
+
+    // 2. ship every piece to the owner of its partition
+    for (size_t p = 0; p < this->numPartitions; p++) {
+        size_t size = starts[p + 1] - starts[p];
+        if (size == 0) {
+            continue;
+        }
+        for (size_t col = 0; col < this->numCols; col++) {
+            this->kv->put_owned(
+                this->piece_key(col, p, chunk),
+                serialize_rows(columns[col], rows + starts[p], size));
+        }
+    }
+
+    for (size_t col = 0; col < this->numCols; col++) {
+        delete columns[col];
+    }
+    delete[] columns;
+    delete[] keys;
+    delete[] partitions;
+    delete[] starts;
+    delete[] rows;
+    delete[] next;
+}
+
+DataFrame* Shuffle::load(size_t partition) {
+    assert(partition < this->numPartitions);
+    Schema* schema = new Schema();
+    ColumnArray* columns = new ColumnArray();
+    for (size_t col = 0; col < this->numCols; col++) {
+        schema->add_col_type(this->types[col]);
+        switch (this->types[col]) {
+            case ColType::INTEGER:
+                columns->append(new IntColumn());
+                break;
+            case ColType::DOUBLE:
+                columns->append(new DoubleColumn());
+                break;
+            case ColType::BOOLEAN:
+                columns->append(new BoolColumn());
+                break;
+            default:
+                columns->append(new StringColumn());
+                break;
+        }
+    }
+    size_t numRows = 0;
+    for (size_t chunk = 0; chunk < this->numChunks; chunk++) {
+        for (size_t col = 0; col < this->numCols; col++) {
+            Key* key = this->piece_key(col, partition, chunk);
+            Column* piece = this->kv->get_column(Key(key->key, key->nodeId));
+            delete key;
+            if (piece == nullptr) {
+                break;  // no rows of the chunk in the partition
+            }
+            if (col == 0) {
+                numRows += piece->size();
+            }
+            columns->get(col)->extend(piece);
+            delete piece;
+        }
+    }
+    DataFrame* df = new DataFrame(*schema);
+    for (int col = 0; col < columns->size(); col++) {
+        delete df->columns->set(col, columns->get(col));
+    }
+    df->schema->numRows = numRows;
+    // the columns now belong to the data frame
+    columns->elementsInserted = 0;
+    delete columns;
+    delete schema;
+    return df;
+}
+
+size_t Shuffle::partition(uint64_t hash) {
+    // the bits in the middle of the hash, which the hash tables of the local
+    // group-bys and joins of a partition do not use
+    return ((hash >> 20) & 0xffffffff) * this->numPartitions >> 32;
+}
+
+Key* Shuffle::piece_key(size_t column, size_t partition, size_t chunk) {
+    size_t length = strlen(this->prefix) + 72;
+    char* key = new char[length];
+    snprintf(key, length, "%s:%zu:%zu:%zu", this->prefix, column, partition,
+             chunk);
+    return new Key(true, key, partition % this->kv->num_nodes);
+}
+
+size_t Shuffle::frame_bytes(KVStore* kv, const char* name) {
+    size_t numChunks, numCols;
+    ColType* types = ChunkStream::read_metadata(kv, name, &numChunks, &numCols);
+    if (types == nullptr) {
+        return 0;
+    }
+    delete[] types;
+    size_t total = 0;
+    for (size_t chunk = 0; chunk < numChunks; chunk++) {
+        for (size_t col = 0; col < numCols; col++) {
+            Key* key = ChunkStream::chunk_key(kv, name, col, chunk);
+            total += kv->value_bytes(Key(key->key, key->nodeId));
+            delete key;
+        }
+    }
+    return total;
+}
@@ -0,0 +1,19 @@
+#include "../../include/eau2/kvstore/shuffle_thread.h"
+
+#include <cassert>
+
+#include "../../include/eau2/kvstore/kvstore.h"
+
+ShuffleThread::ShuffleThread(Shuffle *shuffle, size_t node) : Thread() {
+    assert(shuffle != nullptr);
+    this->shuffle = shuffle;
+    this->node = node;
+}
+
+void ShuffleThread::run() {
+    size_t numNodes = this->shuffle->kv->num_nodes;
+    for (size_t chunk = this->node; chunk < this->shuffle->numChunks;
+         chunk += numNodes) {
+        this->shuffle->partition_chunk(chunk);
+    }
+}
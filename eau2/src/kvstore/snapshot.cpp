@@ -0,0 +1,72 @@
+#include "../../include/eau2/kvstore/snapshot.h"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include "../../include/eau2/kvstore/wal.h"
+#include "../../include/eau2/utils/mapped_file.h"
+
+bool Snapshot::write(const char* path, KeyValueBytes** items,
+                     size_t numRecords) {
+    size_t pathLength = strlen(path);
+    char* tempPath = new char[pathLength + 5];
+    memcpy(tempPath, path, pathLength);
+    memcpy(tempPath + pathLength, ".tmp", 5);
+    FILE* file = fopen(tempPath, "wb");
+    if (file == nullptr) {
+        delete[] tempPath;
+        return false;
+    }
+    fwrite(SNAPSHOT_MAGIC, 1, strlen(SNAPSHOT_MAGIC), file);
+    fwrite(&numRecords, sizeof(size_t), 1, file);
+
+    size_t capacity = 0;
+    byte* record = nullptr;
+    for (size_t i = 0; i < numRecords; i++) {
+        Key* key = items[i]->getKey();
+        byte* value = items[i]->getValue();
+        size_t size = WriteAheadLog::record_size(key, value);
+        if (size > capacity) {
+            delete[] record;
+            capacity = size * 2;
+            record = new byte[capacity];
+        }
+        WriteAheadLog::write_record(record, key, value, items[i]->version);
+        fwrite(record, 1, size, file);
+    }
+    delete[] record;
+
+    bool written = fflush(file) == 0 && fsync(fileno(file)) == 0;
+    written &= fclose(file) == 0;
+    // replace the previous snapshot only once this one is complete
+    written = written && rename(tempPath, path) == 0;
+    delete[] tempPath;
+    return written;
+}
+
+size_t Snapshot::load(const char* path, ByteMap* map, Array* keys) {
+    MappedFile* file = new MappedFile(path);
+    size_t headerSize = strlen(SNAPSHOT_MAGIC) + sizeof(size_t);
+    if (file->size() < headerSize ||
+        memcmp(file->data, SNAPSHOT_MAGIC, strlen(SNAPSHOT_MAGIC)) != 0) {
+        delete file;
+        return 0;
+    }
+    size_t numRecords;
+    memcpy(&numRecords, file->data + strlen(SNAPSHOT_MAGIC), sizeof(size_t));
+    size_t position = headerSize;
+    size_t loaded = 0;
+    while (loaded < numRecords) {
+        size_t consumed = WriteAheadLog::read_record(
+            file->data + position, file->size() - position, map, keys);
+        if (consumed == 0) {
+            break;
+        }
+        position += consumed;
+        loaded++;
+    }
+    delete file;
+    return loaded;
+}
@@ -0,0 +1,253 @@
+#include "../../include/eau2/kvstore/wal.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include "../../include/eau2/serialization/deserializer.h"
+#include "../../include/eau2/utils/mapped_file.h"
+
+// FNV-1a hash of the given bytes
+static size_t checksum(byte* bytes, size_t length) {
+    size_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// returns a new cstring made of the given prefix and suffix
+static char* concat(const char* prefix, const char* suffix) {
+    size_t prefixLength = strlen(prefix);
+    size_t suffixLength = strlen(suffix);
+    char* result = new char[prefixLength + suffixLength + 1];
+    memcpy(result, prefix, prefixLength);
+    memcpy(result + prefixLength, suffix, suffixLength + 1);
+    return result;
+}
+
+// writes all the given bytes to the given file, retrying interrupted and
+// partial writes; returns false if the file cannot be written
+static bool write_all(int fd, byte* bytes, size_t length) {
+    size_t written = 0;
+    while (written < length) {
+        ssize_t result = write(fd, bytes + written, length - written);
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            return false;
+        }
+        written += result;
+    }
+    return true;
+}
+
+WriteAheadLog::WriteAheadLog(const char* path, size_t groupBytes) : Object() {
+    this->path = concat(path, "");
+    this->rotatedPath = concat(path, ".old");
+    this->fd = open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+    assert(this->fd >= 0);
+    this->groupBytes = groupBytes;
+    this->capacity = groupBytes > 0 ? groupBytes : 1;
+    this->buffer = new byte[this->capacity];
+    this->bufferSize = 0;
+    this->numRecords = 0;
+}
+
+WriteAheadLog::~WriteAheadLog() {
+    this->commit();
+    close(this->fd);
+    delete[] this->buffer;
+    delete[] this->path;
+    delete[] this->rotatedPath;
+}
+
+bool WriteAheadLog::append(Key* key, byte* value, size_t version) {
+    size_t size = WriteAheadLog::record_size(key, value);
+    this->lock.lock();
+    if (this->bufferSize + size > this->capacity) {
+        size_t newCapacity = (this->bufferSize + size) * 2;
+        byte* newBuffer = new byte[newCapacity];
+        memcpy(newBuffer, this->buffer, this->bufferSize);
+        delete[] this->buffer;
+        this->buffer = newBuffer;
+        this->capacity = newCapacity;
+    }
+    this->bufferSize += WriteAheadLog::write_record(
+        this->buffer + this->bufferSize, key, value, version);
+    this->numRecords++;
+    bool due = this->bufferSize >= this->groupBytes;
+    this->lock.unlock();
+    return due;
+}
+
+bool WriteAheadLog::commit() {
+    this->commitLock.lock();
+    size_t size;
+    byte* group = this->take_group_(&size);
+    bool committed = this->write_group_(group, size);
+    if (!committed) {
+        perror("[wal.cpp] commit");
+    }
+    this->commitLock.unlock();
+    return committed;
+}
+
+bool WriteAheadLog::rotate() {
+    this->commitLock.lock();
+    this->lock.lock();
+    this->numRecords = 0;
+    this->lock.unlock();
+    size_t size;
+    byte* group = this->take_group_(&size);
+    bool rotated = this->write_group_(group, size) &&
+                   rename(this->path, this->rotatedPath) == 0;
+    if (rotated) {
+        close(this->fd);
+        this->fd = open(this->path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+        rotated = this->fd >= 0;
+    }
+    if (!rotated) {
+        perror("[wal.cpp] rotate");
+    }
+    this->commitLock.unlock();
+    return rotated;
+}
+
+void WriteAheadLog::discard_rotated() { unlink(this->rotatedPath); }
+
+bool WriteAheadLog::reset() {
+    this->commitLock.lock();
+    this->lock.lock();
+    this->bufferSize = 0;
+    this->numRecords = 0;
+    this->lock.unlock();
+    bool truncated = ftruncate(this->fd, 0) == 0 && fdatasync(this->fd) == 0;
+    if (!truncated) {
+        perror("[wal.cpp] reset");
+    }
+    this->commitLock.unlock();
+    return truncated;
+}
+
+size_t WriteAheadLog::length() {
+    this->lock.lock();
+    size_t numRecords = this->numRecords;
+    this->lock.unlock();
+    return numRecords;
+}
+
+byte* WriteAheadLog::take_group_(size_t* size) {
+    this->lock.lock();
+    byte* group = nullptr;
+    *size = this->bufferSize;
+    if (this->bufferSize > 0) {
+        group = this->buffer;
+        this->buffer = new byte[this->capacity];
+        this->bufferSize = 0;
+    }
+    this->lock.unlock();
+    return group;
+}
+
+bool WriteAheadLog::write_group_(byte* group, size_t size) {
+    if (group == nullptr) {
+        return true;
+    }
+    bool written =
+        write_all(this->fd, group, size) && fdatasync(this->fd) == 0;
+    delete[] group;
+    return written;
+}
+
+size_t WriteAheadLog::record_size(Key* key, byte* value) {
+    return 5 * sizeof(size_t) + strlen(key->key) +
+           Deserializer::num_bytes(value);
+}
+
+size_t WriteAheadLog::write_record(byte* out, Key* key, byte* value,
+                                   size_t version) {
+    size_t size = WriteAheadLog::record_size(key, value);
+    size_t keyLength = strlen(key->key);
+    size_t displacement = 0;
+    memcpy(out + displacement, &size, sizeof(size_t));
+    displacement += 2 * sizeof(size_t);  // checksum is written last
+    memcpy(out + displacement, &version, sizeof(size_t));
+    displacement += sizeof(size_t);
+    memcpy(out + displacement, &key->nodeId, sizeof(size_t));
+    displacement += sizeof(size_t);
+    memcpy(out + displacement, &keyLength, sizeof(size_t));
+    displacement += sizeof(size_t);
+    memcpy(out + displacement, key->key, keyLength);
+    displacement += keyLength;
+    memcpy(out + displacement, value, Deserializer::num_bytes(value));
+    size_t sum = checksum(out + 2 * sizeof(size_t), size - 2 * sizeof(size_t));
+    memcpy(out + sizeof(size_t), &sum, sizeof(size_t));
+    return size;
+}
+
+size_t WriteAheadLog::read_record(byte* in, size_t available, ByteMap* map,
+                                  Array* keys) {
+    size_t size, sum, version, nodeId, keyLength;
+    if (available < 5 * sizeof(size_t)) {
+        return 0;
+    }
+    memcpy(&size, in, sizeof(size_t));
+    if (size < 5 * sizeof(size_t) || size > available) {
+        return 0;
+    }
+    memcpy(&sum, in + sizeof(size_t), sizeof(size_t));
+    if (sum != checksum(in + 2 * sizeof(size_t), size - 2 * sizeof(size_t))) {
+        return 0;
+    }
+    size_t displacement = 2 * sizeof(size_t);
+    memcpy(&version, in + displacement, sizeof(size_t));
+    displacement += sizeof(size_t);
+    memcpy(&nodeId, in + displacement, sizeof(size_t));
+    displacement += sizeof(size_t);
+    memcpy(&keyLength, in + displacement, sizeof(size_t));
+    displacement += sizeof(size_t);
+    char* name = new char[keyLength + 1];
+    memcpy(name, in + displacement, keyLength);
+    name[keyLength] = '\0';
+    displacement += keyLength;
+    size_t valueSize = size - displacement;
+    byte* value = new byte[valueSize];
+    memcpy(value, in + displacement, valueSize);
+
+    Key* key = new Key(true, name, nodeId);
+    bool isNewKey = map->version(key) == 0;
+    if (!map->restore(key, value, version)) {
+        // already restored from a newer snapshot or record
+        delete[] value;
+    }
+    if (isNewKey) {
+        keys->append(key);
+    } else {
+        delete key;
+    }
+    return size;
+}
+
+size_t WriteAheadLog::replay(const char* path, ByteMap* map, Array* keys) {
+    MappedFile* file = new MappedFile(path);
+    size_t numRecords = 0;
+    size_t position = 0;
+    while (position < file->size()) {
+        size_t consumed = WriteAheadLog::read_record(
+            file->data + position, file->size() - position, map, keys);
+        if (consumed == 0) {
+            break;
+        }
+        position += consumed;
+        numRecords++;
+    }
+    delete file;
+    return numRecords;
+}
@@ -4,6 +4,11 @@
 #include <cstdlib>
 #include <cstring>
 
+#include "../../include/eau2/dataframe/columns/bool_column.h"
+#include "../../include/eau2/dataframe/columns/double_column.h"
+#include "../../include/eau2/dataframe/columns/int_column.h"
+#include "../../include/eau2/dataframe/columns/string_column.h"
+
 int Deserializer::deserialize_int(byte* bytes) {
     Headers header;
     size_t displacement = sizeof(size_t);
@@ -110,16 +115,103 @@ String** Deserializer::deserialize_string_array(byte* bytes) {
         size_t length;
         memcpy(&length, bytes + displacement, sizeof(size_t));
         displacement += sizeof(size_t);
+        if (length == MISSING_STRING) {
+            array[i] = nullptr;
+            continue;
+        }
         char* cstr = new char[length + 1];
         memcpy(cstr, bytes + displacement, length);
         displacement += length;
         cstr[length] = '\0';
-        array[i] = new String(cstr);
-        delete[] cstr;
+        // the String takes the buffer over instead of copying it again
+        array[i] = new String(true, cstr, length);
     }
     return array;
 }
 
+PackedStringArray* Deserializer::deserialize_packed_string_array(byte* bytes) {
+    Headers header;
+    size_t displacement = sizeof(size_t);
+    memcpy(&header, bytes + displacement, sizeof(Headers));
+    displacement += sizeof(Headers);
+    assert(header == Headers::STRING_ARRAY);
+    size_t size;
+    memcpy(&size, bytes + displacement, sizeof(size_t));
+    displacement += sizeof(size_t);
+    // the number of characters is known from the size of the block, so the
+    // whole array is decoded into exactly two allocations
+    size_t num_chars =
+        Deserializer::num_bytes(bytes) - displacement - size * sizeof(size_t);
+    char* chars = new char[num_chars + size];
+    size_t* offsets = new size_t[size + 1];
+    size_t position = 0;
+    for (size_t i = 0; i < size; i++) {
+        size_t length;
+        memcpy(&length, bytes + displacement, sizeof(size_t));
+        displacement += sizeof(size_t);
+        length = length == MISSING_STRING ? 0 : length;
+        offsets[i] = position;
+        memcpy(chars + position, bytes + displacement, length);
+        displacement += length;
+        position += length;
+        chars[position++] = '\0';
+    }
+    offsets[size] = position;
+    return new PackedStringArray(chars, offsets, size);
+}
+
+Column* Deserializer::deserialize_column(byte* bytes) {
+    size_t size = Deserializer::array_size(bytes);
+    byte* values = bytes + 2 * sizeof(size_t) + sizeof(Headers);
+    switch (Deserializer::get_header(bytes)) {
+        case Headers::INT_ARRAY: {
+            IntColumn* column = new IntColumn();
+            IntArray* array = column->array;
+            if (size > 0) {  // an empty array has nothing to copy
+                array->_ensure_size(size);
+                memcpy(array->array, values, size * sizeof(int));
+            }
+            array->elementsInserted = array->currentPosition = size;
+            column->numElements = size;
+            return column;
+        }
+        case Headers::DOUBLE_ARRAY: {
+            DoubleColumn* column = new DoubleColumn();
+            DoubleArray* array = column->array;
+            if (size > 0) {  // an empty array has nothing to copy
+                array->_ensure_size(size);
+                memcpy(array->array, values, size * sizeof(double));
+            }
+            array->elementsInserted = array->currentPosition = size;
+            column->numElements = size;
+            return column;
+        }
+        case Headers::BOOL_ARRAY: {
+            BoolColumn* column = new BoolColumn();
+            BoolArray* array = column->array;
+            if (size > 0) {  // an empty array has nothing to copy
+                array->_ensure_size(size);
+                memcpy(array->array, values, size * sizeof(bool));
+            }
+            array->elementsInserted = array->currentPosition = size;
+            column->numElements = size;
+            return column;
+        }
+        case Headers::STRING_ARRAY: {
+            String** strings = Deserializer::deserialize_string_array(bytes);
+            StringColumn* column = new StringColumn();
+            for (size_t i = 0; i < size; i++) {
+                column->push_back(strings[i]);
+            }
+            delete[] strings;
+            return column;
+        }
+        default:
+            assert(false);
+            return nullptr;
+    }
+}
+
 size_t Deserializer::array_size(byte* bytes) {
     size_t size;
     memcpy(&size, bytes + sizeof(size_t) + sizeof(Headers), sizeof(size_t));
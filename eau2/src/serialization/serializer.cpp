@@ -2,6 +2,11 @@
 
 #include <cstring>
 
+#include "../../include/eau2/dataframe/columns/bool_column.h"
+#include "../../include/eau2/dataframe/columns/double_column.h"
+#include "../../include/eau2/dataframe/columns/int_column.h"
+#include "../../include/eau2/dataframe/columns/string_column.h"
+
 byte* Serializer::serialize_int(int value) {
     size_t num_bytes = sizeof(size_t) + sizeof(Headers) + sizeof(int);
     size_t displacement = 0;
@@ -106,12 +111,38 @@ byte* Serializer::serialize_bool_array(bool* array, size_t size) {
     return data;
 }
 
+byte* Serializer::serialize_column(Column* column) {
+    size_t size = column->size();
+    switch (column->get_type()) {
+        case ColType::INTEGER:
+            return Serializer::serialize_int_array(
+                column->as_int()->array->array, size);
+        case ColType::DOUBLE:
+            return Serializer::serialize_double_array(
+                column->as_double()->array->array, size);
+        case ColType::BOOLEAN:
+            return Serializer::serialize_bool_array(
+                column->as_bool()->array->array, size);
+        default: {
+            String** strings = new String*[size];
+            for (size_t i = 0; i < size; i++) {
+                strings[i] = column->get_string(i);
+            }
+            byte* bytes = Serializer::serialize_string_array(strings, size);
+            delete[] strings;
+            return bytes;
+        }
+    }
+}
+
 byte* Serializer::serialize_string_array(String** array, size_t size) {
     size_t num_bytes = sizeof(size_t) + sizeof(Headers) + sizeof(size_t);
     size_t displacement = 0;
     for (size_t i = 0; i < size; i++) {
         num_bytes += sizeof(size_t);
-        num_bytes += array[i]->size() * sizeof(char);
+        if (array[i] != nullptr) {
+            num_bytes += array[i]->size() * sizeof(char);
+        }
     }
     Headers header = Headers::STRING_ARRAY;
     byte* data = new byte[num_bytes];
@@ -122,9 +153,12 @@ byte* Serializer::serialize_string_array(String** array, size_t size) {
     memcpy(data + displacement, &size, sizeof(size_t));
     displacement += sizeof(size_t);
     for (size_t i = 0; i < size; i++) {
-        size_t length = array[i]->size();
+        size_t length = array[i] == nullptr ? MISSING_STRING : array[i]->size();
         memcpy(data + displacement, &length, sizeof(size_t));
         displacement += sizeof(size_t);
+        if (length == MISSING_STRING) {
+            continue;
+        }
         memcpy(data + displacement, array[i]->cstr_, length);
         displacement += length;
     }
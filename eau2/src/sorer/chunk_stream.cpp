@@ -0,0 +1,267 @@
+#include "../../include/eau2/sorer/chunk_stream.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "../../include/eau2/dataframe/columns/bool_column.h"
+#include "../../include/eau2/dataframe/columns/double_column.h"
+#include "../../include/eau2/dataframe/columns/int_column.h"
+#include "../../include/eau2/dataframe/columns/string_column.h"
+#include "../../include/eau2/serialization/deserializer.h"
+#include "../../include/eau2/serialization/serializer.h"
+
+// stores the given count at the given index of the metadata as its low and
+// high 32 bits
+static void put_count(int* metadata, size_t index, size_t count) {
+    uint64_t value = count;
+    metadata[2 * index] = static_cast<int>(static_cast<uint32_t>(value));
+    metadata[2 * index + 1] =
+        static_cast<int>(static_cast<uint32_t>(value >> 32));
+}
+
+// returns the count stored at the given index of the metadata
+static size_t get_count(const int* metadata, size_t index) {
+    uint64_t low = static_cast<uint32_t>(metadata[2 * index]);
+    uint64_t high = static_cast<uint32_t>(metadata[2 * index + 1]);
+    return static_cast<size_t>(high << 32 | low);
+}
+
+ChunkStream::ChunkStream(KVStore* kv, const char* name, ColTypeArray* types,
+                         size_t chunkRows, size_t maxPending)
+    : Thread() {
+    assert(kv != nullptr);
+    assert(name != nullptr);
+    assert(types != nullptr);
+    assert(chunkRows > 0);
+    assert(maxPending > 0);
+    this->kv = kv;
+    this->name = duplicate(name);
+    this->types = new ColTypeArray();
+    for (int i = 0; i < types->size(); i++) {
+        this->types->append(types->get(i));
+    }
+    this->chunkRows = chunkRows;
+    this->maxPending = maxPending;
+    this->pending = new ColumnArray*[maxPending];
+    this->head = 0;
+    this->numPending = 0;
+    this->finished = false;
+    this->numChunks = 0;
+    this->numRows = 0;
+    this->zones = new ZoneMap*[this->types->size()];
+    for (int i = 0; i < this->types->size(); i++) {
+        this->zones[i] = new ZoneMap(this->types->get(i));
+    }
+}
+
+ChunkStream::~ChunkStream() {
+    for (size_t i = 0; i < this->numPending; i++) {
+        delete this->pending[(this->head + i) % this->maxPending];
+    }
+    delete[] this->pending;
+    for (int i = 0; i < this->types->size(); i++) {
+        delete this->zones[i];
+    }
+    delete[] this->zones;
+    delete this->types;
+    delete[] this->name;
+}
+
+void ChunkStream::push(ColumnArray* chunk) {
+    assert(chunk != nullptr);
+    this->lock.lock();
+    assert(!this->finished);
+    // backpressure: the parser waits for the store to catch up
+    while (this->numPending == this->maxPending) {
+        this->lock.wait();
+    }
+    this->pending[(this->head + this->numPending) % this->maxPending] = chunk;
+    this->numPending++;
+    this->lock.notify_all();
+    this->lock.unlock();
+}
+
+void ChunkStream::finish() {
+    this->lock.lock();
+    this->finished = true;
+    this->lock.notify_all();
+    this->lock.unlock();
+    this->join();
+}
+
+void ChunkStream::run() {
+    while (true) {
+        this->lock.lock();
+        while (this->numPending == 0 && !this->finished) {
+            this->lock.wait();
+        }
+        if (this->numPending == 0) {
+            this->lock.unlock();
+            break;
+        }
+        ColumnArray* chunk = this->pending[this->head];
+        this->head = (this->head + 1) % this->maxPending;
+        this->numPending--;
+        this->lock.notify_all();
+        this->lock.unlock();
+        // the parser keeps going while the chunk is serialized and stored
+        this->store_(chunk, this->numChunks);
+        this->numChunks++;
+        delete chunk;
+    }
+
+    size_t numCols = this->types->size();
+    for (size_t col = 0; col < numCols; col++) {
+        this->kv->put_owned(ChunkStream::zones_key(this->name, col),
+                            this->zones[col]->serialize());
+    }
+    ColType* types = new ColType[numCols];
+    for (size_t i = 0; i < numCols; i++) {
+        types[i] = this->types->get(i);
+    }
+    this->kv->put_owned(
+        new Key(true, duplicate(this->name), 0),
+        ChunkStream::serialize_metadata(this->numRows, this->chunkRows,
+                                        this->numChunks, types, numCols));
+    delete[] types;
+}
+
+void ChunkStream::store_(ColumnArray* chunk, size_t index) {
+    for (int col = 0; col < chunk->size(); col++) {
+        this->kv->put_owned(
+            ChunkStream::chunk_key(this->kv, this->name, col, index),
+            Serializer::serialize_column(chunk->get(col)));
+        this->zones[col]->add_zone(chunk->get(col));
+    }
+    if (chunk->size() > 0) {
+        this->numRows += chunk->get(0)->size();
+    }
+}
+
+Key* ChunkStream::chunk_key(KVStore* kv, const char* name, size_t column,
+                            size_t chunk) {
+    size_t length = strlen(name) + 48;
+    char* key = new char[length];
+    snprintf(key, length, "%s:%zu:%zu", name, column, chunk);
+    return new Key(true, key, chunk % kv->num_nodes);
+}
+
+Key* ChunkStream::zones_key(const char* name, size_t column) {
+    size_t length = strlen(name) + 32;
+    char* key = new char[length];
+    snprintf(key, length, "%s:%zu:zones", name, column);
+    return new Key(true, key, 0);
+}
+
+byte* ChunkStream::serialize_metadata(size_t numRows, size_t chunkRows,
+                                      size_t numChunks, const ColType* types,
+                                      size_t numCols) {
+    int* metadata = new int[CHUNK_METADATA + numCols];
+    put_count(metadata, 0, numRows);
+    put_count(metadata, 1, chunkRows);
+    put_count(metadata, 2, numChunks);
+    for (size_t i = 0; i < numCols; i++) {
+        metadata[CHUNK_METADATA + i] = static_cast<int>(types[i]);
+    }
+    byte* bytes =
+        Serializer::serialize_int_array(metadata, CHUNK_METADATA + numCols);
+    delete[] metadata;
+    return bytes;
+}
+
+ColType* ChunkStream::read_metadata(KVStore* kv, const char* name,
+                                    size_t* numChunks, size_t* numCols) {
+    return kv->get_decoded(Key(name, 0), [numChunks, numCols](byte* bytes) {
+        int* metadata = Deserializer::deserialize_int_array(bytes);
+        *numCols = Deserializer::array_size(bytes) - CHUNK_METADATA;
+        *numChunks = get_count(metadata, 2);
+        ColType* types = new ColType[*numCols];
+        for (size_t col = 0; col < *numCols; col++) {
+            types[col] = static_cast<ColType>(metadata[CHUNK_METADATA + col]);
+        }
+        delete[] metadata;
+        return types;
+    });
+}
+
+DataFrame* ChunkStream::load(KVStore* kv, const char* name) {
+    return ChunkStream::load(kv, name, nullptr);
+}
+
+DataFrame* ChunkStream::load(KVStore* kv, const char* name,
+                             Condition* condition) {
+    size_t numChunks, numCols;
+    ColType* types =
+        ChunkStream::read_metadata(kv, name, &numChunks, &numCols);
+    if (types == nullptr) {
+        return nullptr;
+    }
+    ColumnArray* columns = new ColumnArray();
+    for (size_t col = 0; col < numCols; col++) {
+        switch (types[col]) {
+            case ColType::INTEGER:
+                columns->append(new IntColumn());
+                break;
+            case ColType::DOUBLE:
+                columns->append(new DoubleColumn());
+                break;
+            case ColType::BOOLEAN:
+                columns->append(new BoolColumn());
+                break;
+            default:
+                columns->append(new StringColumn());
+                break;
+        }
+    }
+    ZoneMap* zones = nullptr;
+    if (condition != nullptr) {
+        assert(condition->column < numCols);
+        Key* key = ChunkStream::zones_key(name, condition->column);
+        zones = kv->get_decoded(Key(key->key, key->nodeId),
+                                ZoneMap::deserialize);
+        delete key;
+        assert(zones == nullptr || zones->numZones == numChunks);
+    }
+    Column** chunk = new Column*[numCols];
+    size_t* rows = nullptr;
+    for (size_t index = 0; index < numChunks; index++) {
+        if (zones != nullptr && !zones->may_match(condition, index)) {
+            continue;
+        }
+        for (size_t col = 0; col < numCols; col++) {
+            Key* key = ChunkStream::chunk_key(kv, name, col, index);
+            chunk[col] = kv->get_column(Key(key->key, key->nodeId));
+            delete key;
+            assert(chunk[col] != nullptr);
+        }
+        if (condition != nullptr) {
+            // the rows of the chunk passing the check, gathered
+            size_t numRows = chunk[0]->size();
+            delete[] rows;
+            rows = new size_t[numRows];
+            for (size_t row = 0; row < numRows; row++) {
+                rows[row] = row;
+            }
+            size_t numKept =
+                condition->select(chunk[condition->column], rows, numRows);
+            for (size_t col = 0; numKept < numRows && col < numCols; col++) {
+                Column* kept = chunk[col]->gather(rows, numKept);
+                delete chunk[col];
+                chunk[col] = kept;
+            }
+        }
+        for (size_t col = 0; col < numCols; col++) {
+            columns->get(col)->extend(chunk[col]);
+            delete chunk[col];
+        }
+    }
+    delete[] rows;
+    delete[] chunk;
+    delete zones;
+    delete[] types;
+    DataFrame* df = DataFrame::fromColumns(columns);
+    delete columns;
+    return df;
+}
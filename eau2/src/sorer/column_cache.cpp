@@ -0,0 +1,125 @@
+#include "../../include/eau2/sorer/column_cache.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "../../include/eau2/serialization/deserializer.h"
+#include "../../include/eau2/serialization/serializer.h"
+#include "../../include/eau2/utils/mapped_file.h"
+
+// size, modification seconds and nanoseconds of a sorer file
+static bool identify(const char* path, int64_t* identity) {
+    struct stat status;
+    if (stat(path, &status) != 0) {
+        return false;
+    }
+    identity[0] = status.st_size;
+    identity[1] = status.st_mtim.tv_sec;
+    identity[2] = status.st_mtim.tv_nsec;
+    return true;
+}
+
+char* ColumnCache::cache_path(const char* path) {
+    size_t pathLength = strlen(path);
+    size_t suffixLength = strlen(COLUMN_CACHE_SUFFIX);
+    char* cachePath = new char[pathLength + suffixLength + 1];
+    memcpy(cachePath, path, pathLength);
+    memcpy(cachePath + pathLength, COLUMN_CACHE_SUFFIX, suffixLength + 1);
+    return cachePath;
+}
+
+bool ColumnCache::write(const char* path, ColumnArray* columns) {
+    int64_t identity[3];
+    if (!identify(path, identity)) {
+        return false;
+    }
+    char* cachePath = ColumnCache::cache_path(path);
+    size_t pathLength = strlen(cachePath);
+    char* tempPath = new char[pathLength + 5];
+    memcpy(tempPath, cachePath, pathLength);
+    memcpy(tempPath + pathLength, ".tmp", 5);
+    FILE* file = fopen(tempPath, "wb");
+    if (file == nullptr) {
+        delete[] cachePath;
+        delete[] tempPath;
+        return false;
+    }
+    size_t numCols = columns->size();
+    bool written =
+        fwrite(COLUMN_CACHE_MAGIC, 1, strlen(COLUMN_CACHE_MAGIC), file) ==
+        strlen(COLUMN_CACHE_MAGIC);
+    written &= fwrite(identity, sizeof(int64_t), 3, file) == 3;
+    written &= fwrite(&numCols, sizeof(size_t), 1, file) == 1;
+    for (size_t i = 0; written && i < numCols; i++) {
+        byte* bytes = Serializer::serialize_column(columns->get(i));
+        size_t numBytes = Deserializer::num_bytes(bytes);
+        written = fwrite(bytes, 1, numBytes, file) == numBytes;
+        delete[] bytes;
+    }
+    written &= fclose(file) == 0;
+    // replace the previous cache only once this one is complete
+    written = written && rename(tempPath, cachePath) == 0;
+    if (!written) {
+        unlink(tempPath);
+    }
+    delete[] cachePath;
+    delete[] tempPath;
+    return written;
+}
+
+bool ColumnCache::load(const char* path, ColumnArray* columns) {
+    int64_t identity[3];
+    if (!identify(path, identity)) {
+        return false;
+    }
+    char* cachePath = ColumnCache::cache_path(path);
+    MappedFile* file = new MappedFile(cachePath);
+    delete[] cachePath;
+    size_t magicLength = strlen(COLUMN_CACHE_MAGIC);
+    size_t headerSize = magicLength + sizeof(identity) + sizeof(size_t);
+    if (file->size() < headerSize ||
+        memcmp(file->data, COLUMN_CACHE_MAGIC, magicLength) != 0 ||
+        memcmp(file->data + magicLength, identity, sizeof(identity)) != 0) {
+        delete file;
+        return false;
+    }
+    size_t numCols;
+    memcpy(&numCols, file->data + magicLength + sizeof(identity),
+           sizeof(size_t));
+    // the columns are only handed over once all of them are loaded
+    ColumnArray* loaded = new ColumnArray();
+    size_t position = headerSize;
+    bool valid = true;
+    for (size_t i = 0; valid && i < numCols; i++) {
+        size_t available = file->size() - position;
+        byte* bytes = file->data + position;
+        valid = available >= 2 * sizeof(size_t) + sizeof(Headers) &&
+                Deserializer::num_bytes(bytes) <= available;
+        if (!valid) {
+            break;
+        }
+        Headers header = Deserializer::get_header(bytes);
+        valid = header == Headers::INT_ARRAY ||
+                header == Headers::DOUBLE_ARRAY ||
+                header == Headers::BOOL_ARRAY ||
+                header == Headers::STRING_ARRAY;
+        if (valid) {
+            loaded->append(Deserializer::deserialize_column(bytes));
+            position += Deserializer::num_bytes(bytes);
+        }
+    }
+    if (valid) {
+        for (int i = 0; i < loaded->size(); i++) {
+            columns->append(loaded->get(i));
+        }
+        // the columns now belong to the given array
+        loaded->elementsInserted = 0;
+    }
+    delete loaded;
+    delete file;
+    return valid;
+}
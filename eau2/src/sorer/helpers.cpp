@@ -1,8 +1,58 @@
 #include "../../include/eau2/sorer/helpers.h"
 
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 
+// exactly representable powers of ten used by parse_double
+static const double powersOfTen[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+// returns true if all the eight characters packed in the given word are
+// digits
+static inline bool is_eight_digits(uint64_t word) {
+    return ((word & 0xF0F0F0F0F0F0F0F0ULL) |
+            (((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >>
+             4)) == 0x3333333333333333ULL;
+}
+
+// converts the eight digits packed in the given word, first digit in the
+// lowest byte, with three multiplications instead of eight
+static inline uint32_t parse_eight_digits(uint64_t word) {
+    word = ((word & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+    word = ((word & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+    return static_cast<uint32_t>(
+        ((word & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32);
+}
+
+// accumulates the run of digits starting at c[*i] into mantissa, stopping at
+// the first character that is not a digit, and returns the number of digits
+static inline size_t parse_digits(const char *c, size_t len, size_t *i,
+                                  uint64_t *mantissa) {
+    size_t start = *i;
+    uint64_t result = *mantissa;
+    while (len - *i >= 8) {
+        uint64_t word;
+        memcpy(&word, c + *i, sizeof(word));
+        if (!is_eight_digits(word)) {
+            break;
+        }
+        result = result * 100000000 + parse_eight_digits(word);
+        *i += 8;
+    }
+    for (; *i < len; (*i)++) {
+        unsigned int digit = static_cast<unsigned char>(c[*i]) - '0';
+        if (digit > 9) {
+            break;
+        }
+        result = result * 10 + digit;
+    }
+    *mantissa = result;
+    return *i - start;
+}
+
 void affirm(bool test, const char *msg) {
     if (!(test)) {
         fprintf(stderr, "%s\n", msg);
@@ -51,3 +101,93 @@ bool is_float(char *c) {
     }
     return true;
 }
+
+bool is_int(const char *c, size_t len) {
+    if (len == 0) {
+        return false;
+    }
+    for (size_t i = 0; i < len; i++) {
+        if (i == 0 && (c[i] == '+' || c[i] == '-')) {
+            continue;
+        } else if (!isdigit(c[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool is_float(const char *c, size_t len) {
+    if (len == 0) {
+        return false;
+    }
+    bool has_decimal = false;
+    for (size_t i = 0; i < len; i++) {
+        if (i == 0 && (c[i] == '+' || c[i] == '-')) {
+            continue;
+        } else if (c[i] == '.' && has_decimal) {
+            return false;
+        } else if (c[i] == '.') {
+            has_decimal = true;
+        } else if (!isdigit(c[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool parse_bool(const char *c, size_t len, bool *value) {
+    if (len != 1 || (*c != '0' && *c != '1')) {
+        return false;
+    }
+    *value = *c == '1';
+    return true;
+}
+
+bool parse_int(const char *c, size_t len, int *value) {
+    if (len == 0) {
+        return false;
+    }
+    size_t i = *c == '+' || *c == '-' ? 1 : 0;
+    uint64_t result = 0;
+    parse_digits(c, len, &i, &result);
+    if (i != len) {
+        return false;
+    }
+    *value = static_cast<int>(*c == '-' ? 0 - result : result);
+    return true;
+}
+
+bool parse_double(const char *c, size_t len, double *value) {
+    if (len == 0) {
+        return false;
+    }
+    size_t i = *c == '+' || *c == '-' ? 1 : 0;
+    uint64_t mantissa = 0;
+    size_t numDigits = parse_digits(c, len, &i, &mantissa);
+    size_t numDecimals = 0;
+    if (i < len && c[i] == '.') {
+        i++;
+        numDecimals = parse_digits(c, len, &i, &mantissa);
+        numDigits += numDecimals;
+    }
+    if (i != len) {
+        return false;
+    }
+    if (numDigits <= 19 && numDecimals <= 22 && mantissa <= (1ULL << 53)) {
+        // both operands are exact, so the division is correctly rounded
+        double result = static_cast<double>(mantissa) /
+                        powersOfTen[numDecimals];
+        *value = *c == '-' ? -result : result;
+        return true;
+    }
+    // too many digits to be exact, strtod needs a terminated value
+    char buffer[64];
+    char *copy = len < sizeof(buffer) ? buffer : new char[len + 1];
+    memcpy(copy, c, len);
+    copy[len] = '\0';
+    *value = strtod(copy, nullptr);
+    if (copy != buffer) {
+        delete[] copy;
+    }
+    return true;
+}
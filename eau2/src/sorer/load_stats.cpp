@@ -0,0 +1,100 @@
+#include "../../include/eau2/sorer/load_stats.h"
+
+#include <chrono>
+
+LoadStats::LoadStats() : Object() { this->reset(); }
+
+void LoadStats::reset() {
+    this->bytes = 0;
+    this->lines = 0;
+    this->timedLines = 0;
+    this->rows = 0;
+    this->skippedRows = 0;
+    this->filteredRows = 0;
+    this->intFields = 0;
+    this->doubleFields = 0;
+    this->boolFields = 0;
+    this->stringFields = 0;
+    this->missingFields = 0;
+    this->schemaNanos = 0;
+    this->tokenizeNanos = 0;
+    this->filterNanos = 0;
+    this->convertNanos = 0;
+    this->totalNanos = 0;
+}
+
+void LoadStats::merge(LoadStats* other) {
+    this->bytes += other->bytes;
+    this->lines += other->lines;
+    this->timedLines += other->timedLines;
+    this->rows += other->rows;
+    this->skippedRows += other->skippedRows;
+    this->filteredRows += other->filteredRows;
+    this->intFields += other->intFields;
+    this->doubleFields += other->doubleFields;
+    this->boolFields += other->boolFields;
+    this->stringFields += other->stringFields;
+    this->missingFields += other->missingFields;
+    this->schemaNanos += other->schemaNanos;
+    this->tokenizeNanos += other->tokenizeNanos;
+    this->filterNanos += other->filterNanos;
+    this->convertNanos += other->convertNanos;
+}
+
+uint64_t LoadStats::start_line() {
+    if (this->lines++ % STATS_TIMING_PERIOD != 0) {
+        return 0;
+    }
+    this->timedLines++;
+    return now_ns();
+}
+
+void LoadStats::add_field(ColType type, bool missing) {
+    if (missing) {
+        this->missingFields++;
+        return;
+    }
+    switch (type) {
+        case ColType::INTEGER:
+            this->intFields++;
+            break;
+        case ColType::DOUBLE:
+            this->doubleFields++;
+            break;
+        case ColType::BOOLEAN:
+            this->boolFields++;
+            break;
+        default:
+            this->stringFields++;
+            break;
+    }
+}
+
+void LoadStats::report(FILE* out) {
+    double total = this->totalNanos / 1E9;
+    // seconds of all the lines per nanosecond of the timed ones
+    double scale = 0.0;
+    if (this->timedLines > 0) {
+        scale = static_cast<double>(this->lines) / this->timedLines / 1E9;
+    }
+    fprintf(out,
+            "{\"bytes\": %zu, \"lines\": %zu, \"rows\": %zu, "
+            "\"skipped_rows\": %zu, \"filtered_rows\": %zu, "
+            "\"fields\": {\"int\": %zu, \"double\": %zu, \"bool\": %zu, "
+            "\"string\": %zu, \"missing\": %zu}, "
+            "\"seconds\": {\"schema\": %.6f, \"tokenize\": %.6f, "
+            "\"filter\": %.6f, \"convert\": %.6f, \"total\": %.6f}, "
+            "\"gb_per_s\": %.3f}\n",
+            this->bytes, this->lines, this->rows, this->skippedRows,
+            this->filteredRows, this->intFields, this->doubleFields,
+            this->boolFields, this->stringFields, this->missingFields,
+            this->schemaNanos / 1E9, this->tokenizeNanos * scale,
+            this->filterNanos * scale, this->convertNanos * scale, total,
+            total > 0 ? this->bytes / total / 1E9 : 0.0);
+}
+
+uint64_t LoadStats::now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
@@ -0,0 +1,21 @@
+#include "../../include/eau2/sorer/parse_range_thread.h"
+
+#include <cassert>
+
+#include "../../include/eau2/sorer/sorer.h"
+
+ParseRangeThread::ParseRangeThread(SOR *sor, const char *data, size_t size,
+                                   size_t from, size_t len)
+    : Thread() {
+    assert(sor != nullptr);
+    assert(data != nullptr);
+    this->sor = sor;
+    this->data = data;
+    this->size = size;
+    this->from = from;
+    this->len = len;
+}
+
+void ParseRangeThread::run() {
+    this->sor->read_bytes(this->data, this->size, this->from, this->len);
+}
@@ -0,0 +1,324 @@
+#include "../../include/eau2/sorer/predicate.h"
+
+#include <cassert>
+#include <cstring>
+
+#include "../../include/eau2/dataframe/columns/bool_column.h"
+#include "../../include/eau2/dataframe/columns/double_column.h"
+#include "../../include/eau2/dataframe/columns/int_column.h"
+#include "../../include/eau2/dataframe/columns/string_column.h"
+#include "../../include/eau2/sorer/helpers.h"
+
+// returns true if the given sign of a comparison passes the given operator
+static bool passes(CompareOp op, int order) {
+    switch (op) {
+        case CompareOp::EQUAL:
+            return order == 0;
+        case CompareOp::NOT_EQUAL:
+            return order != 0;
+        case CompareOp::LESS:
+            return order < 0;
+        case CompareOp::LESS_EQUAL:
+            return order <= 0;
+        case CompareOp::GREATER:
+            return order > 0;
+        case CompareOp::GREATER_EQUAL:
+            return order >= 0;
+        default:
+            return true;
+    }
+}
+
+// keeps the rows, overwriting them in place, whose value passes the test
+#define KEEP_ROWS(test)                        \
+    for (size_t i = 0; i < numRows; i++) {     \
+        size_t row = rows[i];                  \
+        rows[kept] = row;                      \
+        kept += (test);                        \
+    }
+
+// keeps the rows whose value compares with the given one as the operator
+// requires, choosing the comparison once rather than per row
+template <typename T, typename V>
+static size_t select_values(const T* values, V value, CompareOp op,
+                            size_t* rows, size_t numRows) {
+    size_t kept = 0;
+    switch (op) {
+        case CompareOp::EQUAL:
+            KEEP_ROWS(values[row] == value);
+            break;
+        case CompareOp::NOT_EQUAL:
+            KEEP_ROWS(values[row] != value);
+            break;
+        case CompareOp::LESS:
+            KEEP_ROWS(values[row] < value);
+            break;
+        case CompareOp::LESS_EQUAL:
+            KEEP_ROWS(values[row] <= value);
+            break;
+        case CompareOp::GREATER:
+            KEEP_ROWS(values[row] > value);
+            break;
+        default:  // CompareOp::GREATER_EQUAL
+            KEEP_ROWS(values[row] >= value);
+            break;
+    }
+    return kept;
+}
+
+Condition::Condition(size_t column, CompareOp op) : Object() {
+    assert(op == CompareOp::IS_MISSING || op == CompareOp::IS_PRESENT);
+    this->column = column;
+    this->op = op;
+    this->type = ColType::UNKNOWN;
+    this->stringValue = nullptr;
+    this->stringLength = 0;
+}
+
+Condition::Condition(size_t column, CompareOp op, int value)
+    : Condition(column, CompareOp::IS_PRESENT) {
+    this->op = op;
+    this->type = ColType::INTEGER;
+    this->intValue = value;
+}
+
+Condition::Condition(size_t column, CompareOp op, double value)
+    : Condition(column, CompareOp::IS_PRESENT) {
+    this->op = op;
+    this->type = ColType::DOUBLE;
+    this->doubleValue = value;
+}
+
+Condition::Condition(size_t column, CompareOp op, bool value)
+    : Condition(column, CompareOp::IS_PRESENT) {
+    this->op = op;
+    this->type = ColType::BOOLEAN;
+    this->boolValue = value;
+}
+
+Condition::Condition(size_t column, CompareOp op, const char* value)
+    : Condition(column, CompareOp::IS_PRESENT) {
+    assert(value != nullptr);
+    this->op = op;
+    this->type = ColType::STRING;
+    this->stringLength = strlen(value);
+    this->stringValue = new char[this->stringLength + 1];
+    memcpy(this->stringValue, value, this->stringLength + 1);
+}
+
+Condition::~Condition() { delete[] this->stringValue; }
+
+bool Condition::accept(const char* field, size_t length) {
+    if (this->op == CompareOp::IS_MISSING) {
+        return field == nullptr;
+    }
+    if (field == nullptr) {
+        return false;
+    }
+    // the sign of the comparison of the field with the value
+    int order;
+    switch (this->type) {
+        case ColType::INTEGER: {
+            int value;
+            if (!parse_int(field, length, &value)) {
+                return false;
+            }
+            order = (value > this->intValue) - (value < this->intValue);
+            break;
+        }
+        case ColType::DOUBLE: {
+            double value;
+            if (!parse_double(field, length, &value)) {
+                return false;
+            }
+            order = (value > this->doubleValue) - (value < this->doubleValue);
+            break;
+        }
+        case ColType::BOOLEAN: {
+            bool value;
+            if (!parse_bool(field, length, &value)) {
+                return false;
+            }
+            order = (value > this->boolValue) - (value < this->boolValue);
+            break;
+        }
+        case ColType::STRING: {
+            size_t shorter =
+                length < this->stringLength ? length : this->stringLength;
+            order = memcmp(field, this->stringValue, shorter);
+            if (order == 0) {
+                order = (length > this->stringLength) -
+                        (length < this->stringLength);
+            }
+            break;
+        }
+        default:  // CompareOp::IS_PRESENT
+            return true;
+    }
+    return passes(this->op, order);
+}
+
+size_t Condition::select(Column* column, size_t* rows, size_t numRows) {
+    assert(column != nullptr);
+    ColType type = column->get_type();
+    if (this->op == CompareOp::IS_MISSING ||
+        this->op == CompareOp::IS_PRESENT) {
+        if (type != ColType::STRING) {
+            // missing ints, doubles and bools are stored as values
+            return this->op == CompareOp::IS_PRESENT ? numRows : 0;
+        }
+        bool missing = this->op == CompareOp::IS_MISSING;
+        size_t kept = 0;
+        KEEP_ROWS((column->get_string(row) == nullptr) == missing);
+        return kept;
+    }
+    switch (type) {
+        case ColType::INTEGER: {
+            const int* values = column->as_int()->array->array;
+            if (this->type == ColType::INTEGER) {
+                return select_values(values, this->intValue, this->op, rows,
+                                     numRows);
+            } else if (this->type == ColType::DOUBLE) {
+                return select_values(values, this->doubleValue, this->op,
+                                     rows, numRows);
+            }
+            return 0;
+        }
+        case ColType::DOUBLE: {
+            const double* values = column->as_double()->array->array;
+            if (this->type == ColType::DOUBLE) {
+                return select_values(values, this->doubleValue, this->op,
+                                     rows, numRows);
+            } else if (this->type == ColType::INTEGER) {
+                return select_values(values, this->intValue, this->op, rows,
+                                     numRows);
+            }
+            return 0;
+        }
+        case ColType::BOOLEAN:
+            if (this->type != ColType::BOOLEAN) {
+                return 0;
+            }
+            return select_values(column->as_bool()->array->array,
+                                 this->boolValue, this->op, rows, numRows);
+        default: {
+            if (this->type != ColType::STRING) {
+                return 0;
+            }
+            size_t kept = 0;
+            for (size_t i = 0; i < numRows; i++) {
+                String* value = column->get_string(rows[i]);
+                if (value != nullptr &&
+                    this->accept(value->c_str(), value->size())) {
+                    rows[kept++] = rows[i];
+                }
+            }
+            return kept;
+        }
+    }
+}
+
+bool Condition::may_match(ColType type, double minimum, double maximum,
+                          size_t numMissing, size_t numRows) {
+    if (numRows == 0) {
+        return false;
+    }
+    if (this->op == CompareOp::IS_MISSING ||
+        this->op == CompareOp::IS_PRESENT) {
+        if (type != ColType::STRING) {
+            return this->op == CompareOp::IS_PRESENT;
+        }
+        return this->op == CompareOp::IS_MISSING ? numMissing > 0
+                                                 : numMissing < numRows;
+    }
+    // the value, compared with the bounds as select() compares it
+    double value;
+    switch (type) {
+        case ColType::INTEGER:
+        case ColType::DOUBLE:
+            if (this->type == ColType::INTEGER) {
+                value = this->intValue;
+            } else if (this->type == ColType::DOUBLE) {
+                value = this->doubleValue;
+            } else {
+                return false;
+            }
+            break;
+        case ColType::BOOLEAN:
+            if (this->type != ColType::BOOLEAN) {
+                return false;
+            }
+            value = this->boolValue;
+            break;
+        default:
+            // strings have no bounds, but a missing one passes no comparison
+            return this->type == ColType::STRING && numMissing < numRows;
+    }
+    switch (this->op) {
+        case CompareOp::EQUAL:
+            return minimum <= value && value <= maximum;
+        case CompareOp::LESS:
+            return minimum < value;
+        case CompareOp::LESS_EQUAL:
+            return minimum <= value;
+        case CompareOp::GREATER:
+            return maximum > value;
+        case CompareOp::GREATER_EQUAL:
+            return maximum >= value;
+        default:  // CompareOp::NOT_EQUAL, passed by NaNs too
+            return true;
+    }
+}
+
+Predicate::Predicate() : Object() {
+    this->capacity = 4;
+    this->conditions = new Condition*[this->capacity];
+    this->numConditions = 0;
+}
+
+Predicate::~Predicate() {
+    for (size_t i = 0; i < this->numConditions; i++) {
+        delete this->conditions[i];
+    }
+    delete[] this->conditions;
+}
+
+Predicate* Predicate::add(Condition* condition) {
+    assert(condition != nullptr);
+    if (this->numConditions == this->capacity) {
+        this->capacity *= 2;
+        Condition** newConditions = new Condition*[this->capacity];
+        memcpy(newConditions, this->conditions,
+               this->numConditions * sizeof(Condition*));
+        delete[] this->conditions;
+        this->conditions = newConditions;
+    }
+    this->conditions[this->numConditions++] = condition;
+    return this;
+}
+
+bool Predicate::accept(const char** fields, const size_t* lengths,
+                       size_t numFields) {
+    for (size_t i = 0; i < this->numConditions; i++) {
+        Condition* condition = this->conditions[i];
+        size_t column = condition->column;
+        bool present = column < numFields;
+        if (!condition->accept(present ? fields[column] : nullptr,
+                               present ? lengths[column] : 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Predicate::accept(char** fields, size_t numFields) {
+    for (size_t i = 0; i < this->numConditions; i++) {
+        Condition* condition = this->conditions[i];
+        char* field =
+            condition->column < numFields ? fields[condition->column] : nullptr;
+        if (!condition->accept(field, field == nullptr ? 0 : strlen(field))) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,52 @@
+#include "../../include/eau2/sorer/sample_schema_thread.h"
+
+#include <cassert>
+#include <cstring>
+
+#include "../../include/eau2/sorer/sorer.h"
+
+SampleSchemaThread::SampleSchemaThread(const char *data, size_t size)
+    : Thread() {
+    assert(data != nullptr);
+    this->sor = new SOR();
+    this->data = data;
+    this->size = size;
+    this->capacity = 4;
+    this->starts = new size_t[this->capacity];
+    this->numLines = new size_t[this->capacity];
+    this->numBlocks = 0;
+    this->types = new ColTypeArray();
+}
+
+SampleSchemaThread::~SampleSchemaThread() {
+    delete this->sor;
+    delete[] this->starts;
+    delete[] this->numLines;
+    delete this->types;
+}
+
+void SampleSchemaThread::add_block(size_t start, size_t numLines) {
+    if (this->numBlocks == this->capacity) {
+        size_t newCapacity = this->capacity * 2;
+        size_t *newStarts = new size_t[newCapacity];
+        size_t *newNumLines = new size_t[newCapacity];
+        memcpy(newStarts, this->starts, this->numBlocks * sizeof(size_t));
+        memcpy(newNumLines, this->numLines, this->numBlocks * sizeof(size_t));
+        delete[] this->starts;
+        delete[] this->numLines;
+        this->starts = newStarts;
+        this->numLines = newNumLines;
+        this->capacity = newCapacity;
+    }
+    this->starts[this->numBlocks] = start;
+    this->numLines[this->numBlocks] = numLines;
+    this->numBlocks++;
+}
+
+void SampleSchemaThread::run() {
+    for (size_t i = 0; i < this->numBlocks; i++) {
+        this->sor->sample_lines_(this->data + this->starts[i],
+                                 this->data + this->size, this->numLines[i],
+                                 this->types);
+    }
+}
@@ -2,17 +2,45 @@
 
 #include <unistd.h>
 
+#include <cassert>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 #include "../../include/eau2/dataframe/columns/bool_column.h"
 #include "../../include/eau2/dataframe/columns/double_column.h"
 #include "../../include/eau2/dataframe/columns/int_column.h"
 #include "../../include/eau2/dataframe/columns/string_column.h"
+#include "../../include/eau2/sorer/chunk_stream.h"
+#include "../../include/eau2/sorer/column_cache.h"
+#include "../../include/eau2/sorer/parse_range_thread.h"
+#include "../../include/eau2/sorer/sample_schema_thread.h"
+#include "../../include/eau2/utils/mapped_file.h"
 
-SOR::SOR() { columnArray = new ColumnArray(); }
+SOR::SOR() {
+    columnArray = new ColumnArray();
+    fieldCapacity = 16;
+    fields = new const char*[fieldCapacity];
+    lengths = new size_t[fieldCapacity];
+    tokenizer = new Tokenizer();
+    sampleRows = SCHEMA_SAMPLE_ROWS;
+    sampleBlocks = SCHEMA_SAMPLE_BLOCKS;
+    projection = nullptr;
+    numProjected = 0;
+    predicate = nullptr;
+    stats = nullptr;
+    statsOut = nullptr;
+}
 
-SOR::~SOR() { delete columnArray; }
+SOR::~SOR() {
+    delete columnArray;
+    delete[] fields;
+    delete[] lengths;
+    delete tokenizer;
+    delete[] projection;
+    delete stats;
+}
 
 ColType SOR::get_col_type(size_t index) {
     if (index >= static_cast<size_t>(this->columnArray->size())) {
@@ -33,8 +61,56 @@ bool SOR::is_missing(size_t col_index, size_t row_index) {
 }
 
 void SOR::read(FILE* f, size_t from, size_t len) {
+    uint64_t start = this->begin_stats_();
     this->infer_columns_(f, from, len);
     this->parse_(f, from, len);
+    this->end_stats_(start);
+}
+
+void SOR::read(FILE* f, size_t from, size_t len, const size_t* columns,
+               size_t numColumns) {
+    this->select_columns(columns, numColumns);
+    this->read(f, from, len);
+}
+
+void SOR::read(FILE* f, size_t from, size_t len, Predicate* predicate) {
+    this->select_rows(predicate);
+    this->read(f, from, len);
+}
+
+void SOR::select_rows(Predicate* predicate) { this->predicate = predicate; }
+
+void SOR::enable_stats(FILE* out) {
+    if (this->stats == nullptr) {
+        this->stats = new LoadStats();
+    }
+    this->statsOut = out;
+}
+
+uint64_t SOR::begin_stats_() {
+    if (this->stats == nullptr) {
+        return 0;
+    }
+    this->stats->reset();
+    return LoadStats::now_ns();
+}
+
+void SOR::end_stats_(uint64_t start) {
+    if (this->stats == nullptr) {
+        return;
+    }
+    this->stats->totalNanos = LoadStats::now_ns() - start;
+    if (this->statsOut != nullptr) {
+        this->stats->report(this->statsOut);
+    }
+}
+
+void SOR::select_columns(const size_t* columns, size_t numColumns) {
+    assert(this->columnArray->size() == 0);
+    delete[] this->projection;
+    this->projection = new size_t[numColumns];
+    memcpy(this->projection, columns, numColumns * sizeof(size_t));
+    this->numProjected = numColumns;
 }
 
 void SOR::seek_(FILE* f, size_t from) {
@@ -48,35 +124,87 @@ void SOR::seek_(FILE* f, size_t from) {
 }
 
 void SOR::infer_columns_(FILE* f, size_t from, size_t len) {
+    uint64_t time = this->stats != nullptr ? LoadStats::now_ns() : 0;
     seek_(f, from);
-    char buf[buff_len];
-
-    if (fgets(buf, buff_len, f) == nullptr) {
+    size_t start = ftell(f);
+    ColTypeArray* types = new ColTypeArray();
+    if (this->sample_lines_(f, this->sampleRows, types) == 0) {
         exit(1);
     }
+    // one block at a pseudo-random position of every stride of the file,
+    // the same positions the mapped reader samples
+    fseek(f, 0, SEEK_END);
+    size_t size = ftell(f);
+    size_t stride = this->sampleBlocks > 0 && size > start
+                        ? (size - start) / this->sampleBlocks
+                        : 0;
+    unsigned int seed = 1;
+    for (size_t i = 0; stride > 0 && i < this->sampleBlocks; i++) {
+        size_t position = start + i * stride + rand_r(&seed) % stride;
+        seek_(f, position);
+        this->sample_lines_(f, SCHEMA_BLOCK_ROWS, types);
+    }
+    this->add_columns_(types);
+    delete types;
+    if (this->stats != nullptr) {
+        this->lap_(time, &this->stats->schemaNanos);
+    }
+}
 
-    // get the number of fields (columns)
-    size_t num_fields;
-    char** row = parse_row_(buf, &num_fields);
+size_t SOR::sample_lines_(FILE* f, size_t numLines, ColTypeArray* types) {
+    char buf[buff_len];
+    size_t i = 0;
+    for (; i < numLines && fgets(buf, buff_len, f) != nullptr; i++) {
+        size_t num_fields;
+        char** row = parse_row_(buf, &num_fields);
+        for (size_t col = 0; col < num_fields; col++) {
+            ColType type = infer_type(row[col]);
+            if (col == static_cast<size_t>(types->size())) {
+                types->append(type);
+            } else {
+                types->set(col, widen_type(types->get(col), type));
+            }
+        }
+        delete[] row;
+    }
+    return i;
+}
 
-    for (size_t i = 0; i < num_fields; i++) {
-        ColType inferred_type = infer_type(row[i]);
-        switch (inferred_type) {
-            case ColType::BOOLEAN:
-                this->columnArray->append(new BoolColumn());
-                break;
-            case ColType::INTEGER:
-                this->columnArray->append(new IntColumn());
-                break;
-            case ColType::DOUBLE:
-                this->columnArray->append(new DoubleColumn());
-                break;
-            default:
-                this->columnArray->append(new StringColumn());
-                break;
+void SOR::add_column_(ColType type) {
+    switch (type) {
+        case ColType::UNKNOWN:  // only missing values were seen
+        case ColType::BOOLEAN:
+            this->columnArray->append(new BoolColumn());
+            break;
+        case ColType::INTEGER:
+            this->columnArray->append(new IntColumn());
+            break;
+        case ColType::DOUBLE:
+            this->columnArray->append(new DoubleColumn());
+            break;
+        default:
+            this->columnArray->append(new StringColumn());
+            break;
+    }
+}
+
+void SOR::add_columns_(ColTypeArray* types) {
+    if (this->projection == nullptr) {
+        for (int col = 0; col < types->size(); col++) {
+            this->add_column_(types->get(col));
         }
+        return;
+    }
+    for (size_t col = 0; col < this->numProjected; col++) {
+        size_t field = this->projection[col];
+        this->add_column_(field < static_cast<size_t>(types->size())
+                              ? types->get(field)
+                              : ColType::UNKNOWN);
     }
-    delete[] row;
+}
+
+size_t SOR::field_index_(size_t col) {
+    return this->projection == nullptr ? col : this->projection[col];
 }
 
 char* SOR::parse_field_(char* field, int* len) {
@@ -142,29 +270,56 @@ void SOR::parse_(FILE* f, size_t from, size_t len) {
     seek_(f, from);
     char buf[buff_len];
 
+    LoadStats* stats = this->stats;
+    ColType* types = stats != nullptr ? this->col_types_() : nullptr;
     // read a line from the file
     while (fgets(buf, buff_len, f) != nullptr) {
+        uint64_t time = 0;
+        if (stats != nullptr) {
+            time = stats->start_line();
+            stats->bytes += strlen(buf);
+        }
         // number of fields
         size_t num_fields;
         // current row could have more columns than infered - parse the
         // frist len_ columns
         char** row = parse_row_(buf, &num_fields);
+        if (stats != nullptr) {
+            time = this->lap_(time, &stats->tokenizeNanos);
+        }
         // skipping rows with too few fields
         if (num_fields == 0) {
             delete[] row;
             continue;
         }
+        if (this->predicate != nullptr) {
+            bool accepted = this->predicate->accept(row, num_fields);
+            if (stats != nullptr) {
+                stats->filteredRows += accepted ? 0 : 1;
+                time = this->lap_(time, &stats->filterNanos);
+            }
+            if (!accepted) {
+                delete[] row;
+                continue;
+            }
+        }
 
         // we skip the row as soon as we find a field that does not match
         // our schema
         bool skip = false;
         for (int i = 0; i < this->columnArray->size(); i++) {
-            if (!this->columnArray->get(i)->can_add(row[i])) {
+            size_t field = this->field_index_(i);
+            if (field < num_fields &&
+                !this->columnArray->get(i)->can_add(row[field])) {
                 skip = true;
                 break;
             }
         }
         if (skip) {
+            if (stats != nullptr) {
+                this->lap_(time, &stats->convertNanos);
+                this->count_row_(row, num_fields, false, types);
+            }
             delete[] row;
             continue;
         }
@@ -173,16 +328,486 @@ void SOR::parse_(FILE* f, size_t from, size_t len) {
         for (size_t i = 0; i < static_cast<size_t>(this->columnArray->size());
              i++) {
             Column* col = this->columnArray->get(i);
-            if (i >= num_fields || row[i] == nullptr) {
+            size_t field = this->field_index_(i);
+            if (field >= num_fields || row[field] == nullptr) {
                 col->push_nullptr();
             } else {
-                col->push_back(row[i]);
+                col->push_back(row[field]);
             }
         }
+        if (stats != nullptr) {
+            this->lap_(time, &stats->convertNanos);
+            this->count_row_(row, num_fields, true, types);
+        }
         delete[] row;
     }
+    delete[] types;
 }
 
 DataFrame* SOR::get_dataframe() {
     return DataFrame::fromColumns(this->columnArray);
-}
\ No newline at end of file
+}
+
+bool SOR::read_mapped(const char* path, size_t from, size_t len) {
+    MappedFile* file = new MappedFile(path);
+    if (!file->is_open()) {
+        delete file;
+        return false;
+    }
+    uint64_t start = this->begin_stats_();
+    this->read_bytes(reinterpret_cast<const char*>(file->data), file->size(),
+                     from, len);
+    this->end_stats_(start);
+    // the columns hold copies of strings, nothing points into the mapping
+    delete file;
+    return true;
+}
+
+bool SOR::read_parallel(const char* path, size_t from, size_t len,
+                        size_t numThreads) {
+    MappedFile* file = new MappedFile(path);
+    if (!file->is_open()) {
+        delete file;
+        return false;
+    }
+    uint64_t begin = this->begin_stats_();
+    const char* data = reinterpret_cast<const char*>(file->data);
+    size_t size = file->size();
+    size_t start = line_start_(data, size, from);
+    size_t last = from + len >= from && from + len < size ? from + len : size;
+    if (start >= last) {
+        this->end_stats_(begin);
+        delete file;
+        return true;
+    }
+    if (numThreads == 0) {
+        numThreads = std::thread::hardware_concurrency();
+    }
+    numThreads = numThreads > 0 ? numThreads : 1;
+    // no more chunks than bytes, and no chunk left empty by the rounding
+    numThreads = numThreads < last - from ? numThreads : last - from;
+    size_t chunkSize = (last - from + numThreads - 1) / numThreads;
+    numThreads = (last - from + chunkSize - 1) / chunkSize;
+    if (this->columnArray->size() == 0) {
+        this->infer_columns_(data, size, start, numThreads);
+    }
+
+    // 0. initialize a SOR with the shared schema per chunk
+    SOR** chunks = new SOR*[numThreads];
+    ParseRangeThread** threads = new ParseRangeThread*[numThreads];
+    for (size_t i = 0; i < numThreads; i++) {
+        chunks[i] = new SOR();
+        if (this->projection != nullptr) {
+            chunks[i]->select_columns(this->projection, this->numProjected);
+        }
+        chunks[i]->select_rows(this->predicate);
+        if (this->stats != nullptr) {
+            chunks[i]->enable_stats(nullptr);
+        }
+        for (int col = 0; col < this->columnArray->size(); col++) {
+            chunks[i]->add_column_(this->get_col_type(col));
+        }
+        size_t chunkFrom = from + i * chunkSize;
+        size_t chunkLen =
+            last - chunkFrom < chunkSize ? last - chunkFrom : chunkSize;
+        threads[i] =
+            new ParseRangeThread(chunks[i], data, size, chunkFrom, chunkLen);
+    }
+
+    // 1. parse the chunks
+    for (size_t i = 0; i < numThreads; i++) {
+        threads[i]->start();
+    }
+    for (size_t i = 0; i < numThreads; i++) {
+        threads[i]->join();
+    }
+
+    // 2. move the chunks to the columns in order
+    for (size_t i = 0; i < numThreads; i++) {
+        for (int col = 0; col < this->columnArray->size(); col++) {
+            this->columnArray->get(col)->extend(
+                chunks[i]->columnArray->get(col));
+        }
+        if (this->stats != nullptr) {
+            this->stats->merge(chunks[i]->stats);
+        }
+        delete chunks[i];
+        delete threads[i];
+    }
+    delete[] chunks;
+    delete[] threads;
+    delete file;
+    this->end_stats_(begin);
+    return true;
+}
+
+bool SOR::read_cached(const char* path) {
+    if (this->predicate != nullptr) {
+        return this->read_mapped(path, 0, SIZE_MAX);
+    }
+    if (this->projection == nullptr) {
+        uint64_t start = this->begin_stats_();
+        if (this->columnArray->size() == 0 &&
+            ColumnCache::load(path, this->columnArray)) {
+            if (this->stats != nullptr && this->columnArray->size() > 0) {
+                this->stats->rows = this->columnArray->get(0)->size();
+            }
+            this->end_stats_(start);
+            return true;
+        }
+        if (!this->read_mapped(path, 0, SIZE_MAX)) {
+            return false;
+        }
+        // a cache that cannot be written only costs the next run a parse
+        ColumnCache::write(path, this->columnArray);
+        return true;
+    }
+    if (this->columnArray->size() > 0) {
+        // the columns of the cache would not be those of the file
+        return this->read_mapped(path, 0, SIZE_MAX);
+    }
+    // the cache holds every column, the read ones are kept from it
+    uint64_t start = this->begin_stats_();
+    SOR* all = new SOR();
+    if (!all->read_cached(path)) {
+        delete all;
+        return false;
+    }
+    size_t numRows =
+        all->columnArray->size() > 0 ? all->columnArray->get(0)->size() : 0;
+    for (size_t col = 0; col < this->numProjected; col++) {
+        size_t field = this->projection[col];
+        if (field < static_cast<size_t>(all->columnArray->size())) {
+            this->add_column_(all->get_col_type(field));
+            this->columnArray->get(col)->extend(
+                all->columnArray->get(field));
+        } else {
+            this->add_column_(ColType::UNKNOWN);
+            for (size_t row = 0; row < numRows; row++) {
+                this->columnArray->get(col)->push_nullptr();
+            }
+        }
+    }
+    delete all;
+    if (this->stats != nullptr) {
+        this->stats->rows = numRows;
+    }
+    this->end_stats_(start);
+    return true;
+}
+
+bool SOR::stream_mapped(const char* path, KVStore* kv, const char* name,
+                        size_t chunkRows, size_t maxPending) {
+    MappedFile* file = new MappedFile(path);
+    if (!file->is_open()) {
+        delete file;
+        return false;
+    }
+    uint64_t start = this->begin_stats_();
+    const char* data = reinterpret_cast<const char*>(file->data);
+    const char* end = data + file->size();
+    if (this->stats != nullptr) {
+        this->stats->bytes += file->size();
+    }
+    if (this->columnArray->size() == 0 && data != end) {
+        this->infer_columns_(data, file->size(), 0, 1);
+    }
+    ColTypeArray* types = new ColTypeArray();
+    for (int col = 0; col < this->columnArray->size(); col++) {
+        types->append(this->get_col_type(col));
+    }
+    ChunkStream* stream =
+        new ChunkStream(kv, name, types, chunkRows, maxPending);
+    stream->start();
+    ColumnArray* schema = this->columnArray;
+    const char* line = data;
+    while (line < end) {
+        // the chunk is parsed into fresh columns of the schema
+        this->columnArray = new ColumnArray();
+        for (int col = 0; col < types->size(); col++) {
+            this->add_column_(types->get(col));
+        }
+        line = this->parse_(line, end, end, chunkRows);
+        if (this->columnArray->size() > 0 &&
+            this->columnArray->get(0)->size() > 0) {
+            stream->push(this->columnArray);
+        } else {
+            delete this->columnArray;
+        }
+    }
+    this->columnArray = schema;
+    stream->finish();
+    this->end_stats_(start);
+    delete stream;
+    delete types;
+    delete file;
+    return true;
+}
+
+void SOR::read_bytes(const char* data, size_t size, size_t from, size_t len) {
+    size_t start = line_start_(data, size, from);
+    // the range ends at the end of the data if it goes past it or overflows
+    size_t last = from + len >= from && from + len < size ? from + len : size;
+    if (start >= last) {
+        return;
+    }
+    if (this->columnArray->size() == 0) {
+        this->infer_columns_(data, size, start, 1);
+    }
+    const char* stop =
+        this->parse_(data + start, data + last, data + size, SIZE_MAX);
+    if (this->stats != nullptr) {
+        this->stats->bytes += stop - (data + start);
+    }
+}
+
+size_t SOR::line_start_(const char* data, size_t size, size_t from) {
+    if (from == 0) {
+        return 0;
+    }
+    if (from >= size) {
+        return size;
+    }
+    // the line holding from - 1 belongs to the previous range
+    const char* newline = static_cast<const char*>(
+        memchr(data + from - 1, '\n', size - from + 1));
+    return newline == nullptr ? size : newline - data + 1;
+}
+
+const char* SOR::tokenize_line_(const char* line, const char* end,
+                                size_t* numFields) {
+    Tokenizer* tokenizer = this->tokenizer;
+    // the blocks are relative to the data the tokenizer was reset with
+    if (tokenizer->end != end || line < tokenizer->data) {
+        tokenizer->reset(line, end);
+    }
+    const char* position = tokenizer->next(line);
+    size_t count = 0;
+    while (position < end && *position != '\n') {
+        if (*position != '<') {
+            position = tokenizer->next(position + 1);
+            continue;
+        }
+        const char* field = position + 1;
+        while (field < end && *field == ' ') {
+            field++;
+        }
+        const char* close;
+        size_t length;
+        if (field < end && *field == '"') {
+            // strings may hold any character up to the closing quote
+            field++;
+            close = tokenizer->next(field);
+            while (close < end && *close != '"' && *close != '\n') {
+                close = tokenizer->next(close + 1);
+            }
+            length = close - field;
+            if (close < end && *close == '"') {
+                close++;
+            }
+        } else {
+            close = tokenizer->next(field);
+            while (close < end && *close != '>' && *close != '\n') {
+                close = tokenizer->next(close + 1);
+            }
+            // a value ends at the first space before the closing '>'
+            const char* stop = field;
+            while (stop < close && *stop != ' ') {
+                stop++;
+            }
+            length = stop - field;
+            if (length == 0) {
+                field = nullptr;  // missing value
+            }
+        }
+        close = tokenizer->next(close);
+        while (close < end && *close != '>' && *close != '\n') {
+            close = tokenizer->next(close + 1);
+        }
+        if (close < end && *close == '>') {
+            close++;
+        }
+        if (count == this->fieldCapacity) {
+            size_t newCapacity = this->fieldCapacity * 2;
+            const char** newFields = new const char*[newCapacity];
+            size_t* newLengths = new size_t[newCapacity];
+            memcpy(newFields, this->fields, count * sizeof(const char*));
+            memcpy(newLengths, this->lengths, count * sizeof(size_t));
+            delete[] this->fields;
+            delete[] this->lengths;
+            this->fields = newFields;
+            this->lengths = newLengths;
+            this->fieldCapacity = newCapacity;
+        }
+        this->fields[count] = field;
+        this->lengths[count] = length;
+        count++;
+        position = tokenizer->next(close);
+    }
+    *numFields = count;
+    return position < end ? position + 1 : end;
+}
+
+void SOR::infer_columns_(const char* data, size_t size, size_t start,
+                         size_t numThreads) {
+    uint64_t time = this->stats != nullptr ? LoadStats::now_ns() : 0;
+    SampleSchemaThread** threads = new SampleSchemaThread*[numThreads];
+    for (size_t i = 0; i < numThreads; i++) {
+        threads[i] = new SampleSchemaThread(data, size);
+    }
+    threads[0]->add_block(start, this->sampleRows);
+    // one block at a pseudo-random position of every stride of the data
+    size_t stride =
+        this->sampleBlocks > 0 ? (size - start) / this->sampleBlocks : 0;
+    unsigned int seed = 1;
+    for (size_t i = 0; stride > 0 && i < this->sampleBlocks; i++) {
+        size_t position = start + i * stride + rand_r(&seed) % stride;
+        size_t blockStart = line_start_(data, size, position);
+        if (blockStart < size) {
+            threads[i % numThreads]->add_block(blockStart, SCHEMA_BLOCK_ROWS);
+        }
+    }
+
+    if (numThreads == 1) {
+        threads[0]->run();
+    } else {
+        for (size_t i = 0; i < numThreads; i++) {
+            threads[i]->start();
+        }
+        for (size_t i = 0; i < numThreads; i++) {
+            threads[i]->join();
+        }
+    }
+
+    // the columns of the longest line, with the types seen by every thread
+    ColTypeArray* types = new ColTypeArray();
+    for (size_t i = 0; i < numThreads; i++) {
+        ColTypeArray* sampled = threads[i]->types;
+        for (int col = 0; col < sampled->size(); col++) {
+            if (col == types->size()) {
+                types->append(sampled->get(col));
+            } else {
+                types->set(col, widen_type(types->get(col), sampled->get(col)));
+            }
+        }
+        delete threads[i];
+    }
+    this->add_columns_(types);
+    delete types;
+    delete[] threads;
+    if (this->stats != nullptr) {
+        this->lap_(time, &this->stats->schemaNanos);
+    }
+}
+
+void SOR::sample_lines_(const char* line, const char* end, size_t numLines,
+                        ColTypeArray* types) {
+    // other data may have been mapped where the data last scanned was
+    this->tokenizer->reset(line, end);
+    for (size_t i = 0; i < numLines && line < end; i++) {
+        size_t numFields;
+        line = this->tokenize_line_(line, end, &numFields);
+        for (size_t col = 0; col < numFields; col++) {
+            ColType type = infer_type(this->fields[col], this->lengths[col]);
+            if (col == static_cast<size_t>(types->size())) {
+                types->append(type);
+            } else {
+                types->set(col, widen_type(types->get(col), type));
+            }
+        }
+    }
+}
+
+const char* SOR::parse_(const char* line, const char* last, const char* end,
+                        size_t maxRows) {
+    size_t numCols = this->columnArray->size();
+    size_t numRows = 0;
+    LoadStats* stats = this->stats;
+    ColType* types = stats != nullptr ? this->col_types_() : nullptr;
+    // other data may have been mapped where the data last scanned was
+    this->tokenizer->reset(line, end);
+    while (line < last && numRows < maxRows) {
+        uint64_t time = stats != nullptr ? stats->start_line() : 0;
+        size_t num_fields;
+        const char* next = this->tokenize_line_(line, end, &num_fields);
+        line = next;
+        if (stats != nullptr) {
+            time = this->lap_(time, &stats->tokenizeNanos);
+        }
+        // skipping rows with too few fields
+        if (num_fields == 0) {
+            continue;
+        }
+        // the predicate only looks at the fields it needs, before any of
+        // them is converted
+        if (this->predicate != nullptr) {
+            bool accepted = this->predicate->accept(
+                this->fields, this->lengths, num_fields);
+            if (stats != nullptr) {
+                stats->filteredRows += accepted ? 0 : 1;
+                time = this->lap_(time, &stats->filterNanos);
+            }
+            if (!accepted) {
+                continue;
+            }
+        }
+        // every field is validated and converted in a single pass; we skip
+        // the row as soon as we find a field that does not match our schema
+        size_t pushed = 0;
+        for (; pushed < numCols; pushed++) {
+            Column* col = this->columnArray->get(pushed);
+            size_t field = this->field_index_(pushed);
+            if (field >= num_fields) {
+                col->push_nullptr();
+            } else if (!col->push_back(this->fields[field],
+                                       this->lengths[field])) {
+                break;
+            }
+        }
+        if (pushed < numCols) {
+            for (size_t i = 0; i < pushed; i++) {
+                this->columnArray->get(i)->pop_back();
+            }
+        } else {
+            numRows++;
+        }
+        if (stats != nullptr) {
+            this->lap_(time, &stats->convertNanos);
+            this->count_row_(this->fields, num_fields, pushed == numCols,
+                             types);
+        }
+    }
+    delete[] types;
+    return line;
+}
+
+uint64_t SOR::lap_(uint64_t start, uint64_t* nanos) {
+    if (start == 0) {
+        return 0;  // the line is not timed
+    }
+    uint64_t now = LoadStats::now_ns();
+    *nanos += now - start;
+    return now;
+}
+
+void SOR::count_row_(const char* const* fields, size_t numFields,
+                     bool added, const ColType* types) {
+    if (!added) {
+        this->stats->skippedRows++;
+        return;
+    }
+    this->stats->rows++;
+    for (int col = 0; col < this->columnArray->size(); col++) {
+        size_t field = this->field_index_(col);
+        this->stats->add_field(types[col],
+                               field >= numFields || fields[field] == nullptr);
+    }
+}
+
+ColType* SOR::col_types_() {
+    ColType* types = new ColType[this->columnArray->size()];
+    for (int col = 0; col < this->columnArray->size(); col++) {
+        types[col] = this->get_col_type(col);
+    }
+    return types;
+}
@@ -0,0 +1,110 @@
+#include "../../include/eau2/sorer/tokenizer.h"
+
+#include <cassert>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TOKENIZER_X86
+#endif
+
+// bitmask of the structural characters among the given bytes
+static uint64_t scan_scalar(const char* block, size_t length) {
+    uint64_t mask = 0;
+    for (size_t i = 0; i < length; i++) {
+        char c = block[i];
+        if (c == '<' || c == '>' || c == '"' || c == '\n') {
+            mask |= static_cast<uint64_t>(1) << i;
+        }
+    }
+    return mask;
+}
+
+#ifdef TOKENIZER_X86
+__attribute__((target("sse2"))) static uint64_t scan_sse2(const char* block) {
+    const __m128i open = _mm_set1_epi8('<');
+    const __m128i close = _mm_set1_epi8('>');
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i newline = _mm_set1_epi8('\n');
+    uint64_t mask = 0;
+    for (int i = 0; i < TOKENIZER_BLOCK; i += 16) {
+        __m128i bytes =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+        __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, open),
+                         _mm_cmpeq_epi8(bytes, close)),
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, quote),
+                         _mm_cmpeq_epi8(bytes, newline)));
+        uint64_t bits = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+        mask |= bits << i;
+    }
+    return mask;
+}
+
+__attribute__((target("avx2"))) static uint64_t scan_avx2(const char* block) {
+    const __m256i open = _mm256_set1_epi8('<');
+    const __m256i close = _mm256_set1_epi8('>');
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    uint64_t mask = 0;
+    for (int i = 0; i < TOKENIZER_BLOCK; i += 32) {
+        __m256i bytes =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + i));
+        __m256i hits = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(bytes, open),
+                            _mm256_cmpeq_epi8(bytes, close)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(bytes, quote),
+                            _mm256_cmpeq_epi8(bytes, newline)));
+        uint64_t bits = static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+        mask |= bits << i;
+    }
+    return mask;
+}
+#endif
+
+Tokenizer::Tokenizer() : Tokenizer(Tokenizer::best_level()) {}
+
+Tokenizer::Tokenizer(ScanLevel level) : Object() {
+    assert(level <= Tokenizer::best_level());
+    this->level = level;
+    this->data = nullptr;
+    this->end = nullptr;
+    this->blockStart = nullptr;
+    this->mask = 0;
+}
+
+void Tokenizer::reset(const char* data, const char* end) {
+    this->data = data;
+    this->end = end;
+    this->blockStart = nullptr;
+    this->mask = 0;
+}
+
+uint64_t Tokenizer::scan(const char* block) {
+    // the last block may be partial; the vector scans would read past it
+    if (this->end - block < TOKENIZER_BLOCK) {
+        return scan_scalar(block, this->end - block);
+    }
+#ifdef TOKENIZER_X86
+    switch (this->level) {
+        case ScanLevel::AVX2:
+            return scan_avx2(block);
+        case ScanLevel::SSE2:
+            return scan_sse2(block);
+        default:
+            break;
+    }
+#endif
+    return scan_scalar(block, TOKENIZER_BLOCK);
+}
+
+ScanLevel Tokenizer::best_level() {
+#ifdef TOKENIZER_X86
+    if (__builtin_cpu_supports("avx2")) {
+        return ScanLevel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return ScanLevel::SSE2;
+    }
+#endif
+    return ScanLevel::SCALAR;
+}
@@ -0,0 +1,41 @@
+#include "../../include/eau2/utils/mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const char* path) : Object() {
+    this->data = nullptr;
+    this->length = 0;
+    this->fd = open(path, O_RDONLY);
+    if (this->fd < 0) {
+        return;
+    }
+    struct stat info;
+    if (fstat(this->fd, &info) != 0 || info.st_size == 0) {
+        return;
+    }
+    void* mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE,
+                         this->fd, 0);
+    if (mapping == MAP_FAILED) {
+        close(this->fd);
+        this->fd = -1;
+        return;
+    }
+    this->data = static_cast<byte*>(mapping);
+    this->length = info.st_size;
+}
+
+bool MappedFile::is_open() { return this->fd >= 0; }
+
+size_t MappedFile::size() { return this->length; }
+
+MappedFile::~MappedFile() {
+    if (this->data != nullptr) {
+        munmap(this->data, this->length);
+    }
+    if (this->fd >= 0) {
+        close(this->fd);
+    }
+}
@@ -7,7 +7,7 @@
 String::String(char const* cstr, size_t len) {
     size_ = len;
     cstr_ = new char[size_ + 1];
-    memcpy(cstr_, cstr, size_ + 1);
+    memcpy(cstr_, cstr, size_);
     cstr_[size_] = 0;  // terminate
 }
 
@@ -0,0 +1,1134 @@
+#include <cassert>
+#include <climits>
+#include <cstring>
+#include <iostream>
+
+#include "../../include/eau2/dataframe/column_index.h"
+#include "../../include/eau2/dataframe/columns/bool_column.h"
+#include "../../include/eau2/dataframe/columns/double_column.h"
+#include "../../include/eau2/dataframe/columns/int_column.h"
+#include "../../include/eau2/dataframe/columns/string_column.h"
+#include "../../include/eau2/dataframe/dataframe.h"
+#include "../../include/eau2/dataframe/expr.h"
+#include "../../include/eau2/dataframe/group_by.h"
+#include "../../include/eau2/dataframe/hash_join.h"
+#include "../../include/eau2/dataframe/quantile_sketch.h"
+#include "../../include/eau2/dataframe/query.h"
+#include "../../include/eau2/dataframe/sort_by.h"
+#include "../../include/eau2/dataframe/typed_column_view.h"
+#include "../../include/eau2/dataframe/zone_map.h"
+
+void FAIL() { exit(1); }
+void OK(const char* m) {
+    const char* filename = "[test_dataframe.cpp]";
+    printf("%s %s: [passed]\n", filename, m);
+}
+
+// the string key of the given row of the data frame of testGroupBy()
+const char* stringKey(size_t row) {
+    if (row % 5 == 0) {
+        return nullptr;
+    }
+    return row % 2 == 0 ? "even" : "odd";
+}
+
+// a data frame of an int key, a string key, a double, a bool and an int
+DataFrame* groupedFrame(size_t numRows) {
+    ColumnArray* columns = new ColumnArray();
+    IntColumn* intKeys = new IntColumn();
+    StringColumn* stringKeys = new StringColumn();
+    DoubleColumn* doubles = new DoubleColumn();
+    BoolColumn* bools = new BoolColumn();
+    IntColumn* ints = new IntColumn();
+    for (size_t row = 0; row < numRows; row++) {
+        intKeys->push_back(static_cast<int>(row % 7));
+        const char* key = stringKey(row);
+        if (key == nullptr) {
+            stringKeys->push_nullptr();
+        } else {
+            stringKeys->push_back(new String(key));
+        }
+        doubles->push_back(row * 0.5 - 100);
+        bools->push_back(row % 3 == 0);
+        ints->push_back(static_cast<int>(row));
+    }
+    columns->append(intKeys);
+    columns->append(stringKeys);
+    columns->append(doubles);
+    columns->append(bools);
+    columns->append(ints);
+    DataFrame* df = DataFrame::fromColumns(columns);
+    delete columns;
+    return df;
+}
+
+void testGroupBy() {
+    size_t numRows = 10000;
+    DataFrame* df = groupedFrame(numRows);
+    size_t keys[] = {0, 1};
+    AggOp ops[] = {AggOp::COUNT, AggOp::SUM, AggOp::MIN,
+                   AggOp::MAX,   AggOp::MEAN, AggOp::SUM};
+    size_t cols[] = {1, 4, 2, 4, 2, 3};
+
+    // the groups in the order they first appear, computed row by row
+    size_t numGroups = 0;
+    size_t firstRows[64];
+    size_t counts[64] = {0};
+    long sums[64] = {0};
+    double minimums[64];
+    int maximums[64];
+    double doubleSums[64] = {0};
+    int trues[64] = {0};
+    for (size_t row = 0; row < numRows; row++) {
+        size_t group = 0;
+        while (group < numGroups &&
+               (firstRows[group] % 7 != row % 7 ||
+                stringKey(firstRows[group]) != stringKey(row))) {
+            group++;
+        }
+        if (group == numGroups) {
+            firstRows[numGroups++] = row;
+            minimums[group] = row * 0.5 - 100;
+        }
+        counts[group]++;
+        sums[group] += row;
+        maximums[group] = row;  // the rows grow
+        doubleSums[group] += row * 0.5 - 100;
+        trues[group] += row % 3 == 0;
+    }
+    assert(numGroups == 21);
+
+    for (size_t numThreads = 1; numThreads <= 5; numThreads++) {
+        GroupBy* groupBy = df->group_by(keys, 2);
+        groupBy->numThreads = numThreads;
+        DataFrame* result = groupBy->agg(ops, cols, 6);
+        assert(result->ncols() == 8);
+        assert(result->nrows() == numGroups);
+        assert(result->get_schema().col_type(0) == 'I');
+        assert(result->get_schema().col_type(1) == 'S');
+        assert(result->get_schema().col_type(2) == 'I');
+        assert(result->get_schema().col_type(3) == 'D');
+        assert(result->get_schema().col_type(4) == 'D');
+        assert(result->get_schema().col_type(5) == 'I');
+        assert(result->get_schema().col_type(6) == 'D');
+        assert(result->get_schema().col_type(7) == 'D');
+        for (size_t group = 0; group < numGroups; group++) {
+            size_t row = firstRows[group];
+            assert(result->get_int(0, group) == static_cast<int>(row % 7));
+            String* key = result->get_string(1, group);
+            if (stringKey(row) == nullptr) {
+                assert(key == nullptr);
+            } else {
+                assert(strcmp(key->c_str(), stringKey(row)) == 0);
+            }
+            assert(result->get_int(2, group) ==
+                   static_cast<int>(counts[group]));
+            assert(result->get_double(3, group) == sums[group]);
+            assert(result->get_double(4, group) == minimums[group]);
+            assert(result->get_int(5, group) == maximums[group]);
+            assert(result->get_double(6, group) ==
+                   doubleSums[group] / counts[group]);
+            assert(result->get_double(7, group) == trues[group]);
+        }
+        delete result;
+        delete groupBy;
+    }
+    delete df;
+    OK("group by");
+}
+
+void testGroupByEdges() {
+    // no rows, no groups
+    DataFrame* empty = groupedFrame(0);
+    size_t keys[] = {3};
+    AggOp ops[] = {AggOp::COUNT};
+    size_t cols[] = {0};
+    GroupBy* groupBy = empty->group_by(keys, 1);
+    DataFrame* result = groupBy->agg(ops, cols, 1);
+    assert(result->ncols() == 2 && result->nrows() == 0);
+    delete result;
+    delete groupBy;
+    delete empty;
+
+    // more threads than rows, grouped by a bool
+    DataFrame* df = groupedFrame(5);
+    groupBy = df->group_by(keys, 1);
+    groupBy->numThreads = 8;
+    result = groupBy->agg(ops, cols, 1);
+    assert(result->nrows() == 2);
+    assert(result->get_bool(0, 0) && result->get_int(1, 0) == 2);
+    assert(!result->get_bool(0, 1) && result->get_int(1, 1) == 3);
+    delete result;
+    delete groupBy;
+    delete df;
+
+    // sums past the range of an int
+    ColumnArray* columns = new ColumnArray();
+    IntColumn* groups = new IntColumn();
+    IntColumn* values = new IntColumn();
+    for (size_t row = 0; row < 3; row++) {
+        groups->push_back(1);
+        values->push_back(2000000000);
+    }
+    columns->append(groups);
+    columns->append(values);
+    df = DataFrame::fromColumns(columns);
+    delete columns;
+    size_t groupKeys[] = {0};
+    AggOp sum[] = {AggOp::SUM};
+    size_t sumCols[] = {1};
+    groupBy = df->group_by(groupKeys, 1);
+    result = groupBy->agg(sum, sumCols, 1);
+    assert(result->nrows() == 1 && result->get_double(1, 0) == 6e9);
+    delete result;
+    delete groupBy;
+    delete df;
+    OK("group by edges");
+}
+
+// the key of the given row of the right data frame of testJoin(), from 2 to 9
+// with every key on (key % 3) + 1 rows
+int rightKey(size_t row) {
+    int key = 2;
+    while (row >= static_cast<size_t>(key % 3 + 1)) {
+        row -= key % 3 + 1;
+        key = key == 9 ? 2 : key + 1;
+    }
+    return key;
+}
+
+// a data frame of an int key, from rightKey(), and the row plus one
+DataFrame* rightFrame(size_t numRows) {
+    ColumnArray* columns = new ColumnArray();
+    IntColumn* keys = new IntColumn();
+    IntColumn* rows = new IntColumn();
+    for (size_t row = 0; row < numRows; row++) {
+        keys->push_back(rightKey(row));
+        rows->push_back(static_cast<int>(row + 1));
+    }
+    columns->append(keys);
+    columns->append(rows);
+    DataFrame* df = DataFrame::fromColumns(columns);
+    delete columns;
+    return df;
+}
+
+// checks that the rows of the join of groupedFrame(numLeft) with
+// rightFrame(numRight) on their int keys are every pair of rows with equal
+// keys, once, and for a LEFT join every row of left without a match
+void checkJoin(DataFrame* result, size_t numLeft, size_t numRight,
+               JoinType type) {
+    assert(result->ncols() == 7);
+    assert(result->get_schema().col_type(1) == 'S');
+    assert(result->get_schema().col_type(6) == 'I');
+    size_t expected = 0;
+    for (size_t left = 0; left < numLeft; left++) {
+        size_t matches = 0;
+        for (size_t right = 0; right < numRight; right++) {
+            matches += static_cast<int>(left % 7) == rightKey(right);
+        }
+        expected += matches == 0 && type == JoinType::LEFT ? 1 : matches;
+    }
+    assert(result->nrows() == expected);
+    bool* seen = new bool[numLeft * (numRight + 1)]();
+    for (size_t row = 0; row < expected; row++) {
+        size_t left = result->get_int(4, row);
+        size_t right = result->get_int(6, row);  // 0 if unmatched
+        assert(result->get_int(0, row) == static_cast<int>(left % 7));
+        String* key = result->get_string(1, row);
+        assert(stringKey(left) == nullptr
+                   ? key == nullptr
+                   : strcmp(key->c_str(), stringKey(left)) == 0);
+        assert(result->get_double(2, row) == left * 0.5 - 100);
+        if (right == 0) {
+            assert(type == JoinType::LEFT && left % 7 < 2);
+            assert(result->get_int(5, row) == 0);
+        } else {
+            assert(result->get_int(5, row) == rightKey(right - 1));
+            assert(result->get_int(5, row) == static_cast<int>(left % 7));
+        }
+        assert(!seen[left * (numRight + 1) + right]);
+        seen[left * (numRight + 1) + right] = true;
+    }
+    delete[] seen;
+}
+
+void testJoin() {
+    size_t numLeft = 300;
+    size_t numRight = 40;
+    DataFrame* left = groupedFrame(numLeft);
+    DataFrame* right = rightFrame(numRight);
+    size_t leftKeys[] = {0};
+    size_t rightKeys[] = {0};
+    JoinType types[] = {JoinType::INNER, JoinType::LEFT};
+    for (JoinType type : types) {
+        for (size_t numThreads = 1; numThreads <= 3; numThreads++) {
+            // the whole table, then partitions of at most 64 bytes
+            size_t cacheBytes[] = {JOIN_CACHE_BYTES, 64};
+            for (size_t bytes : cacheBytes) {
+                HashJoin join(left, right, leftKeys, rightKeys, 1, type);
+                join.numThreads = numThreads;
+                join.cacheBytes = bytes;
+                DataFrame* result = join.run();
+                checkJoin(result, numLeft, numRight, type);
+                if (numThreads == 1 && bytes == JOIN_CACHE_BYTES) {
+                    // in the order of left, then of right
+                    for (size_t row = 1; row < result->nrows(); row++) {
+                        int previous = result->get_int(4, row - 1);
+                        int current = result->get_int(4, row);
+                        assert(previous < current ||
+                               (previous == current &&
+                                result->get_int(6, row - 1) <
+                                    result->get_int(6, row)));
+                    }
+                }
+                delete result;
+            }
+        }
+    }
+
+    // an INNER join builds on the smaller side, here left
+    DataFrame* result = right->join(left, rightKeys, leftKeys, 1,
+                                    JoinType::INNER);
+    DataFrame* swapped = left->join(right, leftKeys, rightKeys, 1,
+                                    JoinType::INNER);
+    assert(result->ncols() == 7 && result->nrows() == swapped->nrows());
+    assert(result->get_schema().col_type(0) == 'I');
+    assert(result->get_schema().col_type(3) == 'S');
+    for (size_t row = 0; row < result->nrows(); row++) {
+        assert(result->get_int(0, row) == result->get_int(2, row));
+    }
+    delete result;
+    delete swapped;
+    delete left;
+    delete right;
+    OK("join");
+}
+
+void testJoinKeys() {
+    // two keys, with missing strings joining missing strings
+    size_t numLeft = 100;
+    size_t numRight = 30;
+    DataFrame* left = groupedFrame(numLeft);
+    DataFrame* right = groupedFrame(numRight);
+    size_t keys[] = {0, 1};
+    size_t expected = 0;
+    for (size_t l = 0; l < numLeft; l++) {
+        for (size_t r = 0; r < numRight; r++) {
+            expected += l % 7 == r % 7 && stringKey(l) == stringKey(r);
+        }
+    }
+    DataFrame* result = left->join(right, keys, keys, 2, JoinType::INNER);
+    assert(result->ncols() == 10 && result->nrows() == expected);
+    for (size_t row = 0; row < expected; row++) {
+        size_t l = result->get_int(4, row);
+        size_t r = result->get_int(9, row);
+        assert(l % 7 == r % 7 && stringKey(l) == stringKey(r));
+    }
+    delete result;
+
+    // no rows on either side
+    DataFrame* empty = groupedFrame(0);
+    result = empty->join(right, keys, keys, 2, JoinType::LEFT);
+    assert(result->ncols() == 10 && result->nrows() == 0);
+    delete result;
+    result = right->join(empty, keys, keys, 2, JoinType::LEFT);
+    assert(result->nrows() == numRight);
+    for (size_t row = 0; row < numRight; row++) {
+        assert(result->get_int(4, row) == static_cast<int>(row));
+        assert(result->get_string(6, row) == nullptr);
+    }
+    delete result;
+    delete empty;
+    delete left;
+    delete right;
+    OK("join keys");
+}
+
+// a data frame of random ints, doubles, bools and strings, some missing and
+// some -0.0, and the row
+DataFrame* randomFrame(size_t numRows) {
+    ColumnArray* columns = new ColumnArray();
+    IntColumn* ints = new IntColumn();
+    DoubleColumn* doubles = new DoubleColumn();
+    BoolColumn* bools = new BoolColumn();
+    StringColumn* strings = new StringColumn();
+    IntColumn* rows = new IntColumn();
+    unsigned int seed = 7;
+    char value[8];
+    for (size_t row = 0; row < numRows; row++) {
+        ints->push_back(static_cast<int>(rand_r(&seed)) - RAND_MAX / 2);
+        int d = rand_r(&seed) % 2001 - 1000;
+        doubles->push_back(d == 0 && row % 2 == 0 ? -0.0 : d / 8.0);
+        bools->push_back(rand_r(&seed) % 2 == 0);
+        if (rand_r(&seed) % 10 == 0) {
+            strings->push_nullptr();
+        } else {
+            // few distinct strings, some the prefix of others
+            snprintf(value, sizeof(value), "%.*s", rand_r(&seed) % 4,
+                     "abc" + rand_r(&seed) % 2);
+            strings->push_back(new String(value));
+        }
+        rows->push_back(static_cast<int>(row));
+    }
+    columns->append(ints);
+    columns->append(doubles);
+    columns->append(bools);
+    columns->append(strings);
+    columns->append(rows);
+    DataFrame* df = DataFrame::fromColumns(columns);
+    delete columns;
+    return df;
+}
+
+// compares the given rows of a data frame of randomFrame() by the given
+// columns, like SortBy
+int compareRows(DataFrame* df, size_t row, size_t other, const size_t* cols,
+                const bool* ascending, size_t numCols) {
+    for (size_t i = 0; i < numCols; i++) {
+        int result = 0;
+        switch (cols[i]) {
+            case 0: {
+                int a = df->get_int(0, row);
+                int b = df->get_int(0, other);
+                result = (a > b) - (a < b);
+                break;
+            }
+            case 1: {
+                double a = df->get_double(1, row);
+                double b = df->get_double(1, other);
+                result = (a > b) - (a < b);
+                break;
+            }
+            case 2:
+                result = df->get_bool(2, row) - df->get_bool(2, other);
+                break;
+            default: {
+                String* a = df->get_string(3, row);
+                String* b = df->get_string(3, other);
+                if (a == nullptr || b == nullptr) {
+                    result = (a != nullptr) - (b != nullptr);
+                } else {
+                    result = strcmp(a->c_str(), b->c_str());
+                    result = (result > 0) - (result < 0);
+                }
+                break;
+            }
+        }
+        if (result != 0) {
+            return ascending[i] ? result : -result;
+        }
+    }
+    return 0;
+}
+
+// checks that the given data frame holds every row of randomFrame(), sorted
+// by the given columns, the equal rows in their order
+void checkSorted(DataFrame* sorted, size_t numRows, const size_t* cols,
+                 const bool* ascending, size_t numCols) {
+    assert(sorted->ncols() == 5 && sorted->nrows() == numRows);
+    bool* seen = new bool[numRows]();
+    for (size_t row = 0; row < numRows; row++) {
+        size_t original = sorted->get_int(4, row);
+        assert(!seen[original]);
+        seen[original] = true;
+        if (row > 0) {
+            int result =
+                compareRows(sorted, row - 1, row, cols, ascending, numCols);
+            assert(result < 0 || (result == 0 && sorted->get_int(4, row - 1) <
+                                                     sorted->get_int(4, row)));
+        }
+    }
+    delete[] seen;
+}
+
+void testSortBy() {
+    // sorted by one thread, then by several
+    size_t sizes[] = {1000, PARALLEL_SORT_ROWS * 3 + 5};
+    for (size_t numRows : sizes) {
+        DataFrame* df = randomFrame(numRows);
+        for (size_t col = 0; col < 4; col++) {
+            for (int direction = 0; direction < 2; direction++) {
+                bool ascending[] = {direction == 0};
+                SortBy sort(df, &col, ascending, 1);
+                sort.numThreads = 3;
+                DataFrame* sorted = sort.run();
+                checkSorted(sorted, numRows, &col, ascending, 1);
+                delete sorted;
+            }
+        }
+        size_t cols[] = {2, 3, 1};
+        bool ascending[] = {true, false, true};
+        DataFrame* sorted = df->sort_by(cols, ascending, 3);
+        checkSorted(sorted, numRows, cols, ascending, 3);
+        // the columns are gathered whole
+        size_t first = sorted->get_int(4, 0);
+        assert(sorted->get_int(0, 0) == df->get_int(0, first));
+        assert(sorted->get_double(1, 0) == df->get_double(1, first));
+        delete sorted;
+        delete df;
+    }
+
+    // no rows
+    DataFrame* empty = randomFrame(0);
+    size_t cols[] = {3, 0};
+    bool ascending[] = {true, true};
+    DataFrame* sorted = empty->sort_by(cols, ascending, 2);
+    assert(sorted->ncols() == 5 && sorted->nrows() == 0);
+    delete sorted;
+    delete empty;
+    OK("sort by");
+}
+
+void testTopK() {
+    DataFrame* df = randomFrame(5000);
+    // the first rows sorted by value, greatest first, are the top rows
+    size_t cols[] = {0, 1, 2};
+    size_t ks[] = {0, 1, 100, 6000};
+    for (size_t col : cols) {
+        bool ascending[] = {false};
+        DataFrame* sorted = df->sort_by(&col, ascending, 1);
+        for (size_t k : ks) {
+            DataFrame* top = df->top_k(col, k);
+            size_t numRows = k < df->nrows() ? k : df->nrows();
+            assert(top->ncols() == 5 && top->nrows() == numRows);
+            for (size_t row = 0; row < numRows; row++) {
+                assert(top->get_int(4, row) == sorted->get_int(4, row));
+                assert(top->get_double(1, row) == sorted->get_double(1, row));
+            }
+            delete top;
+        }
+        delete sorted;
+    }
+
+    // NaNs are left out, not kept at the root of the heap
+    ColumnArray* columns = new ColumnArray();
+    DoubleColumn* column = new DoubleColumn();
+    double values[] = {5, 0.0 / 0.0, 1, 7, 9, 8};
+    for (double value : values) {
+        column->push_back(value);
+    }
+    columns->append(column);
+    DataFrame* withNaN = DataFrame::fromColumns(columns);
+    delete columns;
+    DataFrame* top = withNaN->top_k(0, 3);
+    assert(top->nrows() == 3);
+    assert(top->get_double(0, 0) == 9 && top->get_double(0, 1) == 8 &&
+           top->get_double(0, 2) == 7);
+    delete top;
+    top = withNaN->top_k(0, 6);
+    assert(top->nrows() == 5 && top->get_double(0, 4) == 1);
+    delete top;
+    delete withNaN;
+    delete df;
+    OK("top k");
+}
+
+// a data frame of an int column of the rows from first to last of a random
+// permutation of 0 to the given number of rows - 1
+DataFrame* shuffledFrame(size_t numRows, size_t first, size_t last) {
+    int* values = new int[numRows];
+    for (size_t i = 0; i < numRows; i++) {
+        values[i] = static_cast<int>(i);
+    }
+    unsigned int seed = 3;
+    for (size_t i = numRows - 1; i > 0; i--) {
+        size_t other = rand_r(&seed) % (i + 1);
+        int value = values[i];
+        values[i] = values[other];
+        values[other] = value;
+    }
+    ColumnArray* columns = new ColumnArray();
+    IntColumn* column = new IntColumn();
+    for (size_t i = first; i < last; i++) {
+        column->push_back(values[i]);
+    }
+    columns->append(column);
+    DataFrame* df = DataFrame::fromColumns(columns);
+    delete columns;
+    delete[] values;
+    return df;
+}
+
+// checks that the quantiles of a sketch of 0 to the given number of values
+// - 1 are close to their exact values
+void checkQuantiles(QuantileSketch* sketch, size_t numValues) {
+    assert(sketch->size() == numValues);
+    assert(sketch->quantile(0) == 0);
+    assert(sketch->quantile(1) == numValues - 1);
+    double qs[] = {0.01, 0.25, 0.5, 0.9, 0.99};
+    for (double q : qs) {
+        double error = sketch->quantile(q) - q * numValues;
+        assert(error < 0.02 * numValues && error > -0.02 * numValues);
+    }
+}
+
+void testQuantileSketch() {
+    size_t numRows = 200000;
+    DataFrame* df = shuffledFrame(numRows, 0, numRows);
+    QuantileSketch* sketch = df->quantile_sketch(0);
+    checkQuantiles(sketch, numRows);
+    // far fewer values than rows are kept
+    assert(sketch->retained <= sketch->capacity &&
+           sketch->capacity < 4 * DEFAULT_SKETCH_K);
+
+    // a serialized sketch is the same sketch
+    byte* bytes = sketch->serialize();
+    QuantileSketch* copy = QuantileSketch::deserialize(bytes);
+    assert(copy->size() == numRows && copy->numLevels == sketch->numLevels);
+    double qs[] = {0.1, 0.5, 0.99};
+    for (double q : qs) {
+        assert(copy->quantile(q) == sketch->quantile(q));
+    }
+    delete[] bytes;
+    delete copy;
+    delete sketch;
+    delete df;
+
+    // the sketches of the parts of a data frame, one sent serialized as
+    // between nodes, merge into the sketch of the whole
+    DataFrame* first = shuffledFrame(numRows, 0, numRows / 3);
+    DataFrame* second = shuffledFrame(numRows, numRows / 3, numRows);
+    sketch = first->quantile_sketch(0);
+    QuantileSketch* other = second->quantile_sketch(0);
+    bytes = other->serialize();
+    delete other;
+    other = QuantileSketch::deserialize(bytes);
+    sketch->merge(other);
+    checkQuantiles(sketch, numRows);
+    delete[] bytes;
+    delete other;
+    delete sketch;
+    delete first;
+    delete second;
+
+    // nothing summarized
+    sketch = new QuantileSketch();
+    assert(sketch->size() == 0 && sketch->quantile(0.5) == 0);
+    delete sketch;
+    OK("quantile sketch");
+}
+
+// checks that the given data frames hold the same values
+void checkSameFrames(DataFrame* df, DataFrame* other) {
+    assert(df->ncols() == other->ncols() && df->nrows() == other->nrows());
+    for (size_t col = 0; col < df->ncols(); col++) {
+        ColType type = df->columns->get(col)->get_type();
+        assert(type == other->columns->get(col)->get_type());
+        for (size_t row = 0; row < df->nrows(); row++) {
+            switch (type) {
+                case ColType::INTEGER:
+                    assert(df->get_int(col, row) == other->get_int(col, row));
+                    break;
+                case ColType::DOUBLE:
+                    assert(df->get_double(col, row) ==
+                           other->get_double(col, row));
+                    break;
+                case ColType::BOOLEAN:
+                    assert(df->get_bool(col, row) ==
+                           other->get_bool(col, row));
+                    break;
+                default: {
+                    String* value = df->get_string(col, row);
+                    String* otherValue = other->get_string(col, row);
+                    assert(value == nullptr ? otherValue == nullptr
+                                            : value->equals(otherValue));
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void testQuery() {
+    size_t numRows = MORSEL_ROWS * 5 + 7;
+    DataFrame* df = randomFrame(numRows);
+    // the rows with a positive int and the string "ab", and the rows with a
+    // missing string
+    size_t* rows = new size_t[numRows];
+    size_t numKept = 0;
+    size_t* missing = new size_t[numRows];
+    size_t numMissing = 0;
+    for (size_t row = 0; row < numRows; row++) {
+        String* value = df->get_string(3, row);
+        if (df->get_int(0, row) > 0 && value != nullptr &&
+            strcmp(value->c_str(), "ab") == 0) {
+            rows[numKept++] = row;
+        }
+        if (value == nullptr) {
+            missing[numMissing++] = row;
+        }
+    }
+
+    // filters then a projection, run by several threads
+    Query* query = df->query();
+    query->numThreads = 3;
+    size_t cols[] = {4, 1, 3};
+    query->filter(new Condition(0, CompareOp::GREATER, 0))
+        ->filter(new Condition(3, CompareOp::EQUAL, "ab"))
+        ->project(cols, 3);
+    DataFrame* result = query->run();
+    DataFrame* kept = df->gather(rows, numKept);
+    DataFrame* expected = kept->query()->project(cols, 3)->run();
+    checkSameFrames(result, expected);
+    delete result;
+    delete expected;
+    delete query;
+
+    // a filter of a projected column, an int compared with a double
+    size_t projected[] = {3, 0};
+    size_t first[] = {1};
+    query = df->query();
+    query->project(projected, 2)
+        ->filter(new Condition(0, CompareOp::IS_MISSING))
+        ->project(first, 1)
+        ->filter(new Condition(0, CompareOp::LESS_EQUAL, 0.5));
+    result = query->run();
+    size_t numLess = 0;
+    for (size_t i = 0; i < numMissing; i++) {
+        if (df->get_int(0, missing[i]) <= 0) {
+            assert(result->get_int(0, numLess++) == df->get_int(0, missing[i]));
+        }
+    }
+    assert(result->ncols() == 1 && result->nrows() == numLess);
+    delete result;
+    delete query;
+
+    // filters then an aggregation, as GroupBy does for the rows kept
+    size_t keys[] = {2};
+    AggOp ops[] = {AggOp::COUNT, AggOp::SUM, AggOp::MAX, AggOp::MEAN};
+    size_t aggCols[] = {0, 0, 1, 1};
+    query = df->query();
+    query->numThreads = 3;
+    query->filter(new Condition(0, CompareOp::GREATER, 0))
+        ->filter(new Condition(3, CompareOp::EQUAL, "ab"))
+        ->aggregate(keys, 1, ops, aggCols, 4);
+    result = query->run();
+    GroupBy* groupBy = kept->group_by(keys, 1);
+    expected = groupBy->agg(ops, aggCols, 4);
+    checkSameFrames(result, expected);
+    delete result;
+    delete expected;
+    delete groupBy;
+    delete query;
+
+    // an aggregation of every row kept, and of none
+    query = df->query();
+    query->filter(new Condition(2, CompareOp::EQUAL, true))
+        ->aggregate(nullptr, 0, ops, aggCols, 1);
+    result = query->run();
+    int count = 0;
+    for (size_t row = 0; row < numRows; row++) {
+        count += df->get_bool(2, row);
+    }
+    assert(result->ncols() == 1 && result->nrows() == 1);
+    assert(result->get_int(0, 0) == count);
+    delete result;
+    delete query;
+    query = df->query();
+    query->filter(new Condition(1, CompareOp::GREATER, 1000.0))
+        ->aggregate(nullptr, 0, ops, aggCols, 1);
+    result = query->run();
+    assert(result->ncols() == 1 && result->nrows() == 0);
+    delete result;
+    delete query;
+
+    delete kept;
+    delete[] rows;
+    delete[] missing;
+    delete df;
+    OK("query");
+}
+
+void testExpr() {
+    size_t numRows = EXPR_BATCH * 3 + 5;
+    DataFrame* df = randomFrame(numRows);
+
+    // a double times an int, as price * qty
+    Expr* product = Expr::binary(ExprOp::MULTIPLY, Expr::col(1), Expr::col(4));
+    Column* column = product->evaluate(df);
+    assert(column->get_type() == ColType::DOUBLE && column->size() == numRows);
+    for (size_t row = 0; row < numRows; row++) {
+        assert(column->get_double(row) ==
+               df->get_double(1, row) * df->get_int(4, row));
+    }
+    delete column;
+    delete product;
+
+    // ints and a bool, divided by zero, and casts
+    Expr* quotient = Expr::binary(
+        ExprOp::SUBTRACT,
+        Expr::binary(ExprOp::DIVIDE, Expr::col(4), Expr::literal(7)),
+        Expr::col(2));
+    Expr* zero = Expr::binary(ExprOp::DIVIDE, Expr::col(0), Expr::literal(0));
+    Expr* truncated = Expr::cast(Expr::col(1), ColType::INTEGER);
+    Expr* nonZero = Expr::cast(Expr::col(0), ColType::BOOLEAN);
+    df->add_computed(quotient);
+    df->add_computed(zero);
+    df->add_computed(truncated);
+    df->add_computed(nonZero);
+    assert(df->ncols() == 9);
+    for (size_t row = 0; row < numRows; row++) {
+        int value = df->get_int(4, row);
+        assert(df->get_int(5, row) == value / 7 - df->get_bool(2, row));
+        assert(df->get_int(6, row) == 0);
+        assert(df->get_int(7, row) ==
+               static_cast<int>(df->get_double(1, row)));
+        assert(df->get_bool(8, row) == (df->get_int(0, row) != 0));
+    }
+    delete quotient;
+    delete zero;
+    delete truncated;
+    delete nonZero;
+
+    // ints wrap around, and doubles cast to ints are clamped, NaN to 0
+    ColumnArray* columns = new ColumnArray();
+    IntColumn* ints = new IntColumn();
+    DoubleColumn* doubles = new DoubleColumn();
+    int intValues[] = {INT_MAX, INT_MIN, 65536, -7};
+    double doubleValues[] = {0.0 / 0.0, 1e10, -1e10, -2.5};
+    for (size_t row = 0; row < 4; row++) {
+        ints->push_back(intValues[row]);
+        doubles->push_back(doubleValues[row]);
+    }
+    columns->append(ints);
+    columns->append(doubles);
+    DataFrame* edges = DataFrame::fromColumns(columns);
+    delete columns;
+    Expr* exprs[] = {
+        Expr::binary(ExprOp::ADD, Expr::col(0), Expr::literal(1)),
+        Expr::binary(ExprOp::SUBTRACT, Expr::col(0), Expr::literal(1)),
+        Expr::binary(ExprOp::MULTIPLY, Expr::col(0), Expr::col(0)),
+        Expr::cast(Expr::col(1), ColType::INTEGER)};
+    int expectedValues[][4] = {{INT_MIN, INT_MIN + 1, 65537, -6},
+                               {INT_MAX - 1, INT_MAX, 65535, -8},
+                               {1, 0, 0, 49},
+                               {0, INT_MAX, INT_MIN, -2}};
+    for (size_t i = 0; i < 4; i++) {
+        Column* values = exprs[i]->evaluate(edges);
+        for (size_t row = 0; row < 4; row++) {
+            assert(values->get_int(row) == expectedValues[i][row]);
+        }
+        delete values;
+        delete exprs[i];
+    }
+    delete edges;
+
+    // comparisons and boolean operations, as a filter: a > 5 && c or
+    // !(b <= 0.5)
+    Expr* predicate = Expr::binary(
+        ExprOp::OR,
+        Expr::binary(ExprOp::AND,
+                     Expr::binary(ExprOp::GREATER, Expr::col(0),
+                                  Expr::literal(5)),
+                     Expr::col(2)),
+        Expr::negate(Expr::binary(ExprOp::LESS_EQUAL, Expr::col(1),
+                                  Expr::literal(0.5))));
+    size_t* rows = new size_t[numRows];
+    size_t numKept = 0;
+    for (size_t row = 0; row < numRows; row++) {
+        if ((df->get_int(0, row) > 5 && df->get_bool(2, row)) ||
+            !(df->get_double(1, row) <= 0.5)) {
+            rows[numKept++] = row;
+        }
+    }
+    DataFrame* filtered = df->filter(predicate);
+    DataFrame* expected = df->gather(rows, numKept);
+    checkSameFrames(filtered, expected);
+    delete expected;
+
+    // the same filter in a query, after a projection, by several threads
+    size_t cols[] = {4, 2, 1, 0};
+    size_t keys[] = {1};
+    AggOp ops[] = {AggOp::COUNT, AggOp::SUM};
+    size_t aggCols[] = {0, 0};
+    Query* query = df->query();
+    query->numThreads = 3;
+    Expr* projected = dynamic_cast<Expr*>(predicate->clone());
+    size_t positions[] = {3, 2, 1, 0};  // of the columns in the projection
+    projected->remap(positions);
+    query->project(cols, 4)->filter(projected)->aggregate(keys, 1, ops,
+                                                          aggCols, 2);
+    DataFrame* result = query->run();
+    GroupBy* groupBy = filtered->group_by(&cols[1], 1);
+    size_t rowCols[] = {4, 4};
+    expected = groupBy->agg(ops, rowCols, 2);
+    checkSameFrames(result, expected);
+    delete result;
+    delete expected;
+    delete groupBy;
+    delete query;
+    delete filtered;
+    delete predicate;
+    delete[] rows;
+    delete df;
+    OK("expr");
+}
+
+void testTypedViews() {
+    size_t numRows = 10007;
+    DataFrame* df = randomFrame(numRows);
+    TypedColumnView<int> ints = df->view<int>(0);
+    TypedColumnView<double> doubles = df->view<double>(1);
+    TypedColumnView<bool> bools = df->view<bool>(2);
+    assert(ints.size() == numRows && doubles.size() == numRows);
+    long long intSum = 0;
+    double expected = 0;
+    for (size_t row = 0; row < numRows; row++) {
+        assert(ints[row] == df->get_int(0, row));
+        assert(doubles[row] == df->get_double(1, row));
+        assert(bools[row] == df->get_bool(2, row));
+        intSum += df->get_int(0, row);
+        if (df->get_bool(2, row)) {
+            expected += df->get_double(1, row) * df->get_int(4, row);
+        }
+    }
+
+    // the values in order
+    long long sum = 0;
+    for (int value : ints) {
+        sum += value;
+    }
+    assert(sum == intSum);
+    size_t positive = 0;
+    df->map_rows([&positive, ints](size_t row) { positive += ints[row] > 0; });
+    size_t expectedPositive = 0;
+    for (size_t row = 0; row < numRows; row++) {
+        expectedPositive += df->get_int(0, row) > 0;
+    }
+    assert(positive == expectedPositive);
+
+    // a sum per thread, merged
+    size_t numThreads = 3;
+    double sums[3];
+    TypedColumnView<int> rows = df->view<int>(4);
+    df->pmap_ranges(numThreads, [&sums, doubles, bools, rows](
+                                    size_t thread, size_t begin, size_t end) {
+        double total = 0;
+        for (size_t row = begin; row < end; row++) {
+            total += bools[row] ? doubles[row] * rows[row] : 0;
+        }
+        sums[thread] = total;
+    });
+    double total = sums[0] + sums[1] + sums[2];
+    double error = 1e-6 * numRows;
+    assert(total - expected < error && expected - total < error);
+
+    // no rows
+    DataFrame* empty = randomFrame(0);
+    TypedColumnView<double> none = empty->view<double>(1);
+    assert(none.size() == 0 && none.begin() == none.end());
+    empty->pmap_ranges(2, [](size_t, size_t begin, size_t end) {
+        assert(begin == end);
+    });
+    delete empty;
+    delete df;
+    OK("typed views");
+}
+
+void testZoneMap() {
+    // the zones of a sorted column, brought up to date as rows are pushed
+    IntColumn* ints = new IntColumn();
+    for (int value = 0; value < 2 * ZONE_ROWS + 5; value++) {
+        ints->push_back(value);
+    }
+    ZoneMap* zones = ints->zone_map();
+    assert(zones->numZones == 3 && zones->numRows == 2 * ZONE_ROWS + 5);
+    assert(zones->minimums[1] == ZONE_ROWS);
+    assert(zones->maximums[1] == 2 * ZONE_ROWS - 1);
+    ints->push_back(-1);
+    ints->pop_back();
+    ints->push_back(100000);
+    assert(ints->zone_map() == zones && zones->numRows == ints->size());
+    assert(zones->maximums[2] == 100000 && zones->minimums[2] == 2 * ZONE_ROWS);
+    ints->set_int(5, -7);
+    assert(zones->minimums[0] == -7);
+    Condition below(0, CompareOp::LESS, 0);
+    Condition equal(0, CompareOp::EQUAL, ZONE_ROWS + 3);
+    assert(zones->may_match(&below, 0) && !zones->may_match(&below, 1));
+    assert(!zones->may_match(&equal, 0) && zones->may_match(&equal, 1));
+    assert(!zones->may_match(&equal, 2 * ZONE_ROWS, ints->size()));
+    assert(zones->may_match(&equal, ZONE_ROWS - 1, ZONE_ROWS + 1));
+    byte* bytes = zones->serialize();
+    ZoneMap* copy = ZoneMap::deserialize(bytes);
+    assert(copy->numZones == 3 && copy->numRows == zones->numRows);
+    for (size_t zone = 0; zone < 3; zone++) {
+        assert(copy->minimums[zone] == zones->minimums[zone]);
+        assert(copy->maximums[zone] == zones->maximums[zone]);
+        assert(copy->counts[zone] == zones->counts[zone]);
+    }
+    delete copy;
+    delete[] bytes;
+    delete ints;
+
+    // missing strings and NaNs
+    StringColumn* strings = new StringColumn();
+    strings->push_back(new String("a"));
+    strings->push_nullptr();
+    zones = strings->zone_map();
+    Condition missing(0, CompareOp::IS_MISSING);
+    assert(zones->missing[0] == 1 && zones->may_match(&missing, 0));
+    strings->set_string(1, new String("b"));
+    assert(zones->missing[0] == 0 && !zones->may_match(&missing, 0));
+    delete strings;
+    DoubleColumn* doubles = new DoubleColumn();
+    doubles->push_back(0.0 / 0.0);
+    zones = doubles->zone_map();
+    Condition notEqual(0, CompareOp::NOT_EQUAL, 1.0);
+    Condition greater(0, CompareOp::GREATER, 1.0);
+    assert(zones->may_match(&notEqual, 0) && !zones->may_match(&greater, 0));
+    delete doubles;
+
+    // a filter of the sorted row ids, and of the strings
+    size_t numRows = 5 * ZONE_ROWS + 17;
+    DataFrame* df = randomFrame(numRows);
+    int bound = static_cast<int>(numRows) - 100;
+    DataFrame* kept =
+        df->filter(new Condition(4, CompareOp::GREATER_EQUAL, bound));
+    Expr* expr = Expr::binary(ExprOp::GREATER_EQUAL, Expr::col(4),
+                              Expr::literal(bound));
+    DataFrame* expected = df->filter(expr);
+    assert(kept->nrows() == 100);
+    checkSameFrames(kept, expected);
+    delete expr;
+    delete expected;
+    delete kept;
+    kept = df->filter(new Condition(3, CompareOp::IS_MISSING));
+    for (size_t row = 0; row < kept->nrows(); row++) {
+        assert(kept->get_string(3, row) == nullptr);
+    }
+    delete kept;
+    delete df;
+    OK("zone map");
+}
+
+// checks that the given check, found by an index, keeps the rows a scan
+// keeps by the given copy of it
+void checkIndexed(DataFrame* df, Condition* condition, Condition* copy) {
+    DataFrame* kept = df->filter(condition);
+    Query query(df);
+    DataFrame* expected = query.filter(copy)->run();
+    checkSameFrames(kept, expected);
+    delete expected;
+    delete kept;
+}
+
+void testIndexes() {
+    size_t numRows = PARALLEL_SORT_ROWS * 2 + 11;
+    DataFrame* df = randomFrame(numRows);
+    df->create_index(0, IndexType::HASH);
+    df->create_index(1, IndexType::SORTED);
+    df->create_index(3, IndexType::HASH);
+    assert(df->get_index(2) == nullptr && df->get_index(4) == nullptr);
+    Condition equal(0, CompareOp::EQUAL, 1);
+    Condition range(0, CompareOp::LESS, 1);
+    assert(df->get_index(0)->supports(&equal));
+    assert(!df->get_index(0)->supports(&range));
+    int value = df->get_int(0, 1234);
+    checkIndexed(df, new Condition(0, CompareOp::EQUAL, value),
+                 new Condition(0, CompareOp::EQUAL, value));
+    checkIndexed(df, new Condition(0, CompareOp::EQUAL, value + 0.5),
+                 new Condition(0, CompareOp::EQUAL, value + 0.5));
+    checkIndexed(df, new Condition(0, CompareOp::EQUAL, "abc"),
+                 new Condition(0, CompareOp::EQUAL, "abc"));
+    checkIndexed(df, new Condition(3, CompareOp::EQUAL, "ab"),
+                 new Condition(3, CompareOp::EQUAL, "ab"));
+    checkIndexed(df, new Condition(3, CompareOp::EQUAL, ""),
+                 new Condition(3, CompareOp::EQUAL, ""));
+
+    // built again by three threads, whatever the cores
+    for (size_t col : {0, 3}) {
+        ColumnIndex* index = df->get_index(col);
+        index->numThreads = 3;
+        index->invalidate();
+        index->extend();
+    }
+    checkIndexed(df, new Condition(0, CompareOp::EQUAL, value),
+                 new Condition(0, CompareOp::EQUAL, value));
+    checkIndexed(df, new Condition(3, CompareOp::EQUAL, "bc"),
+                 new Condition(3, CompareOp::EQUAL, "bc"));
+
+    // ranges of doubles, with -0.0 equal to 0.0, and of ints
+    CompareOp ops[] = {CompareOp::EQUAL, CompareOp::LESS,
+                       CompareOp::LESS_EQUAL, CompareOp::GREATER,
+                       CompareOp::GREATER_EQUAL};
+    for (CompareOp op : ops) {
+        checkIndexed(df, new Condition(1, op, 0.0), new Condition(1, op, 0.0));
+        checkIndexed(df, new Condition(1, op, -12.5),
+                     new Condition(1, op, -12.5));
+        checkIndexed(df, new Condition(1, op, 17), new Condition(1, op, 17));
+        checkIndexed(df, new Condition(1, op, 1000.0),
+                     new Condition(1, op, 1000.0));
+        checkIndexed(df, new Condition(1, op, true),
+                     new Condition(1, op, true));
+    }
+    df->create_index(3, IndexType::SORTED);
+    for (CompareOp op : ops) {
+        checkIndexed(df, new Condition(3, op, "b"), new Condition(3, op, "b"));
+        checkIndexed(df, new Condition(3, op, "ab"),
+                     new Condition(3, op, "ab"));
+    }
+
+    // rows added, indexed as they are, and values set, indexed again
+    Row row(*df->schema);
+    row.set(0, value);
+    row.set(1, 1000.5);
+    row.set(2, true);
+    row.set(3, new String("zz"));
+    row.set(4, static_cast<int>(numRows));
+    df->add_row(row);
+    assert(df->get_index(0)->numRows == numRows + 1);
+    checkIndexed(df, new Condition(0, CompareOp::EQUAL, value),
+                 new Condition(0, CompareOp::EQUAL, value));
+    checkIndexed(df, new Condition(1, CompareOp::GREATER, 999.0),
+                 new Condition(1, CompareOp::GREATER, 999.0));
+    checkIndexed(df, new Condition(3, CompareOp::GREATER_EQUAL, "z"),
+                 new Condition(3, CompareOp::GREATER_EQUAL, "z"));
+    // batches of rows of decreasing and repeated values, merged by lookups
+    const char* strings[] = {"zz", "a", "ab", "zzz"};
+    for (size_t i = 0; i < 40; i++) {
+        row.set(1, i % 4 == 0 ? 1000.5 : 1500.0 - i);
+        row.set(3, new String(strings[i % 4]));
+        row.set(4, static_cast<int>(numRows + 1 + i));
+        df->add_row(row);
+        if (i % 10 == 9) {
+            checkIndexed(df, new Condition(1, CompareOp::GREATER, 999.0),
+                         new Condition(1, CompareOp::GREATER, 999.0));
+            checkIndexed(df, new Condition(1, CompareOp::EQUAL, 1000.5),
+                         new Condition(1, CompareOp::EQUAL, 1000.5));
+            checkIndexed(df, new Condition(3, CompareOp::LESS_EQUAL, "ab"),
+                         new Condition(3, CompareOp::LESS_EQUAL, "ab"));
+        }
+    }
+    df->set(1, 7, 2000.0);
+    assert(df->get_index(1)->stale);
+    checkIndexed(df, new Condition(1, CompareOp::GREATER, 999.0),
+                 new Condition(1, CompareOp::GREATER, 999.0));
+
+    // the memory of the indexes
+    size_t bytes = df->index_bytes();
+    assert(bytes >= 3 * numRows * sizeof(size_t));
+    df->drop_index(3);
+    assert(df->get_index(3) == nullptr && df->index_bytes() < bytes);
+    df->drop_index(0);
+    df->drop_index(1);
+    assert(df->index_bytes() == 0);
+    delete df;
+    OK("indexes");
+}
+
+int main() {
+    testGroupBy();
+    testGroupByEdges();
+    testJoin();
+    testJoinKeys();
+    testSortBy();
+    testTopK();
+    testQuantileSketch();
+    testQuery();
+    testExpr();
+    testTypedViews();
+    testZoneMap();
+    testIndexes();
+    return 0;
+}
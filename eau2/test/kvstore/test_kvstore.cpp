@@ -0,0 +1,673 @@
+#include <unistd.h>
+
+#include <cassert>
+#include <cstring>
+#include <iostream>
+
+#include "../../include/eau2/collections/maps/byte_map.h"
+#include "../../include/eau2/dataframe/columns/int_column.h"
+#include "../../include/eau2/dataframe/columns/string_column.h"
+#include "../../include/eau2/kvstore/distributed.h"
+#include "../../include/eau2/kvstore/kvstore.h"
+#include "../../include/eau2/serialization/deserializer.h"
+#include "../../include/eau2/serialization/serializer.h"
+#include "../../include/eau2/sorer/chunk_stream.h"
+
+void FAIL() { exit(1); }
+void OK(const char* m) {
+    const char* filename = "[test_kvstore.cpp]";
+    printf("%s %s: [passed]\n", filename, m);
+}
+
+void testKeyEquality() {
+    char name[] = "main";
+    Key key1("main", 0);
+    Key key2(name, 0);
+    Key key3("main", 1);
+    assert(key1.equals(&key2));
+    assert(key1.hash() == key2.hash());
+    assert(!key1.equals(&key3));
+    OK("key equality");
+}
+
+void testByteMapDistinctKeys() {
+    ByteMap* map = new ByteMap();
+    const size_t num_keys = 500;  // forces several rehashes
+    Key** keys = new Key*[num_keys];
+    char** names = new char*[num_keys];
+    for (size_t i = 0; i < num_keys; i++) {
+        names[i] = new char[16];
+        sprintf(names[i], "key%zu", i);
+        keys[i] = new Key(names[i], i % 4);
+        map->set(keys[i], Serializer::serialize_int(static_cast<int>(i)));
+    }
+    assert(map->length() == num_keys);
+    for (size_t i = 0; i < num_keys; i++) {
+        assert(Deserializer::deserialize_int(map->get(keys[i])) ==
+               static_cast<int>(i));
+    }
+    // removing keys keeps the others reachable
+    for (size_t i = 0; i < num_keys; i += 2) {
+        delete[] map->remove(keys[i]);
+    }
+    assert(map->length() == num_keys / 2);
+    for (size_t i = 0; i < num_keys; i++) {
+        byte* value = map->get(keys[i]);
+        if (i % 2 == 0) {
+            assert(value == nullptr);
+        } else {
+            assert(Deserializer::deserialize_int(value) ==
+                   static_cast<int>(i));
+        }
+    }
+    for (size_t i = 1; i < num_keys; i += 2) {
+        delete[] map->remove(keys[i]);
+    }
+    for (size_t i = 0; i < num_keys; i++) {
+        delete keys[i];
+        delete[] names[i];
+    }
+    delete[] keys;
+    delete[] names;
+    delete map;
+    OK("byte map distinct keys");
+}
+
+void testByteMapVersions() {
+    ByteMap* map = new ByteMap();
+    Key key("versioned", 0);
+    assert(map->version(&key) == 0);
+    assert(map->set(&key, Serializer::serialize_int(10)) == 1);
+    assert(map->set(&key, Serializer::serialize_int(20)) == 2);
+    assert(map->set(&key, Serializer::serialize_int(30)) == 3);
+    assert(map->length() == 1);
+    assert(map->version(&key) == 3);
+    assert(Deserializer::deserialize_int(map->get(&key)) == 30);
+    assert(Deserializer::deserialize_int(map->get_version(&key, 1)) == 10);
+    assert(Deserializer::deserialize_int(map->get_version(&key, 2)) == 20);
+    assert(map->get_version(&key, 4) == nullptr);
+
+    // compare-and-set only succeeds against the latest version
+    byte* rejected = Serializer::serialize_int(99);
+    assert(!map->set_if_version(&key, rejected, 2));
+    delete[] rejected;
+    assert(map->set_if_version(&key, Serializer::serialize_int(40), 3));
+    assert(map->version(&key) == 4);
+    Key fresh("fresh", 0);
+    assert(map->set_if_version(&fresh, Serializer::serialize_int(1), 0));
+    byte* duplicate = Serializer::serialize_int(2);
+    assert(!map->set_if_version(&fresh, duplicate, 0));
+    delete[] duplicate;
+
+    // pruning deletes older versions only
+    assert(map->prune(&key, 3) == 2);
+    assert(map->get_version(&key, 2) == nullptr);
+    assert(Deserializer::deserialize_int(map->get_version(&key, 3)) == 30);
+    assert(map->prune(&key, 3) == 0);
+
+    delete[] map->remove(&key);
+    delete[] map->remove(&fresh);
+    delete map;
+    OK("byte map versions");
+}
+
+/**
+ * Reads one published version over and over while the main thread keeps
+ * publishing newer versions of the same key.
+ */
+class VersionReader : public Thread {
+   public:
+    KVStore* kv;
+    Key* key;
+    size_t version;
+    int expected;
+    bool consistent = true;
+
+    VersionReader(KVStore* kv, Key* key, size_t version, int expected) {
+        this->kv = kv;
+        this->key = key;
+        this->version = version;
+        this->expected = expected;
+    }
+
+    void run() {
+        for (size_t i = 0; i < 200; i++) {
+            DataFrame* df = this->kv->get(*this->key, this->version);
+            if (df == nullptr || df->nrows() != 1000) {
+                this->consistent = false;
+            } else {
+                for (size_t row = 0; row < df->nrows(); row++) {
+                    this->consistent &= df->get_int(0, row) == this->expected;
+                }
+            }
+            delete df;
+        }
+    }
+};
+
+void testKVStoreVersions() {
+    KVStore* kv = new KVStore();
+    Key key("frame", 0);
+    const size_t size = 1000;
+    int* vals = new int[size];
+    for (size_t i = 0; i < size; i++) {
+        vals[i] = 1;
+    }
+    assert(kv->put(&key, Serializer::serialize_int_array(vals, size)) == 1);
+    VersionReader* reader = new VersionReader(kv, &key, 1, 1);
+    reader->start();
+    for (int version = 2; version <= 50; version++) {
+        for (size_t i = 0; i < size; i++) {
+            vals[i] = version;
+        }
+        kv->put(&key, Serializer::serialize_int_array(vals, size));
+    }
+    reader->join();
+    assert(reader->consistent);
+    assert(kv->version(key) == 50);
+    DataFrame* latest = kv->get(key);
+    assert(latest->get_int(0, size - 1) == 50);
+    byte* stale = Serializer::serialize_int(0);
+    assert(!kv->put_if_version(&key, stale, 49));
+    delete[] stale;
+    assert(kv->prune(key, 50) == 49);
+    assert(kv->get(key, 1) == nullptr);
+    delete latest;
+    delete reader;
+    delete[] vals;
+    OK("kvstore versions");
+}
+
+void testDurability() {
+    char path[] = "/tmp/eau2_test_kvstoreXXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+    unlink(path);
+    char logPath[64];
+    char snapshotPath[64];
+    sprintf(logPath, "%s.wal", path);
+    sprintf(snapshotPath, "%s.snap", path);
+
+    // snapshot after every 10 puts; the second snapshot holds only the first
+    // key and the 5 puts of the second key stay in the log
+    KVStore* kv = new KVStore();
+    assert(kv->enable_durability(path, 10, 64) == 0);
+    Key first("first", 0);
+    Key second("second", 2);
+    for (int i = 1; i <= 20; i++) {
+        kv->put(&first, Serializer::serialize_int(i));
+    }
+    for (int i = 1; i <= 5; i++) {
+        kv->put(&second, Serializer::serialize_double(i * 0.5));
+    }
+    assert(kv->wal->length() == 5);
+    kv->sync();
+    delete kv;
+
+    // a torn record at the end of the log is ignored
+    FILE* log = fopen(logPath, "ab");
+    size_t garbage[3] = {4096, 7, 7};
+    fwrite(garbage, sizeof(size_t), 3, log);
+    fclose(log);
+
+    KVStore* recovered = new KVStore();
+    assert(recovered->enable_durability(path, 10, 64) == 1 + 5);
+    assert(recovered->version(first) == 20);
+    assert(recovered->version(second) == 5);
+    DataFrame* df = recovered->get(first);
+    assert(df->get_int(0, 0) == 20);
+    delete df;
+    df = recovered->get(second);
+    assert(df->get_double(0, 0) == 2.5);
+    delete df;
+
+    // recovery is idempotent when the snapshot already has the log records
+    assert(recovered->snapshot());
+    delete recovered;
+    recovered = new KVStore();
+    assert(recovered->enable_durability(path, 0, 64) == 2);
+    assert(recovered->version(second) == 5);
+    delete recovered;
+
+    unlink(logPath);
+    unlink(snapshotPath);
+
+    // a log set aside by a snapshot that did not complete is replayed and
+    // compacted into a new snapshot
+    char rotatedPath[72];
+    snprintf(rotatedPath, sizeof(rotatedPath), "%s.old", logPath);
+    kv = new KVStore();
+    kv->enable_durability(path, 0, 64);
+    kv->put(&first, Serializer::serialize_int(7));
+    delete kv;
+    assert(rename(logPath, rotatedPath) == 0);
+    recovered = new KVStore();
+    assert(recovered->enable_durability(path, 0, 64) == 1);
+    assert(access(rotatedPath, F_OK) != 0);
+    delete recovered;
+    recovered = new KVStore();
+    assert(recovered->enable_durability(path, 0, 64) == 1);
+    df = recovered->get(first);
+    assert(df->get_int(0, 0) == 7);
+    delete df;
+    delete recovered;
+    unlink(logPath);
+    unlink(snapshotPath);
+
+    // a log that cannot be written reports it instead of looping
+    WriteAheadLog* full = new WriteAheadLog("/dev/full", 1 << 20);
+    byte* value = Serializer::serialize_int(1);
+    full->append(&first, value, 1);
+    assert(!full->commit());
+    assert(full->commit());
+    delete[] value;
+    delete full;
+    OK("kvstore durability");
+}
+
+/**
+ * Puts versions of its own key, pruning the older ones now and then, while
+ * other threads do the same.
+ */
+class VersionWriter : public Thread {
+   public:
+    KVStore* kv;
+    Key* key;
+    int numVersions;
+
+    VersionWriter(KVStore* kv, Key* key, int numVersions) {
+        this->kv = kv;
+        this->key = key;
+        this->numVersions = numVersions;
+    }
+
+    void run() {
+        const size_t size = 1000;
+        int* vals = new int[size];
+        for (int version = 1; version <= this->numVersions; version++) {
+            for (size_t i = 0; i < size; i++) {
+                vals[i] = version;
+            }
+            this->kv->put(this->key,
+                          Serializer::serialize_int_array(vals, size));
+            if (version % 10 == 0) {
+                this->kv->prune(*this->key, version);
+            }
+        }
+        delete[] vals;
+    }
+};
+
+void testConcurrentPuts() {
+    char path[] = "/tmp/eau2_test_kvstoreXXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+    unlink(path);
+    char logPath[64];
+    char snapshotPath[64];
+    sprintf(logPath, "%s.wal", path);
+    sprintf(snapshotPath, "%s.snap", path);
+
+    // puts log, spill and snapshot outside of the lock of the map while a
+    // reader decodes a value being spilled
+    KVStore* kv = new KVStore();
+    kv->enable_durability(path, 25, 4096);
+    kv->set_memory_budget(20000, "/tmp");
+    const size_t size = 1000;
+    int* vals = new int[size];
+    for (size_t i = 0; i < size; i++) {
+        vals[i] = 1;
+    }
+    Key fixed("fixed", 0);
+    kv->put(&fixed, Serializer::serialize_int_array(vals, size));
+    VersionReader* reader = new VersionReader(kv, &fixed, 1, 1);
+    const int numWriters = 3;
+    const int numVersions = 100;
+    Key* keys[numWriters] = {new Key("w0", 0), new Key("w1", 1),
+                             new Key("w2", 2)};
+    VersionWriter* writers[numWriters];
+    reader->start();
+    for (int i = 0; i < numWriters; i++) {
+        writers[i] = new VersionWriter(kv, keys[i], numVersions);
+        writers[i]->start();
+    }
+    for (int i = 0; i < numWriters; i++) {
+        writers[i]->join();
+        delete writers[i];
+    }
+    reader->join();
+    assert(reader->consistent);
+    delete reader;
+    // a put over the budget skips spilling while another put spills
+    kv->enforce_budget();
+    assert(kv->resident_bytes() <= 20000);
+    assert(kv->sync());
+    delete kv;
+
+    // every put is recovered from the snapshot and the log
+    KVStore* recovered = new KVStore();
+    recovered->enable_durability(path, 0, 4096);
+    for (int i = 0; i < numWriters; i++) {
+        assert(recovered->version(*keys[i]) == numVersions);
+        DataFrame* df = recovered->get(*keys[i]);
+        assert(df->get_int(0, size - 1) == numVersions);
+        delete df;
+        delete keys[i];
+    }
+    delete recovered;
+    delete[] vals;
+    unlink(logPath);
+    unlink(snapshotPath);
+    OK("kvstore concurrent puts");
+}
+
+void testSegments() {
+    KVStore* kv = new KVStore();
+    kv->enable_segments("/tmp", 4096);
+    Key small("small", 0);
+    Key large("large", 0);
+    const size_t size = 5000;  // larger than a segment
+    int* vals = new int[size];
+    for (size_t i = 0; i < size; i++) {
+        vals[i] = static_cast<int>(i);
+    }
+    // 50 small values of 100 ints fill several segments
+    for (int i = 1; i <= 50; i++) {
+        vals[0] = i;
+        kv->put(&small, Serializer::serialize_int_array(vals, 100));
+        if (i == 25) {
+            vals[0] = 0;
+            kv->put(&large, Serializer::serialize_int_array(vals, size));
+        }
+    }
+    assert(kv->segments->numSegments > 3);
+
+    // values are views into the segments
+    byte* bytes = kv->get_bytes(large);
+    KeyValueBytes* kvb = kv->map->entry(&large);
+    assert(kvb->in_segment());
+    assert(bytes == kv->segments->view(kvb->segment, kvb->offset));
+    assert(kvb->length == Deserializer::num_bytes(bytes));
+    DataFrame* df = kv->get(large);
+    assert(df->get_int(0, size - 1) == static_cast<int>(size - 1));
+    delete df;
+    // the segment of the large value does not interrupt the small ones
+    for (int i = 1; i <= 50; i++) {
+        df = kv->get(small, i);
+        assert(df->get_int(0, 0) == i);
+        delete df;
+    }
+    byte* stale = Serializer::serialize_int(0);
+    assert(!kv->put_if_version(&small, stale, 1));
+    delete[] stale;
+    assert(kv->put_if_version(&small, Serializer::serialize_int(51), 50));
+    assert(kv->prune(small, 51) == 50);
+    df = kv->get(small);
+    assert(df->get_int(0, 0) == 51);
+    delete df;
+    delete kv;
+    delete[] vals;
+    OK("kvstore segments");
+}
+
+void testMemoryBudget() {
+    KVStore* kv = new KVStore();
+    const size_t budget = 20000;
+    kv->set_memory_budget(budget, "/tmp");
+    const size_t num_keys = 100;
+    const size_t size = 1000;  // about 4KB per value
+    int* vals = new int[size];
+    Key** keys = new Key*[num_keys];
+    char** names = new char*[num_keys];
+    for (size_t i = 0; i < num_keys; i++) {
+        names[i] = new char[16];
+        sprintf(names[i], "chunk%zu", i);
+        keys[i] = new Key(names[i], 0);
+        for (size_t j = 0; j < size; j++) {
+            vals[j] = static_cast<int>(i * j);
+        }
+        kv->put(keys[i], Serializer::serialize_int_array(vals, size));
+        assert(kv->resident_bytes() <= budget);
+        // the first key is read between puts and stays hot
+        DataFrame* df = kv->get(*keys[0]);
+        assert(df->get_int(0, 1) == 0);
+        delete df;
+    }
+    assert(!kv->map->entry(keys[0])->in_segment());
+    assert(kv->map->entry(keys[1])->in_segment());
+    // spilled values are read back from the segments
+    for (size_t i = 0; i < num_keys; i++) {
+        DataFrame* df = kv->get(*keys[i]);
+        assert(df->get_int(0, size - 1) == static_cast<int>(i * (size - 1)));
+        delete df;
+    }
+    // a lower budget spills right away
+    kv->set_memory_budget(1, "/tmp");
+    assert(kv->resident_bytes() == 0);
+    delete kv;
+    for (size_t i = 0; i < num_keys; i++) {
+        delete keys[i];
+        delete[] names[i];
+    }
+    delete[] keys;
+    delete[] names;
+    delete[] vals;
+    OK("kvstore memory budget");
+}
+
+// streams a data frame of the given number of rows of an int key below the
+// given one, an int value and a string, the name of the key, missing for
+// key 0, into the given KVStore in chunks of the given number of rows
+void streamFrame(KVStore* kv, const char* name, size_t numRows, int numKeys,
+                 size_t chunkRows) {
+    ColTypeArray* types = new ColTypeArray();
+    types->append(ColType::INTEGER);
+    types->append(ColType::INTEGER);
+    types->append(ColType::STRING);
+    ChunkStream* stream = new ChunkStream(kv, name, types, chunkRows, 2);
+    stream->start();
+    char label[16];
+    for (size_t begin = 0; begin < numRows; begin += chunkRows) {
+        IntColumn* keys = new IntColumn();
+        IntColumn* values = new IntColumn();
+        StringColumn* labels = new StringColumn();
+        for (size_t row = begin; row < numRows && row < begin + chunkRows;
+             row++) {
+            int key = static_cast<int>(row * 7 % numKeys);
+            keys->push_back(key);
+            values->push_back(static_cast<int>(row));
+            if (key == 0) {
+                labels->push_nullptr();
+            } else {
+                snprintf(label, sizeof(label), "key%d", key);
+                labels->push_back(new String(label));
+            }
+        }
+        ColumnArray* chunk = new ColumnArray();
+        chunk->append(keys);
+        chunk->append(values);
+        chunk->append(labels);
+        stream->push(chunk);
+    }
+    stream->finish();
+    delete stream;
+    delete types;
+}
+
+void testDistributedGroupBy() {
+    KVStore* kv = new KVStore();
+    // the pieces of the shuffle go over the budget and are spilled
+    kv->set_memory_budget(16000, "/tmp");
+    size_t numRows = 2000;
+    streamFrame(kv, "sales", numRows, 53, 128);
+    DataFrame* df = ChunkStream::load(kv, "sales");
+    size_t keys[] = {0, 2};
+    AggOp ops[] = {AggOp::COUNT, AggOp::SUM, AggOp::MAX};
+    size_t cols[] = {2, 1, 1};
+    // more partitions than nodes for a small budget of a node
+    assert(Distributed::num_partitions(1000, 4, 0) == 4);
+    assert(Distributed::num_partitions(1000, 4, 250) == 4);
+    assert(Distributed::num_partitions(1001, 4, 250) == 8);
+    assert(Distributed::group_by(kv, "sales", keys, 2, ops, cols, 3,
+                                 "totals", 4096));
+    assert(kv->resident_bytes() <= 16000);
+    DataFrame* totals = ChunkStream::load(kv, "totals");
+    GroupBy* groupBy = df->group_by(keys, 2);
+    DataFrame* expected = groupBy->agg(ops, cols, 3);
+    assert(totals->ncols() == 5 && totals->nrows() == 53);
+    assert(expected->nrows() == 53);
+    // the groups of the partitions are in another order
+    for (size_t group = 0; group < expected->nrows(); group++) {
+        size_t row = 0;
+        while (totals->get_int(0, row) != expected->get_int(0, group)) {
+            row++;
+        }
+        String* label = totals->get_string(1, row);
+        assert(label == nullptr
+                   ? totals->get_int(0, row) == 0
+                   : label->equals(expected->get_string(1, group)));
+        assert(totals->get_int(2, row) == expected->get_int(2, group));
+        assert(totals->get_double(3, row) == expected->get_double(3, group));
+        assert(totals->get_int(4, row) == expected->get_int(4, group));
+    }
+    assert(!Distributed::group_by(kv, "missing", keys, 2, ops, cols, 3,
+                                  "none", 0));
+    delete expected;
+    delete groupBy;
+    delete totals;
+    delete df;
+    delete kv;
+    OK("distributed group by");
+}
+
+void testDistributedJoin() {
+    KVStore* kv = new KVStore();
+    streamFrame(kv, "orders", 1000, 60, 100);
+    streamFrame(kv, "customers", 50, 50, 16);
+    DataFrame* orders = ChunkStream::load(kv, "orders");
+    DataFrame* customers = ChunkStream::load(kv, "customers");
+    size_t keys[] = {0};
+    JoinType types[] = {JoinType::INNER, JoinType::LEFT};
+    size_t budgets[] = {0, 2048};
+    size_t missing = 0;  // orders of keys without a customer
+    for (size_t row = 0; row < orders->nrows(); row++) {
+        missing += orders->get_int(0, row) >= 50;
+    }
+    for (JoinType type : types) {
+        DataFrame* expected = orders->join(customers, keys, keys, 1, type);
+        for (size_t budget : budgets) {
+            assert(Distributed::join(kv, "orders", "customers", keys, keys, 1,
+                                     type, "joined", budget));
+            DataFrame* joined = ChunkStream::load(kv, "joined");
+            assert(joined->ncols() == 6);
+            assert(joined->nrows() == expected->nrows());
+            size_t unmatched = 0;
+            for (size_t row = 0; row < joined->nrows(); row++) {
+                // an order is joined with the customer of its key, if any
+                int key = joined->get_int(0, row);
+                if (key >= 50) {
+                    assert(type == JoinType::LEFT);
+                    assert(joined->get_int(4, row) == 0);
+                    unmatched++;
+                } else {
+                    assert(joined->get_int(3, row) == key);
+                    assert(joined->get_int(4, row) == key * 43 % 50);
+                }
+            }
+            assert(unmatched == (type == JoinType::LEFT ? missing : 0));
+            delete joined;
+        }
+        delete expected;
+    }
+    assert(!Distributed::join(kv, "orders", "missing", keys, keys, 1,
+                              JoinType::INNER, "none", 0));
+    delete orders;
+    delete customers;
+    delete kv;
+    OK("distributed join");
+}
+
+void testZoneMapLoad() {
+    KVStore* kv = new KVStore();
+    size_t numRows = 2000;
+    streamFrame(kv, "events", numRows, 53, 100);
+    Key* key = ChunkStream::zones_key("events", 1);
+    ZoneMap* zones =
+        kv->get_decoded(Key(key->key, key->nodeId), ZoneMap::deserialize);
+    delete key;
+    assert(kv->get_decoded(Key("events:9:zones", 0), ZoneMap::deserialize) ==
+           nullptr);
+    assert(zones->numZones == 20 && zones->numRows == numRows);
+    assert(zones->minimums[3] == 300 && zones->maximums[3] == 399);
+    delete zones;
+
+    // the values are the row ids, sorted: two chunks are read
+    DataFrame* df = ChunkStream::load(kv, "events");
+    Condition* late = new Condition(1, CompareOp::GREATER_EQUAL, 1850);
+    DataFrame* kept = ChunkStream::load(kv, "events", late);
+    assert(kept->nrows() == 150);
+    for (size_t row = 0; row < kept->nrows(); row++) {
+        assert(kept->get_int(1, row) == static_cast<int>(1850 + row));
+        assert(kept->get_int(0, row) == df->get_int(0, 1850 + row));
+    }
+    delete kept;
+    delete late;
+    Condition* none = new Condition(1, CompareOp::LESS, 0);
+    kept = ChunkStream::load(kv, "events", none);
+    assert(kept->nrows() == 0 && kept->ncols() == 3);
+    delete kept;
+    delete none;
+    Condition* missing = new Condition(2, CompareOp::IS_MISSING);
+    kept = ChunkStream::load(kv, "events", missing);
+    size_t numMissing = 0;
+    for (size_t row = 0; row < numRows; row++) {
+        numMissing += df->get_string(2, row) == nullptr;
+    }
+    assert(kept->nrows() == numMissing);
+    delete kept;
+    delete missing;
+    delete df;
+
+    // counts past 2^32 are kept whole in the metadata
+    size_t numChunks, numCols;
+    ColType types[] = {ColType::STRING, ColType::DOUBLE};
+    Key huge("huge", 0);
+    kv->put(&huge, ChunkStream::serialize_metadata(
+                       (size_t(3) << 33) + 5, DEFAULT_CHUNK_ROWS,
+                       (size_t(1) << 32) + 7, types, 2));
+    ColType* read =
+        ChunkStream::read_metadata(kv, "huge", &numChunks, &numCols);
+    assert(numChunks == (size_t(1) << 32) + 7 && numCols == 2);
+    assert(read[0] == ColType::STRING && read[1] == ColType::DOUBLE);
+    delete[] read;
+    assert(ChunkStream::read_metadata(kv, "none", &numChunks, &numCols) ==
+           nullptr);
+
+    // the bytes of the chunks, read under the lock of the map
+    key = ChunkStream::chunk_key(kv, "events", 1, 0);
+    size_t chunkBytes = kv->value_bytes(Key(key->key, key->nodeId));
+    delete key;
+    assert(chunkBytes > 100 * sizeof(int));
+    assert(Shuffle::frame_bytes(kv, "events") > 20 * chunkBytes);
+    assert(Shuffle::frame_bytes(kv, "none") == 0);
+    assert(kv->value_bytes(Key("none", 0)) == 0);
+    delete kv;
+    OK("zone map load");
+}
+
+int main() {
+    testKeyEquality();
+    testByteMapDistinctKeys();
+    testByteMapVersions();
+    testKVStoreVersions();
+    testDurability();
+    testConcurrentPuts();
+    testSegments();
+    testMemoryBudget();
+    testDistributedGroupBy();
+    testDistributedJoin();
+    testZoneMapLoad();
+    return 0;
+}
@@ -152,11 +152,11 @@ void testSerializeBoolArray(size_t size) {
 void testSerializeStringArray(size_t size) {
     String** array1 = new String*[size];
     String** array2 = new String*[size];
-    char buff[16];
+    char buff[32];
     for (size_t i = 0; i < size; i++) {
-        sprintf(buff, "%zu", i);
+        snprintf(buff, sizeof(buff), "%zu", i);
         array1[i] = new String(buff);
-        sprintf(buff, "%zu", size - i - 1);
+        snprintf(buff, sizeof(buff), "%zu", size - i - 1);
         array2[i] = new String(buff);
     }
     byte* serialized1 = Serializer::serialize_string_array(array1, size);
@@ -184,17 +184,80 @@ void testSerializeStringArray(size_t size) {
     OK("serialize/deserialize string array");
 }
 
+void testDeserializePackedStringArray(size_t size) {
+    String** array = new String*[size];
+    char buff[32];
+    for (size_t i = 0; i < size; i++) {
+        snprintf(buff, sizeof(buff), "%zu", i * 7);
+        array[i] = new String(buff);
+    }
+    // empty strings are kept as empty, zero terminated entries
+    String* empty = new String("");
+    delete array[size / 2];
+    array[size / 2] = empty;
+    byte* serialized = Serializer::serialize_string_array(array, size);
+    PackedStringArray* packed =
+        Deserializer::deserialize_packed_string_array(serialized);
+    assert(packed->size() == size);
+    for (size_t i = 0; i < size; i++) {
+        assert(packed->length(i) == array[i]->size());
+        assert(strcmp(packed->get_cstr(i), array[i]->cstr_) == 0);
+        String* copy = packed->get(i);
+        assert(copy->equals(array[i]));
+        delete copy;
+    }
+    for (size_t i = 0; i < size; i++) {
+        delete array[i];
+    }
+    delete[] array;
+    delete[] serialized;
+    delete packed;
+    OK("deserialize packed string array");
+}
+
+void testSerializeMissingStrings(size_t size) {
+    String** array = new String*[size];
+    char buff[32];
+    for (size_t i = 0; i < size; i++) {
+        snprintf(buff, sizeof(buff), "%zu", i);
+        array[i] = i % 3 == 0 ? nullptr : new String(buff);
+    }
+    byte* serialized = Serializer::serialize_string_array(array, size);
+    String** deserialized = Deserializer::deserialize_string_array(serialized);
+    PackedStringArray* packed =
+        Deserializer::deserialize_packed_string_array(serialized);
+    for (size_t i = 0; i < size; i++) {
+        if (array[i] == nullptr) {
+            // missing strings of a packed array are empty
+            assert(deserialized[i] == nullptr);
+            assert(packed->length(i) == 0);
+        } else {
+            assert(array[i]->equals(deserialized[i]));
+            assert(strcmp(packed->get_cstr(i), array[i]->cstr_) == 0);
+        }
+    }
+    for (size_t i = 0; i < size; i++) {
+        delete array[i];
+        delete deserialized[i];
+    }
+    delete[] array;
+    delete[] deserialized;
+    delete[] serialized;
+    delete packed;
+    OK("serialize/deserialize missing strings");
+}
+
 void testArraySize(size_t size) {
     int* int_array = new int[size];
     double* double_array = new double[size];
     bool* bool_array = new bool[size];
     String** string_array = new String*[size];
-    char buff[16];
+    char buff[32];
     for (size_t i = 0; i < size; i++) {
         int_array[i] = static_cast<int>(i);
         double_array[i] = i;
         bool_array[i] = i % 2;
-        sprintf(buff, "%zu", i);
+        snprintf(buff, sizeof(buff), "%zu", i);
         string_array[i] = new String(buff);
     }
     byte* bytes_int_array = Serializer::serialize_int_array(int_array, size);
@@ -231,12 +294,12 @@ void testNumBytes(size_t size) {
     double* double_array = new double[size];
     bool* bool_array = new bool[size];
     String** string_array = new String*[size];
-    char buff[16];
+    char buff[32];
     for (size_t i = 0; i < size; i++) {
         int_array[i] = static_cast<int>(i);
         double_array[i] = i;
         bool_array[i] = i % 2;
-        sprintf(buff, "%zu", i);
+        snprintf(buff, sizeof(buff), "%zu", i);
         string_array[i] = new String(buff);
     }
     byte* serialized_int = Serializer::serialize_int(int_value);
@@ -270,7 +333,7 @@ void testNumBytes(size_t size) {
                sizeof(bool) * size);
     size_t str_arr_bytes = 0;
     for (size_t i = 0; i < size; i++) {
-        sprintf(buff, "%zu", i);
+        snprintf(buff, sizeof(buff), "%zu", i);
         str_arr_bytes += sizeof(size_t);
         str_arr_bytes += strlen(buff);
     }
@@ -305,12 +368,12 @@ void testGetHeader(size_t size) {
     double* double_array = new double[size];
     bool* bool_array = new bool[size];
     String** string_array = new String*[size];
-    char buff[16];
+    char buff[32];
     for (size_t i = 0; i < size; i++) {
         int_array[i] = static_cast<int>(i);
         double_array[i] = i;
         bool_array[i] = i % 2;
-        sprintf(buff, "%zu", i);
+        snprintf(buff, sizeof(buff), "%zu", i);
         string_array[i] = new String(buff);
     }
     byte* serialized_int = Serializer::serialize_int(int_value);
@@ -364,6 +427,8 @@ int main() {
     testSerializeDoubleArray(array_size);
     testSerializeBoolArray(array_size);
     testSerializeStringArray(array_size);
+    testDeserializePackedStringArray(array_size);
+    testSerializeMissingStrings(array_size);
     testArraySize(array_size);
     testNumBytes(array_size);
     testGetHeader(array_size);
@@ -1,3 +1,6 @@
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <cassert>
 #include <cstring>
 #include <iostream>
@@ -6,6 +9,11 @@
 #include "../../include/eau2/dataframe/columns/double_column.h"
 #include "../../include/eau2/dataframe/columns/int_column.h"
 #include "../../include/eau2/dataframe/columns/string_column.h"
+#include "../../include/eau2/dataframe/rowers/rower.h"
+#include "../../include/eau2/sorer/chunk_stream.h"
+#include "../../include/eau2/sorer/column_cache.h"
+#include "../../include/eau2/sorer/helpers.h"
+#include "../../include/eau2/sorer/predicate.h"
 #include "../../include/eau2/sorer/sorer.h"
 #include "../../include/eau2/utils/helper.h"
 
@@ -169,11 +177,776 @@ void testMixedColumns() {
     OK("test_mixed_col");
 }
 
+// reads the whole file through the mapped reader split into the given number
+// of byte ranges and checks that every row is read exactly once
+void checkMappedRanges(const char* path, size_t numRanges) {
+    FILE* file = fopen(path, "r");
+    fseek(file, 0, SEEK_END);
+    size_t size = ftell(file);
+    fclose(file);
+    SOR* whole = new SOR();
+    assert(whole->read_mapped(path, 0, size));
+    size_t rows = whole->columnArray->get(0)->size();
+    size_t rangeSize = size / numRanges + 1;
+    size_t total = 0;
+    for (size_t from = 0; from < size; from += rangeSize) {
+        SOR* part = new SOR();
+        for (int i = 0; i < whole->columnArray->size(); i++) {
+            part->add_column_(whole->get_col_type(i));
+        }
+        assert(part->read_mapped(path, from, rangeSize));
+        Column* col = part->columnArray->get(0);
+        // the first row of a range follows the last row of the previous
+        for (size_t row = 0; row < col->size(); row++) {
+            char* expected = whole->get_value(0, total + row);
+            char* actual = part->get_value(0, row);
+            assert(strcmp(expected, actual) == 0);
+            delete[] expected;
+            delete[] actual;
+        }
+        total += col->size();
+        delete part;
+    }
+    assert(total == rows);
+    delete whole;
+}
+
+void testMappedReader() {
+    SOR* sor = new SOR();
+    assert(sor->read_mapped(FILE_MIXED_COL, 0, 1 << 20));
+    DataFrame* df = sor->get_dataframe();
+    assert(df->schema->numCols == 4);
+    assert(df->schema->numRows == 100);
+    assert(df->columns->get(0)->colType == ColType::INTEGER);
+    assert(df->columns->get(1)->colType == ColType::DOUBLE);
+    assert(df->columns->get(2)->colType == ColType::BOOLEAN);
+    assert(df->columns->get(3)->colType == ColType::STRING);
+    for (size_t rowIndex = 0; rowIndex < df->schema->numRows; rowIndex++) {
+        assert(df->get_int(0, rowIndex) == static_cast<int>(rowIndex % 10 + 1));
+        assert(df->get_double(1, rowIndex) - (1 + 0.1 * (rowIndex % 10)) <
+               1E-14);
+        assert(df->get_bool(2, rowIndex) ==
+               static_cast<bool>((rowIndex + 1) % 2));
+        String* str = df->get_string(3, rowIndex);
+        assert(str->size() == 1);
+        assert(str->cstr_[0] == static_cast<char>(rowIndex % 10 + 0x61));
+    }
+    delete df;
+    delete sor;
+
+    // from/len select whole lines only
+    for (size_t numRanges = 2; numRanges <= 7; numRanges++) {
+        checkMappedRanges(FILE_MIXED_COL, numRanges);
+    }
+    // an empty range reads no line, wherever it starts
+    for (size_t from = 0; from <= 30; from += 15) {
+        SOR* empty = new SOR();
+        for (int col = 0; col < 4; col++) {
+            empty->add_column_(ColType::INTEGER);
+        }
+        assert(empty->read_mapped(FILE_MIXED_COL, from, 0));
+        assert(empty->columnArray->get(0)->size() == 0);
+        delete empty;
+    }
+    OK("test_mapped_reader");
+}
+
+void testMappedLongLines() {
+    char path[] = "/tmp/eau2_test_sorerXXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    FILE* file = fdopen(fd, "w");
+    const size_t length = 10000;  // over the 4096 byte buffer of read()
+    char* value = new char[length + 1];
+    memset(value, 'x', length);
+    value[length] = '\0';
+    for (int i = 0; i < 3; i++) {
+        fprintf(file, "<%d> <\"%s\"> <>\n", 10 + i, value);
+    }
+    fclose(file);
+
+    SOR* sor = new SOR();
+    assert(sor->read_mapped(path, 0, 3 * (length + 20)));
+    assert(sor->columnArray->size() == 3);
+    Column* strings = sor->columnArray->get(1);
+    assert(strings->size() == 3);
+    for (size_t row = 0; row < 3; row++) {
+        assert(sor->columnArray->get(0)->get_int(row) ==
+               static_cast<int>(10 + row));
+        assert(strings->get_string(row)->size() == length);
+        assert(sor->is_missing(2, row) ||
+               sor->columnArray->get(2)->get_bool(row) == false);
+    }
+    delete sor;
+    delete[] value;
+    unlink(path);
+    OK("test_mapped_long_lines");
+}
+
+// checks that both SORs hold the same values
+void checkSameColumns(SOR* expected, SOR* actual) {
+    assert(expected->columnArray->size() == actual->columnArray->size());
+    for (int col = 0; col < expected->columnArray->size(); col++) {
+        assert(expected->get_col_type(col) == actual->get_col_type(col));
+        size_t rows = expected->columnArray->get(col)->size();
+        assert(actual->columnArray->get(col)->size() == rows);
+        for (size_t row = 0; row < rows; row++) {
+            char* expectedValue = expected->get_value(col, row);
+            char* actualValue = actual->get_value(col, row);
+            assert(strcmp(expectedValue, actualValue) == 0);
+            delete[] expectedValue;
+            delete[] actualValue;
+        }
+    }
+}
+
+void testParallelReader() {
+    SOR* whole = new SOR();
+    assert(whole->read_mapped(FILE_MIXED_COL, 0, 1 << 20));
+    for (size_t numThreads = 1; numThreads <= 8; numThreads++) {
+        SOR* sor = new SOR();
+        assert(sor->read_parallel(FILE_MIXED_COL, 0, 1 << 20, numThreads));
+        checkSameColumns(whole, sor);
+        delete sor;
+    }
+    // a range in the middle of the file is split into the same lines
+    SOR* part = new SOR();
+    SOR* parallel = new SOR();
+    for (int col = 0; col < whole->columnArray->size(); col++) {
+        part->add_column_(whole->get_col_type(col));
+        parallel->add_column_(whole->get_col_type(col));
+    }
+    assert(part->read_mapped(FILE_MIXED_COL, 301, 777));
+    assert(parallel->read_parallel(FILE_MIXED_COL, 301, 777, 5));
+    assert(part->columnArray->get(0)->size() > 0);
+    checkSameColumns(part, parallel);
+    delete part;
+    delete parallel;
+    // more threads than bytes read every line of the range once
+    for (size_t len = 1; len <= 30; len += 29) {
+        part = new SOR();
+        parallel = new SOR();
+        for (int col = 0; col < whole->columnArray->size(); col++) {
+            part->add_column_(whole->get_col_type(col));
+            parallel->add_column_(whole->get_col_type(col));
+        }
+        assert(part->read_mapped(FILE_MIXED_COL, 0, len));
+        assert(parallel->read_parallel(FILE_MIXED_COL, 0, len, 16));
+        checkSameColumns(part, parallel);
+        delete part;
+        delete parallel;
+    }
+    delete whole;
+    OK("test_parallel_reader");
+}
+
+// counts the rows read from the given range of the mixed file by a new SOR
+size_t countRows(const char* data, size_t size, size_t from) {
+    SOR* sor = new SOR();
+    sor->read_bytes(data, size, from, SIZE_MAX);
+    size_t rows = sor->columnArray->get(0)->size();
+    delete sor;
+    return rows;
+}
+
+void testRereadTokenizer() {
+    FILE* file = fopen(FILE_MIXED_COL, "rb");
+    fseek(file, 0, SEEK_END);
+    size_t size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* data = new char[size];
+    assert(fread(data, 1, size, file) == size);
+    fclose(file);
+
+    // the second read starts before the data the tokenizer last scanned
+    size_t tail = countRows(data, size, 200);
+    size_t all = countRows(data, size, 0);
+    assert(tail > 0 && tail < all);
+    SOR* sor = new SOR();
+    sor->read_bytes(data, size, 200, SIZE_MAX);
+    sor->read_bytes(data, size, 0, SIZE_MAX);
+    assert(sor->columnArray->get(0)->size() == tail + all);
+    // and at another offset of a block
+    sor->read_bytes(data, size, 70, SIZE_MAX);
+    assert(sor->columnArray->get(0)->size() ==
+           tail + all + countRows(data, size, 70));
+    delete sor;
+    delete[] data;
+    OK("test_reread_tokenizer");
+}
+
+void testTokenizer() {
+    // structural characters at every offset of several blocks
+    const size_t size = 5 * TOKENIZER_BLOCK + 13;
+    char* data = new char[size];
+    const char alphabet[] = "<>\" \nab1.";
+    unsigned int seed = 7;
+    for (size_t i = 0; i < size; i++) {
+        data[i] = alphabet[rand_r(&seed) % (sizeof(alphabet) - 1)];
+    }
+    for (int level = 0; level <= static_cast<int>(Tokenizer::best_level());
+         level++) {
+        Tokenizer* tokenizer = new Tokenizer(static_cast<ScanLevel>(level));
+        // start past the first byte so blocks are not aligned to the data
+        for (size_t start = 0; start < 3; start++) {
+            tokenizer->reset(data + start, data + size);
+            const char* expected = data + start;
+            const char* position = data + start;
+            while (true) {
+                while (expected < data + size && *expected != '<' &&
+                       *expected != '>' && *expected != '"' &&
+                       *expected != '\n') {
+                    expected++;
+                }
+                position = tokenizer->next(position);
+                assert(position == expected);
+                if (position == data + size) {
+                    break;
+                }
+                position++;
+                expected++;
+            }
+        }
+        delete tokenizer;
+    }
+    delete[] data;
+
+    // the fields of a line do not depend on the scan used
+    const char* line =
+        "<  12> <\"a <b> \"c\"> <> <  > <1.5 > <x\"y> <\"\"> "
+        "<\"0123456789012345678901234567890123456789012345678901234\">\n<7>";
+    const char* end = line + strlen(line);
+    for (int level = 0; level <= static_cast<int>(Tokenizer::best_level());
+         level++) {
+        SOR* sor = new SOR();
+        delete sor->tokenizer;
+        sor->tokenizer = new Tokenizer(static_cast<ScanLevel>(level));
+        size_t numFields;
+        const char* next = sor->tokenize_line_(line, end, &numFields);
+        assert(*next == '<');
+        assert(numFields == 8);
+        assert(sor->lengths[0] == 2 && strncmp(sor->fields[0], "12", 2) == 0);
+        // the string ends at the first closing quote
+        assert(sor->lengths[1] == 6 &&
+               strncmp(sor->fields[1], "a <b> ", 6) == 0);
+        assert(sor->fields[2] == nullptr);
+        assert(sor->fields[3] == nullptr);
+        assert(sor->lengths[4] == 3 && strncmp(sor->fields[4], "1.5", 3) == 0);
+        assert(sor->lengths[5] == 3 && strncmp(sor->fields[5], "x\"y", 3) == 0);
+        assert(sor->fields[6] != nullptr && sor->lengths[6] == 0);
+        assert(sor->lengths[7] == 55);
+        next = sor->tokenize_line_(next, end, &numFields);
+        assert(next == end && numFields == 1 && *sor->fields[0] == '7');
+        delete sor;
+    }
+    OK("test_tokenizer");
+}
+
+void testFieldParsers() {
+    // the fused parsers convert exactly like atoi and strtod
+    unsigned int seed = 11;
+    char value[64];
+    for (int i = 0; i < 100000; i++) {
+        int expectedInt = static_cast<int>(rand_r(&seed)) - RAND_MAX / 2;
+        int length = sprintf(value, "%d", expectedInt >> (i % 31));
+        int parsedInt;
+        assert(parse_int(value, length, &parsedInt));
+        assert(parsedInt == atoi(value));
+        // between 0 and 21 decimals, some values beyond the exact mantissa
+        length = sprintf(value, "%s%d.%0*d", i % 2 ? "-" : "",
+                         rand_r(&seed) % 100000, i % 22, rand_r(&seed));
+        double parsedDouble;
+        assert(parse_double(value, length, &parsedDouble));
+        assert(parsedDouble == strtod(value, nullptr));
+    }
+    const char* ints[] = {"0", "+7", "-0012345678901", "123456789", "-", "+"};
+    for (size_t i = 0; i < sizeof(ints) / sizeof(ints[0]); i++) {
+        int parsedInt;
+        double parsedDouble;
+        assert(parse_int(ints[i], strlen(ints[i]), &parsedInt));
+        assert(parsedInt == atoi(ints[i]));
+        assert(parse_double(ints[i], strlen(ints[i]), &parsedDouble));
+        assert(parsedDouble == strtod(ints[i], nullptr));
+    }
+    const char* notInts[] = {"", "1.5", "12a", "1-2", "--1", " 1", "1e5"};
+    for (size_t i = 0; i < sizeof(notInts) / sizeof(notInts[0]); i++) {
+        int parsedInt;
+        assert(!parse_int(notInts[i], strlen(notInts[i]), &parsedInt));
+        assert(!is_int(notInts[i], strlen(notInts[i])));
+    }
+    const char* notDoubles[] = {"", "1.2.3", "1.5x", "1e5", "12345678a.5"};
+    for (size_t i = 0; i < sizeof(notDoubles) / sizeof(notDoubles[0]); i++) {
+        double parsedDouble;
+        assert(!parse_double(notDoubles[i], strlen(notDoubles[i]),
+                             &parsedDouble));
+        assert(!is_float(notDoubles[i], strlen(notDoubles[i])));
+    }
+    bool parsedBool;
+    assert(parse_bool("1", 1, &parsedBool) && parsedBool);
+    assert(parse_bool("0", 1, &parsedBool) && !parsedBool);
+    assert(!parse_bool("2", 1, &parsedBool) && !parse_bool("10", 2,
+                                                          &parsedBool));
+
+    // a value that does not fit leaves the column unchanged
+    IntColumn* ints_col = new IntColumn();
+    assert(ints_col->push_back("12", 2) && ints_col->push_back("1", 1));
+    assert(!ints_col->push_back("1.5", 3) && !ints_col->push_back("ab", 2));
+    assert(ints_col->size() == 2 && ints_col->get_int(1) == 1);
+    ints_col->pop_back();
+    assert(ints_col->size() == 1 && ints_col->get_int(0) == 12);
+    DoubleColumn* doubles_col = new DoubleColumn();
+    assert(doubles_col->push_back("3", 1) && doubles_col->push_back("-.25", 4));
+    assert(!doubles_col->push_back("x", 1));
+    assert(doubles_col->size() == 2 && doubles_col->get_double(1) == -0.25);
+    StringColumn* strings_col = new StringColumn();
+    assert(strings_col->push_back("a b", 3) && strings_col->push_back("", 0));
+    strings_col->pop_back();
+    assert(strings_col->size() == 1 &&
+           strcmp(strings_col->get_string(0)->c_str(), "a b") == 0);
+    delete ints_col;
+    delete doubles_col;
+    delete strings_col;
+    OK("test_field_parsers");
+}
+
+void testSampledSchema() {
+    char path[] = "/tmp/eau2_test_sorerXXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    FILE* file = fdopen(fd, "w");
+    const int numRows = 5000;
+    // a missing first value, a longest line after the first one and doubles
+    // only in the second half of the file
+    fprintf(file, "<> <1> <\"a\">\n");
+    for (int i = 1; i < numRows; i++) {
+        fprintf(file, "<%d> <%s> <\"a\">%s\n", i, i < numRows / 2 ? "1" : "2.5",
+                i == 10 ? " <7>" : "");
+    }
+    fclose(file);
+
+    SOR* sor = new SOR();
+    assert(sor->read_mapped(path, 0, 1 << 20));
+    assert(sor->columnArray->size() == 4);
+    assert(sor->get_col_type(0) == ColType::INTEGER);
+    assert(sor->get_col_type(1) == ColType::DOUBLE);
+    assert(sor->get_col_type(2) == ColType::STRING);
+    assert(sor->get_col_type(3) == ColType::INTEGER);
+    // no row is skipped
+    assert(sor->columnArray->get(0)->size() == numRows);
+    assert(sor->columnArray->get(1)->get_double(numRows - 1) == 2.5);
+    assert(sor->columnArray->get(3)->get_int(10) == 7);
+    // the sampled positions do not depend on the number of threads
+    for (size_t numThreads = 2; numThreads <= 4; numThreads++) {
+        SOR* parallel = new SOR();
+        assert(parallel->read_parallel(path, 0, 1 << 20, numThreads));
+        checkSameColumns(sor, parallel);
+        delete parallel;
+    }
+    // so do the ones read through a stream
+    SOR* streamed = new SOR();
+    FILE* in = fopen(path, "r");
+    streamed->read(in, 0, 1 << 20);
+    fclose(in);
+    checkSameColumns(sor, streamed);
+    delete streamed;
+
+    // the first line alone locks the first columns to bool
+    SOR* firstLine = new SOR();
+    firstLine->sampleRows = 1;
+    firstLine->sampleBlocks = 0;
+    assert(firstLine->read_mapped(path, 0, 1 << 20));
+    assert(firstLine->columnArray->size() == 3);
+    assert(firstLine->get_col_type(0) == ColType::BOOLEAN);
+    assert(firstLine->get_col_type(1) == ColType::BOOLEAN);
+    assert(firstLine->columnArray->get(0)->size() < numRows);
+    delete firstLine;
+    delete sor;
+    unlink(path);
+    OK("test_sampled_schema");
+}
+
+void testStreamingIngest() {
+    char path[] = "/tmp/eau2_test_sorerXXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    FILE* file = fdopen(fd, "w");
+    const int numRows = 1000;
+    for (int i = 0; i < numRows; i++) {
+        if (i % 5 == 0) {
+            fprintf(file, "<%d> <%d.5> <%d> <>\n", i + 2, i, i % 2);
+        } else {
+            fprintf(file, "<%d> <%d.5> <%d> <\"s %d\">\n", i + 2, i, i % 2, i);
+        }
+    }
+    fclose(file);
+    SOR* whole = new SOR();
+    assert(whole->read_mapped(path, 0, 1 << 20));
+    DataFrame* expected = whole->get_dataframe();
+
+    // a budget far below the size of the data, chunks are spilled as they
+    // are stored
+    KVStore* kv = new KVStore();
+    kv->set_memory_budget(16 << 10, "/tmp");
+    SOR* sor = new SOR();
+    assert(sor->stream_mapped(path, kv, "data", 64, 1));
+    // the SOR only holds the schema
+    assert(sor->columnArray->size() == 4);
+    assert(sor->columnArray->get(0)->size() == 0);
+    assert(kv->resident_bytes() <= (16 << 10));
+    // the last of the 16 chunks is on node 15 % 4
+    assert(kv->get_bytes(Key("data:3:15", 3)) != nullptr);
+    assert(kv->get_bytes(Key("data:3:16", 0)) == nullptr);
+
+    DataFrame* df = ChunkStream::load(kv, "data");
+    assert(df->ncols() == 4 && df->nrows() == numRows);
+    for (size_t col = 0; col < 4; col++) {
+        assert(df->columns->get(col)->get_type() ==
+               expected->columns->get(col)->get_type());
+    }
+    for (size_t row = 0; row < numRows; row++) {
+        assert(df->get_int(0, row) == expected->get_int(0, row));
+        assert(df->get_double(1, row) == expected->get_double(1, row));
+        assert(df->get_bool(2, row) == expected->get_bool(2, row));
+        String* value = df->get_string(3, row);
+        String* expectedValue = expected->get_string(3, row);
+        assert(value == nullptr ? expectedValue == nullptr
+                                : value->equals(expectedValue));
+    }
+    assert(ChunkStream::load(kv, "missing") == nullptr);
+    delete df;
+    delete expected;
+    delete whole;
+    delete sor;
+    delete kv;
+    unlink(path);
+    OK("test_streaming_ingest");
+}
+
+// writes rows of an int, a double, a bool and a string starting at the given
+// int to the file at the given path
+void writeRows(const char* path, int first, int numRows) {
+    FILE* file = fopen(path, "w");
+    for (int i = first; i < first + numRows; i++) {
+        fprintf(file, "<%d> <%d.25> <%d> <\"row %d\">\n", i, i, i % 2, i);
+    }
+    fclose(file);
+}
+
+void testColumnCache() {
+    char path[] = "/tmp/eau2_test_sorerXXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+    writeRows(path, 10, 500);
+    char* cachePath = ColumnCache::cache_path(path);
+    unlink(cachePath);
+
+    // the first read parses the file and writes the cache
+    SOR* parsed = new SOR();
+    assert(parsed->read_cached(path));
+    assert(access(cachePath, F_OK) == 0);
+    ColumnArray* columns = new ColumnArray();
+    assert(ColumnCache::load(path, columns));
+    assert(columns->size() == 4 && columns->get(0)->size() == 500);
+    delete columns;
+    // the next one loads the same columns from the cache
+    SOR* cached = new SOR();
+    assert(cached->read_cached(path));
+    checkSameColumns(parsed, cached);
+    delete cached;
+
+    // an edited file does not match its cache anymore
+    writeRows(path, 20, 400);
+    columns = new ColumnArray();
+    assert(!ColumnCache::load(path, columns));
+    assert(columns->size() == 0);
+    SOR* reparsed = new SOR();
+    assert(reparsed->read_cached(path));
+    assert(reparsed->columnArray->get(0)->size() == 400);
+    assert(reparsed->columnArray->get(0)->get_int(0) == 20);
+    assert(ColumnCache::load(path, columns));
+    delete columns;
+
+    // a truncated cache is ignored
+    assert(truncate(cachePath, 100) == 0);
+    columns = new ColumnArray();
+    assert(!ColumnCache::load(path, columns));
+    assert(columns->size() == 0);
+    delete columns;
+
+    delete parsed;
+    delete reparsed;
+    unlink(cachePath);
+    unlink(path);
+    delete[] cachePath;
+    OK("test_column_cache");
+}
+
+// checks that the given column of the actual SOR holds the values of the
+// given column of the expected SOR
+void checkSameColumn(SOR* expected, int expectedCol, SOR* actual,
+                     int actualCol) {
+    assert(expected->get_col_type(expectedCol) ==
+           actual->get_col_type(actualCol));
+    size_t rows = expected->columnArray->get(expectedCol)->size();
+    assert(actual->columnArray->get(actualCol)->size() == rows);
+    for (size_t row = 0; row < rows; row++) {
+        char* expectedValue = expected->get_value(expectedCol, row);
+        char* actualValue = actual->get_value(actualCol, row);
+        assert(strcmp(expectedValue, actualValue) == 0);
+        delete[] expectedValue;
+        delete[] actualValue;
+    }
+}
+
+void testProjection() {
+    char path[] = "/tmp/eau2_test_sorerXXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+    writeRows(path, 10, 1000);
+    SOR* whole = new SOR();
+    assert(whole->read_mapped(path, 0, SIZE_MAX));
+    size_t columns[] = {3, 0, 7};
+
+    // every reader keeps the selected columns, in the selected order
+    SOR* readers[5];
+    for (int i = 0; i < 4; i++) {
+        readers[i] = new SOR();
+        readers[i]->select_columns(columns, 3);
+    }
+    assert(readers[0]->read_mapped(path, 0, SIZE_MAX));
+    assert(readers[1]->read_parallel(path, 0, SIZE_MAX, 3));
+    assert(readers[2]->read_cached(path));
+    assert(readers[3]->read_cached(path));  // from the cache
+    readers[4] = new SOR();
+    FILE* file = fopen(path, "r");
+    readers[4]->read(file, 0, 1 << 20, columns, 3);
+    fclose(file);
+    for (int i = 0; i < 5; i++) {
+        SOR* sor = readers[i];
+        assert(sor->columnArray->size() == 3);
+        checkSameColumn(whole, 3, sor, 0);
+        checkSameColumn(whole, 0, sor, 1);
+        // past the last field of the file
+        assert(sor->get_col_type(2) == ColType::BOOLEAN);
+        assert(sor->columnArray->get(2)->size() == 1000);
+        delete sor;
+    }
+
+    // only the selected fields are checked against the schema
+    file = fopen(path, "a");
+    fprintf(file, "<1> <not a double> <0> <\"bad row\">\n");
+    fclose(file);
+    SOR* checked = new SOR();
+    SOR* projected = new SOR();
+    projected->select_columns(columns, 2);
+    ColType types[] = {ColType::INTEGER, ColType::DOUBLE, ColType::BOOLEAN,
+                       ColType::STRING};
+    for (int col = 0; col < 4; col++) {
+        checked->add_column_(types[col]);
+    }
+    projected->add_column_(ColType::STRING);
+    projected->add_column_(ColType::INTEGER);
+    assert(checked->read_mapped(path, 0, SIZE_MAX));
+    assert(projected->read_mapped(path, 0, SIZE_MAX));
+    assert(checked->columnArray->get(0)->size() == 1000);
+    assert(projected->columnArray->get(0)->size() == 1001);
+    assert(strcmp(projected->columnArray->get(0)->get_string(1000)->c_str(),
+                  "bad row") == 0);
+
+    char* cachePath = ColumnCache::cache_path(path);
+    unlink(cachePath);
+    unlink(path);
+    delete[] cachePath;
+    delete checked;
+    delete projected;
+    delete whole;
+    OK("test_projection");
+}
+
+// keeps the rows of writeRows() with an int of at least 500, a true bool and
+// a string other than "row 777", like the predicate of testPredicate()
+class SelectRower : public Rower {
+   public:
+    SelectRower() : Rower(0) {}
+
+    bool accept(Row& r) {
+        return r.get_int(0) >= 500 && r.get_bool(2) &&
+               strcmp(r.get_string(3)->c_str(), "row 777") != 0;
+    }
+};
+
+void testPredicate() {
+    char path[] = "/tmp/eau2_test_sorerXXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+    writeRows(path, 10, 1000);
+    Predicate* predicate = new Predicate();
+    predicate->add(new Condition(0, CompareOp::GREATER_EQUAL, 500))
+        ->add(new Condition(2, CompareOp::EQUAL, true))
+        ->add(new Condition(3, CompareOp::NOT_EQUAL, "row 777"));
+
+    // the predicate keeps the rows a filter of the whole data frame keeps
+    SOR* whole = new SOR();
+    assert(whole->read_mapped(path, 0, SIZE_MAX));
+    DataFrame* df = whole->get_dataframe();
+    SelectRower rower;
+    DataFrame* filtered = df->filter(rower);
+    assert(filtered->nrows() == 254);
+    SOR* readers[3];
+    for (int i = 0; i < 3; i++) {
+        readers[i] = new SOR();
+        readers[i]->select_rows(predicate);
+    }
+    assert(readers[0]->read_mapped(path, 0, SIZE_MAX));
+    assert(readers[1]->read_parallel(path, 0, SIZE_MAX, 3));
+    FILE* file = fopen(path, "r");
+    readers[2]->read(file, 0, 1 << 20, predicate);
+    fclose(file);
+    for (int i = 0; i < 3; i++) {
+        SOR* sor = readers[i];
+        assert(sor->columnArray->size() == 4);
+        assert(sor->columnArray->get(0)->size() == filtered->nrows());
+        for (size_t row = 0; row < filtered->nrows(); row++) {
+            assert(sor->columnArray->get(0)->get_int(row) ==
+                   filtered->get_int(0, row));
+            assert(strcmp(sor->columnArray->get(3)->get_string(row)->c_str(),
+                          filtered->get_string(3, row)->c_str()) == 0);
+        }
+        delete sor;
+    }
+
+    // conditions on missing fields and on columns not being read
+    file = fopen(path, "a");
+    fprintf(file, "<5> <> <1> <\"gap\">\n");
+    fclose(file);
+    Predicate* missing = new Predicate();
+    missing->add(new Condition(1, CompareOp::IS_MISSING));
+    SOR* sor = new SOR();
+    size_t columns[] = {3};
+    sor->select_columns(columns, 1);
+    sor->select_rows(missing);
+    assert(sor->read_cached(path));
+    assert(sor->columnArray->size() == 1);
+    assert(sor->columnArray->get(0)->size() == 1);
+    assert(strcmp(sor->columnArray->get(0)->get_string(0)->c_str(), "gap") ==
+           0);
+    delete sor;
+    Predicate* range = new Predicate();
+    range->add(new Condition(1, CompareOp::LESS, 12.0))
+        ->add(new Condition(1, CompareOp::IS_PRESENT));
+    sor = new SOR();
+    sor->select_rows(range);
+    assert(sor->read_mapped(path, 0, SIZE_MAX));
+    assert(sor->columnArray->get(0)->size() == 2);
+    assert(sor->columnArray->get(1)->get_double(1) == 11.25);
+    delete sor;
+
+    unlink(path);
+    delete range;
+    delete missing;
+    delete predicate;
+    delete filtered;
+    delete df;
+    delete whole;
+    OK("test_predicate");
+}
+
+void testLoadStats() {
+    char path[] = "/tmp/eau2_test_sorerXXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+    writeRows(path, 10, 100);
+    FILE* file = fopen(path, "a");
+    fprintf(file, "<abc> <1.5> <1> <\"skipped\">\n");
+    fprintf(file, "<7> <> <0> <\"missing double\">\n");
+    fclose(file);
+    struct stat info;
+    assert(stat(path, &info) == 0);
+    ColType types[] = {ColType::INTEGER, ColType::DOUBLE, ColType::BOOLEAN,
+                       ColType::STRING};
+
+    // every reader counts the same lines, rows and fields
+    for (int reader = 0; reader < 3; reader++) {
+        SOR* sor = new SOR();
+        for (int col = 0; col < 4; col++) {
+            sor->add_column_(types[col]);
+        }
+        FILE* report = tmpfile();
+        sor->enable_stats(report);
+        if (reader == 0) {
+            assert(sor->read_mapped(path, 0, SIZE_MAX));
+        } else if (reader == 1) {
+            assert(sor->read_parallel(path, 0, SIZE_MAX, 3));
+        } else {
+            file = fopen(path, "r");
+            sor->parse_(file, 0, info.st_size);
+            fclose(file);
+        }
+        LoadStats* stats = sor->stats;
+        assert(stats->bytes == static_cast<size_t>(info.st_size));
+        assert(stats->lines == 102);
+        assert(stats->rows == 101);
+        assert(stats->skippedRows == 1);
+        assert(stats->filteredRows == 0);
+        assert(stats->intFields == 101 && stats->boolFields == 101);
+        assert(stats->doubleFields == 100 && stats->missingFields == 1);
+        assert(stats->stringFields == 101);
+        if (reader < 2) {
+            assert(stats->tokenizeNanos > 0 && stats->convertNanos > 0);
+            assert(stats->totalNanos > 0);
+            // the summary is a single line JSON object
+            char line[1024];
+            rewind(report);
+            assert(fgets(line, sizeof(line), report) != nullptr);
+            char expected[64];
+            snprintf(expected, sizeof(expected), "{\"bytes\": %zu, ",
+                     static_cast<size_t>(info.st_size));
+            assert(strncmp(line, expected, strlen(expected)) == 0);
+            assert(line[strlen(line) - 2] == '}');
+            assert(fgets(line, sizeof(line), report) == nullptr);
+        }
+        fclose(report);
+        delete sor;
+    }
+
+    // rows rejected by the predicate are counted apart, and so is the time
+    // spent inferring the schema
+    Predicate* predicate = new Predicate();
+    predicate->add(new Condition(0, CompareOp::LESS, 50));
+    SOR* sor = new SOR();
+    sor->enable_stats(nullptr);
+    sor->select_rows(predicate);
+    assert(sor->read_mapped(path, 0, SIZE_MAX));
+    assert(sor->get_col_type(0) == ColType::STRING);
+    assert(sor->stats->schemaNanos > 0);
+    assert(sor->stats->rows == 41 && sor->stats->filteredRows == 61);
+    delete sor;
+    delete predicate;
+    unlink(path);
+    OK("test_load_stats");
+}
+
 int main() {
     testIntColumn();
     testDoubleColumn();
     testBoolColumn();
     testStringColumn();
     testMixedColumns();
+    testMappedReader();
+    testMappedLongLines();
+    testParallelReader();
+    testTokenizer();
+    testRereadTokenizer();
+    testFieldParsers();
+    testSampledSchema();
+    testStreamingIngest();
+    testColumnCache();
+    testProjection();
+    testPredicate();
+    testLoadStats();
     return 0;
 }